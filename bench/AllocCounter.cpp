@@ -0,0 +1,41 @@
+// Replaces the global operator new / delete of the bench executable to
+// count heap allocations, so suites can report allocations per frame.
+
+#include "BenchCommon.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount{ 0 };
+    std::atomic<uint64_t> allocationBytes{ 0 };
+
+    void* CountedAlloc(std::size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocationBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1))
+            return p;
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace EdgeLightBench
+{
+    AllocationCounts AllocationsSoFar()
+    {
+        AllocationCounts counts;
+        counts.count = allocationCount.load(std::memory_order_relaxed);
+        counts.bytes = allocationBytes.load(std::memory_order_relaxed);
+        return counts;
+    }
+}
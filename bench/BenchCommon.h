@@ -0,0 +1,139 @@
+#pragma once
+
+#include "core/FrameTypes.h"
+#include "core/SdfKernels.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace EdgeLightBench
+{
+    struct Resolution
+    {
+        const char* name;
+        int width;
+        int height;
+    };
+
+    struct Options
+    {
+        bool quick = false;         // fewer iterations, for smoke runs
+        const char* jsonPath = nullptr; // --json=<path>: suites that support it also write results there
+        const char* goldenDir = nullptr; // --golden=<dir>: golden images for the gate suite
+        bool updateGolden = false;  // --update-golden: rewrite them instead of comparing
+        double budgetScale = 1.0;   // --budget-scale=<x>: stretch the gate's time budgets
+    };
+
+    inline const char* SimdLevelName(EdgeLight::SimdLevel level)
+    {
+        switch (level)
+        {
+        case EdgeLight::SimdLevel::Scalar: return "scalar";
+        case EdgeLight::SimdLevel::Sse2: return "sse2";
+        case EdgeLight::SimdLevel::Avx2: return "avx2";
+        }
+        return "?";
+    }
+
+    // A suite's correctness checks print as one table: PrintCheckHeader,
+    // a row per Check, then RecordFailures, which prints the failure count
+    // and adds it to the process exit code.
+    void PrintCheckHeader();
+    void Check(const char* name, long long expected, long long actual, int& failures);
+
+    // For values that only need to agree to within 1e-6.
+    void CheckNear(const char* name, double expected, double actual, int& failures);
+
+    void RecordFailures(int failures);
+
+    // Heap allocations made through operator new since the process started
+    // (counted by AllocCounter.cpp).
+    struct AllocationCounts
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    AllocationCounts AllocationsSoFar();
+
+    // Runs fn repeatedly until both minIterations and the time budget are
+    // reached and returns the mean nanoseconds per call.
+    template <class Fn>
+    double MeasureNs(const Options& options, Fn&& fn)
+    {
+        using Clock = std::chrono::steady_clock;
+        const int minIterations = options.quick ? 1 : 5;
+        const auto budget = options.quick ? std::chrono::milliseconds(20) : std::chrono::milliseconds(300);
+
+        fn(); // warm caches and lazily allocated state
+
+        int iterations = 0;
+        const auto start = Clock::now();
+        auto now = start;
+        while (iterations < minIterations || now - start < budget)
+        {
+            fn();
+            iterations++;
+            now = Clock::now();
+        }
+        return std::chrono::duration<double, std::nano>(now - start).count() / iterations;
+    }
+
+    // Mean heap allocations per call of fn, after one warm-up call so lazily
+    // grown scratch buffers are not counted.
+    template <class Fn>
+    double AllocationsPerCall(Fn&& fn, int calls = 4)
+    {
+        fn();
+        const AllocationCounts before = AllocationsSoFar();
+        for (int i = 0; i < calls; i++)
+            fn();
+        return static_cast<double>(AllocationsSoFar().count - before.count) / calls;
+    }
+
+    // A heap-backed BGRA or mask image sized for one resolution.
+    struct Image
+    {
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+        std::vector<uint8_t> pixels;
+
+        Image(int w, int h, int bytesPerPixel)
+            : width(w), height(h), stride(w * bytesPerPixel), pixels(static_cast<size_t>(w) * h * bytesPerPixel)
+        {
+        }
+    };
+
+    // The renderers' views of an Image; neither copies the pixels.
+    EdgeLight::BgraBuffer View(Image& image, bool premultiplied = false);
+    EdgeLight::MaskBuffer MaskView(Image& image);
+
+    // Suites, one per translation unit.
+    void RunSdfSuite(const Options& options);
+    void RunSpanSuite(const Options& options);
+    void RunGlowSuite(const Options& options);
+    void RunNineSliceSuite(const Options& options);
+    void RunPresentSuite(const Options& options);
+    void RunCacheSuite(const Options& options);
+    void RunSchedulerSuite(const Options& options);
+    void RunTransitionSuite(const Options& options);
+    void RunMonitorSuite(const Options& options);
+    void RunTopologySuite(const Options& options);
+    void RunDpiSuite(const Options& options);
+    void RunRendererSuite(const Options& options);
+    void RunMatrixSuite(const Options& options);
+    void RunGateSuite(const Options& options);
+    void RunTraceSuite(const Options& options);
+    void RunGdiPoolSuite(const Options& options);
+    void RunDeltaSuite(const Options& options);
+    void RunLayeredSuite(const Options& options);
+    void RunStripSuite(const Options& options);
+    void RunStartupSuite(const Options& options);
+    void RunMemorySuite(const Options& options);
+    void RunColorSuite(const Options& options);
+    void RunBrightnessSuite(const Options& options);
+    void RunTimerSuite(const Options& options);
+}
@@ -0,0 +1,355 @@
+// Auto brightness: the luma kernel at every SIMD level and stride against
+// the scalar one, the sampled bands, and the control loop on a simulated
+// clock against synthetic screens (dark, bright, flickering, a window
+// dragged across the edge). Then what one capture's worth of sampling
+// costs per level and stride, and the CPU that works out to at the
+// capped capture rate.
+
+#include "BenchCommon.h"
+
+#include "core/AutoBrightness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr SimdLevel LEVELS[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+
+        constexpr Resolution RESOLUTIONS[] = {
+            { "1920x1080", 1920, 1080 },
+            { "3840x2160", 3840, 2160 },
+        };
+
+        constexpr int STEPS[] = { 1, 2, 4, 8 };
+
+        void Fill(Image& image, const SpanRect& rect, uint32_t pixel)
+        {
+            for (int y = std::max(rect.top, 0); y < std::min(rect.bottom, image.height); y++)
+            {
+                uint32_t* row = reinterpret_cast<uint32_t*>(image.pixels.data() + static_cast<size_t>(y) * image.stride);
+                for (int x = std::max(rect.left, 0); x < std::min(rect.right, image.width); x++)
+                    row[x] = pixel;
+            }
+        }
+
+        void FillNoise(Image& image, uint32_t seed)
+        {
+            for (size_t i = 0; i < image.pixels.size(); i++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                image.pixels[i] = static_cast<uint8_t>(seed >> 24);
+            }
+        }
+
+        // Mean luma of everything the bands cover, with the bands in the
+        // layout main.cpp uses: work-area pixels of one monitor
+        double SampleScreen(Image& screen, const FrameParams& params, bool underFrame, int step,
+                            SimdLevel level = DetectSimdLevel())
+        {
+            SpanRect bands[4];
+            const int count = LuminanceBands(params, underFrame, bands);
+            LuminanceSum sum;
+            for (int i = 0; i < count; i++)
+                sum.Add(SampleLuminance(View(screen), bands[i], step, level));
+            return sum.Mean();
+        }
+
+        FrameParams ScreenParams(const Image& screen)
+        {
+            FrameParams params;
+            params.width = screen.width;
+            params.height = screen.height;
+            return params;
+        }
+
+        void RunKernelChecks(int& failures)
+        {
+            // Known values
+            {
+                Image image(33, 5, 4);
+                const SpanRect all = { 0, 0, image.width, image.height };
+                Fill(image, all, 0xFF000000u);
+                Check("luma: black", 0, std::lround(SampleLuminance(View(image), all, 1).Mean()), failures);
+                Fill(image, all, 0x00FFFFFFu);
+                Check("luma: white (alpha ignored)", 255, std::lround(SampleLuminance(View(image), all, 1).Mean()), failures);
+                Fill(image, all, 0xFF00FF00u);
+                Check("luma: pure green x 256", 183 * 255, std::lround(SampleLuminance(View(image), all, 1).Mean() * 256),
+                      failures);
+                Check("luma: pixels at step 1", 33 * 5, static_cast<long long>(SampleLuminance(View(image), all, 1).pixels),
+                      failures);
+                Check("luma: pixels at step 4", 9 * 2, static_cast<long long>(SampleLuminance(View(image), all, 4).pixels),
+                      failures);
+                Check("luma: clipped to the image", 3 * 5,
+                      static_cast<long long>(SampleLuminance(View(image), { 30, -4, 90, 40 }, 1).pixels), failures);
+                Check("luma: empty rect samples nothing", -1,
+                      std::lround(SampleLuminance(View(image), { 10, 2, 10, 4 }, 1).Mean()), failures);
+            }
+
+            // A capture GDI has decimated to every step-th pixel (what the
+            // sampler's COLORONCOLOR StretchBlt returns) reads the same as
+            // the full capture read at that step
+            {
+                Image image(37, 11, 4);
+                FillNoise(image, 5);
+                const int step = 4;
+                Image decimated((image.width + step - 1) / step, (image.height + step - 1) / step, 4);
+                for (int y = 0; y < decimated.height; y++)
+                {
+                    for (int x = 0; x < decimated.width; x++)
+                        std::memcpy(&decimated.pixels[static_cast<size_t>(y) * decimated.stride + x * 4],
+                                    &image.pixels[static_cast<size_t>(y * step) * image.stride + x * step * 4], 4);
+                }
+                const LuminanceSum strided = SampleLuminance(View(image), { 0, 0, image.width, image.height }, step);
+                const LuminanceSum captured = SampleLuminance(View(decimated), { 0, 0, decimated.width, decimated.height }, 1);
+                Check("luma: decimated capture matches strided read", 1,
+                      strided.pixels == captured.pixels && strided.weighted == captured.weighted, failures);
+            }
+
+            // Every level and stride matches scalar for every row length
+            {
+                Image image(131, 3, 4);
+                FillNoise(image, 5);
+                int mismatches = 0;
+                for (SimdLevel level : LEVELS)
+                {
+                    const SdfKernels* kernels = GetSdfKernels(level);
+                    if (!kernels)
+                        continue;
+                    for (int step = 1; step <= 5; step++)
+                    {
+                        const uint32_t* row = reinterpret_cast<const uint32_t*>(image.pixels.data());
+                        for (int count = 0; count * step <= image.width * image.height - step + 1 && count < 200; count++)
+                        {
+                            mismatches += kernels->lumaRow(row, count, step) !=
+                                          Kernels::LumaRowScalar(row, count, step);
+                        }
+                    }
+                }
+                Check("luma: every level and stride matches scalar", 0, mismatches, failures);
+            }
+
+            // Long white rows stay exact past the lanes' flush point
+            {
+                Image image(40000, 1, 4);
+                Fill(image, { 0, 0, image.width, 1 }, 0xFFFFFFFFu);
+                int wrong = 0;
+                for (SimdLevel level : LEVELS)
+                {
+                    if (GetSdfKernels(level))
+                        wrong += SampleLuminance(View(image), { 0, 0, image.width, 1 }, 1, level).weighted != 40000ull * 255 * 256;
+                }
+                Check("luma: long rows do not overflow", 0, wrong, failures);
+            }
+
+            // Sampling one capture allocates nothing
+            {
+                Image screen(1920, 1080, 4);
+                const FrameParams params = ScreenParams(screen);
+                const double allocations = AllocationsPerCall([&] { SampleScreen(screen, params, true, 4); });
+                Check("luma: allocations per capture", 0, std::lround(allocations), failures);
+            }
+        }
+
+        void RunBandChecks(int& failures)
+        {
+            FrameParams params;
+            params.width = 1920;
+            params.height = 1080;
+
+            SpanRect bands[4];
+            Check("bands: four under the frame", 4, LuminanceBands(params, true, bands), failures);
+            Check("bands: top starts at the inset", params.inset, bands[0].top, failures);
+            Check("bands: as deep as the frame", params.frameThickness, bands[0].bottom - bands[0].top, failures);
+
+            long long area = 0;
+            for (const SpanRect& band : bands)
+                area += static_cast<long long>(band.right - band.left) * (band.bottom - band.top);
+            const long long ring = 1880LL * 1040 - 1720LL * 880;
+            Check("bands: cover the frame band once", ring, area, failures);
+
+            // Past the light's reach when it would be in the capture
+            SpanRect inside[4];
+            Check("bands: four past the reach", 4, LuminanceBands(params, false, inside), failures);
+            Check("bands: start past frame and glow", 1, inside[0].top >= params.inset + params.frameThickness, failures);
+
+            // A screen with a dark frame band and a white middle reads dark
+            // under the frame and white past the reach
+            Image screen(params.width, params.height, 4);
+            Fill(screen, { 0, 0, screen.width, screen.height }, 0xFFFFFFFFu);
+            for (const SpanRect& band : bands)
+                Fill(screen, band, 0xFF000000u);
+            Check("bands: dark under the frame", 0, std::lround(SampleScreen(screen, params, true, 1)), failures);
+            Check("bands: content past the reach", 255, std::lround(SampleScreen(screen, params, false, 1)), failures);
+
+            params.width = 200;
+            params.height = 150;
+            Check("bands: none when they would meet", 0, LuminanceBands(params, true, bands), failures);
+        }
+
+        void RunControlChecks(int& failures)
+        {
+            const AutoBrightnessSettings settings;
+
+            {
+                ManualClock clock(0);
+                AutoBrightness autoBrightness(clock, settings);
+                Check("control: disabled schedules nothing", -1, autoBrightness.TimeUntilSample(), failures);
+                autoBrightness.SetEnabled(true);
+                Check("control: first capture due at once", 0, autoBrightness.TimeUntilSample(), failures);
+                Check("control: first sample sets the opacity", 1, autoBrightness.Feed(0.0), failures);
+                Check("control: dark content, full light", settings.darkOpacity, autoBrightness.Opacity(), failures);
+                Check("control: capture rate capped", settings.intervalUs, autoBrightness.TimeUntilSample(), failures);
+
+                clock.Advance(settings.intervalUs);
+                Check("control: small change ignored", 0, autoBrightness.Feed(30.0), failures);
+
+                // White content for ten seconds dims the light gradually
+                int changes = 0;
+                int previous = autoBrightness.Opacity();
+                bool monotonic = true;
+                for (int i = 0; i < 20; i++)
+                {
+                    clock.Advance(settings.intervalUs);
+                    if (autoBrightness.Feed(255.0))
+                    {
+                        changes++;
+                        monotonic = monotonic && autoBrightness.Opacity() < previous;
+                        previous = autoBrightness.Opacity();
+                    }
+                }
+                Check("control: dims step by step", 1, changes > 2 && monotonic, failures);
+                Check("control: no jump on the first white sample", 1,
+                      autoBrightness.Stats().changes > 3, failures);
+                const int settled = static_cast<int>(std::lround(
+                    settings.darkOpacity + (settings.brightOpacity - settings.darkOpacity) * (255.0 - 2 * settings.hysteresis) / 255.0));
+                Check("control: close to dim after 10 s", 1, autoBrightness.Opacity() <= settled, failures);
+
+                clock.Advance(settings.intervalUs);
+                Check("control: empty capture changes nothing", 0, autoBrightness.Feed(-1.0), failures);
+                Check("control: empty capture rearms", settings.intervalUs, autoBrightness.TimeUntilSample(), failures);
+
+                autoBrightness.SetEnabled(false);
+                Check("control: disabling forgets the opacity", -1, autoBrightness.Opacity(), failures);
+            }
+
+            // Flickering content (a video, a blinking cursor) settles and
+            // then leaves the light alone
+            {
+                ManualClock clock(0);
+                AutoBrightness autoBrightness(clock, settings);
+                autoBrightness.SetEnabled(true);
+                for (int i = 0; i < 40; i++)
+                {
+                    autoBrightness.Feed(i % 2 ? 140.0 : 100.0);
+                    clock.Advance(settings.intervalUs);
+                }
+                const uint64_t before = autoBrightness.Stats().changes;
+                for (int i = 0; i < 120; i++)
+                {
+                    autoBrightness.Feed(i % 2 ? 140.0 : 100.0);
+                    clock.Advance(settings.intervalUs);
+                }
+                Check("flicker: no changes once settled", 0, static_cast<long long>(autoBrightness.Stats().changes - before),
+                      failures);
+            }
+
+            // End to end against a synthetic screen: a white window dragged
+            // over the bottom edge of a dark desktop
+            {
+                Image screen(1280, 720, 4);
+                const FrameParams params = ScreenParams(screen);
+                Fill(screen, { 0, 0, screen.width, screen.height }, 0xFF101010u);
+
+                ManualClock clock(0);
+                AutoBrightness autoBrightness(clock, settings);
+                autoBrightness.SetEnabled(true);
+                autoBrightness.Feed(SampleScreen(screen, params, true, 4));
+                const int desktop = autoBrightness.Opacity();
+
+                Fill(screen, { 200, 300, 1100, 720 }, 0xFFF0F0F0u);
+                for (int i = 0; i < 20; i++)
+                {
+                    clock.Advance(autoBrightness.TimeUntilSample());
+                    autoBrightness.Feed(SampleScreen(screen, params, true, 4));
+                }
+                Check("screen: dark desktop, bright light", 1, desktop >= 240, failures);
+                Check("screen: window over the edge dims it", 1, autoBrightness.Opacity() < desktop - 20, failures);
+                Check("screen: ten seconds is twenty captures", 21, static_cast<long long>(autoBrightness.Stats().samples),
+                      failures);
+            }
+        }
+    }
+
+    void RunBrightnessSuite(const Options& options)
+    {
+        int failures = 0;
+        PrintCheckHeader();
+        RunKernelChecks(failures);
+        RunBandChecks(failures);
+        RunControlChecks(failures);
+        RecordFailures(failures);
+
+        // One capture's worth of sampling: the four bands under the frame.
+        // CPU is at the capped rate, capture (BitBlt) not included.
+        const AutoBrightnessSettings settings;
+        const double capturesPerSecond = 1e6 / static_cast<double>(settings.intervalUs);
+        std::printf("\n%-12s %-8s %6s %12s %12s %10s\n", "resolution", "level", "step", "us/capture", "Mpix/s", "CPU %");
+        for (const Resolution& resolution : RESOLUTIONS)
+        {
+            Image screen(resolution.width, resolution.height, 4);
+            FillNoise(screen, 17);
+            const FrameParams params = ScreenParams(screen);
+
+            SpanRect bands[4];
+            const int count = LuminanceBands(params, true, bands);
+            for (SimdLevel level : LEVELS)
+            {
+                if (!GetSdfKernels(level))
+                    continue;
+                for (int step : STEPS)
+                {
+                    size_t pixels = 0;
+                    for (int i = 0; i < count; i++)
+                        pixels += SampleLuminance(View(screen), bands[i], step, level).pixels;
+
+                    volatile double sink = 0;
+                    const double ns = MeasureNs(options, [&] { sink = sink + SampleScreen(screen, params, true, step, level); });
+                    std::printf("%-12s %-8s %6d %12.1f %12.1f %10.4f\n", resolution.name, SimdLevelName(level), step,
+                                ns / 1000.0, pixels / ns * 1000.0, ns * capturesPerSecond / 1e7);
+                }
+            }
+        }
+
+        // What one sample copies out of the screen: the bands at full
+        // resolution (BitBlt) against the decimated StretchBlt the sampler
+        // does for step > 1.
+        std::printf("\n%-12s %6s %14s %14s\n", "resolution", "step", "bitblt-KB", "captured-KB");
+        for (const Resolution& resolution : RESOLUTIONS)
+        {
+            FrameParams params;
+            params.width = resolution.width;
+            params.height = resolution.height;
+
+            SpanRect bands[4];
+            const int count = LuminanceBands(params, true, bands);
+            for (int step : STEPS)
+            {
+                size_t full = 0, captured = 0;
+                for (int i = 0; i < count; i++)
+                {
+                    const size_t width = bands[i].right - bands[i].left;
+                    const size_t height = bands[i].bottom - bands[i].top;
+                    full += width * height * 4;
+                    captured += ((width + step - 1) / step) * ((height + step - 1) / step) * 4;
+                }
+                std::printf("%-12s %6d %14.1f %14.1f\n", resolution.name, step, full / 1024.0, captured / 1024.0);
+            }
+        }
+    }
+}
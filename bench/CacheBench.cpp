@@ -0,0 +1,184 @@
+// Surface cache: LRU behaviour against a fake renderer, then a replay of a
+// typical session (toggling, switching monitors, dragging the thickness
+// slider) with and without the cache.
+
+#include "BenchCommon.h"
+
+#include "core/NineSlice.h"
+#include "core/SurfaceCache.h"
+
+#include <memory>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        // Stands in for a rendered surface: only its size matters to the cache.
+        class FakeSurface : public CachedSurface
+        {
+        public:
+            explicit FakeSurface(size_t bytes) : bytes(bytes) {}
+            size_t ByteSize() const override { return bytes; }
+
+        private:
+            size_t bytes;
+        };
+
+        class SliceSurface : public CachedSurface
+        {
+        public:
+            NineSliceFrame slices;
+            size_t ByteSize() const override { return slices.ByteSize(); }
+        };
+
+        SurfaceKey FakeKey(int thickness)
+        {
+            FrameParams params;
+            params.width = 1920;
+            params.height = 1080;
+            params.frameThickness = thickness;
+            return SurfaceKey::FromParams(params, 96);
+        }
+
+        void RunBehaviourChecks()
+        {
+            int renders = 0;
+            const SurfaceRenderFn fake = [&](const SurfaceKey&)
+            {
+                renders++;
+                return std::make_shared<FakeSurface>(100);
+            };
+
+            int failures = 0;
+            PrintCheckHeader();
+
+            SurfaceCache cache(300);
+            cache.Acquire(FakeKey(20), fake);
+            cache.Acquire(FakeKey(20), fake);
+            Check("repeat key renders once", 1, renders, failures);
+            Check("repeat key hits", 1, cache.Stats().hits, failures);
+
+            cache.Acquire(FakeKey(30), fake);
+            cache.Acquire(FakeKey(40), fake);
+            cache.Acquire(FakeKey(20), fake);   // touch: 30 is now least recent
+            cache.Acquire(FakeKey(50), fake);
+            Check("eviction at budget", 1, cache.Stats().evictions, failures);
+            Check("least recent evicted", 0, cache.Contains(FakeKey(30)), failures);
+            Check("recently used kept", 1, cache.Contains(FakeKey(20)), failures);
+            Check("bytes within budget", 300, cache.Stats().bytes, failures);
+
+            const SurfaceRenderFn huge = [](const SurfaceKey&) { return std::make_shared<FakeSurface>(1000); };
+            const bool served = cache.Acquire(FakeKey(60), huge) != nullptr;
+            Check("oversized surface served", 1, served, failures);
+            Check("oversized surface not cached", 0, cache.Contains(FakeKey(60)), failures);
+
+            cache.SetBudget(100);
+            Check("shrinking budget evicts", 1, cache.Stats().entries, failures);
+
+            std::shared_ptr<CachedSurface> held = cache.Acquire(FakeKey(70), fake);
+            cache.Clear();
+            Check("held surface outlives cache", 100, held->ByteSize(), failures);
+
+            RecordFailures(failures);
+        }
+
+        // One paint per step, the way the overlay asks for surfaces.
+        struct Step
+        {
+            int width;
+            int height;
+            int thickness;
+        };
+
+        std::vector<Step> SessionSteps()
+        {
+            std::vector<Step> steps;
+            for (int round = 0; round < 4; round++)
+            {
+                // Toggle off and on a few times, switch monitors back and forth
+                for (int i = 0; i < 3; i++)
+                {
+                    steps.push_back({ 1920, 1080, 80 });
+                    steps.push_back({ 3840, 2160, 80 });
+                }
+
+                // Drag the thickness slider out and back
+                for (int t = 80; t <= 150; t += 10)
+                    steps.push_back({ 1920, 1080, t });
+                for (int t = 150; t >= 80; t -= 10)
+                    steps.push_back({ 1920, 1080, t });
+            }
+            return steps;
+        }
+
+        std::shared_ptr<CachedSurface> RenderSlices(const SurfaceKey& key)
+        {
+            FrameParams params;
+            params.width = key.width;
+            params.height = key.height;
+            params.frameThickness = key.thickness;
+            params.cornerRadius = key.radius;
+            params.inset = key.inset;
+            params.blurSize = key.blur;
+            params.glowRadius = key.glowRadius;
+            params.glowStrength = key.glowStrength;
+
+            auto surface = std::make_shared<SliceSurface>();
+            surface->slices.Build(params);
+            return surface;
+        }
+
+        SurfaceKey StepKey(const Step& step, int glowRadius)
+        {
+            FrameParams params;
+            params.width = step.width;
+            params.height = step.height;
+            params.frameThickness = step.thickness;
+            params.glowRadius = glowRadius;
+            return SurfaceKey::FromParams(params, 96);
+        }
+    }
+
+    void RunCacheSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        const std::vector<Step> steps = SessionSteps();
+        const size_t budgets[] = { 64 * 1024, 256 * 1024, 4 * 1024 * 1024 };
+        const int glows[] = { 0, 40 };
+
+        std::printf("\n%-6s %9s %6s %6s %6s %9s %12s %12s\n",
+                    "glow", "budget-KB", "hits", "misses", "evict", "bytes-KB", "uncached-us", "cached-us");
+
+        for (int glow : glows)
+        {
+            const double uncachedNs = MeasureNs(options, [&]
+            {
+                for (const Step& step : steps)
+                    RenderSlices(StepKey(step, glow));
+            });
+
+            for (size_t budget : budgets)
+            {
+                SurfaceCache cache(budget);
+                const double cachedNs = MeasureNs(options, [&]
+                {
+                    cache.Clear();
+                    cache.ResetStats();
+                    for (const Step& step : steps)
+                        cache.Acquire(StepKey(step, glow), RenderSlices);
+                });
+
+                const SurfaceCacheStats stats = cache.Stats();
+                std::printf("%-6d %9zu %6llu %6llu %6llu %9.1f %12.1f %12.1f\n",
+                            glow, budget / 1024,
+                            static_cast<unsigned long long>(stats.hits),
+                            static_cast<unsigned long long>(stats.misses),
+                            static_cast<unsigned long long>(stats.evictions),
+                            stats.bytes / 1024.0, uncachedNs / 1e3, cachedNs / 1e3);
+            }
+        }
+    }
+}
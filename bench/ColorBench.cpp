@@ -0,0 +1,324 @@
+// Color pipeline: LUT generation (neutral is exact, warm and cool lean the
+// right way, the color key and premultiplied alpha stay valid, the
+// falloff keeps its hue) and the apply kernel at every SIMD level against
+// the scalar one. Then what a LUT rebuild and a colored frame cost, next
+// to doing the same color math in floating point per pixel.
+
+#include "BenchCommon.h"
+
+#include "core/ColorLut.h"
+#include "core/FrameSpans.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr SimdLevel LEVELS[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+
+        constexpr Resolution RESOLUTIONS[] = {
+            { "1920x1080", 1920, 1080 },
+            { "2560x1440", 2560, 1440 },
+            { "3840x2160", 3840, 2160 },
+        };
+
+        ColorSettings Settings(int kelvin, int tint = 0, int brightness = 255)
+        {
+            ColorSettings settings;
+            settings.kelvin = kelvin;
+            settings.tint = tint;
+            settings.brightness = brightness;
+            return settings;
+        }
+
+        bool Monotonic(const uint8_t* table)
+        {
+            for (int i = 1; i < 256; i++)
+            {
+                if (table[i] < table[i - 1])
+                    return false;
+            }
+            return true;
+        }
+
+        // Lit pixels that came out as the color key
+        int KeyHoles(const ColorLut& lut)
+        {
+            int holes = 0;
+            for (int i = 1; i < 256; i++)
+                holes += (lut.packed[i] & 0xFFFFFF) == 0;
+            return holes;
+        }
+
+        // Entries whose color exceeds their alpha
+        int InvalidPremultiplied(const ColorLut& lut)
+        {
+            int invalid = 0;
+            for (int i = 0; i < 256; i++)
+                invalid += lut.red[i] > i || lut.green[i] > i || lut.blue[i] > i;
+            return invalid;
+        }
+
+        // Blue / red ratio of an opaque entry in linear light, against the
+        // ratio of the gains, in per mille; the same at every level when
+        // the tint is applied in linear light
+        long long HueDriftPermille(const ColorLut& lut, const ColorSettings& settings, int level)
+        {
+            float red, green, blue;
+            ColorGains(settings, red, green, blue);
+            const double measured = SrgbToLinear(lut.blue[level] / 255.0f) / SrgbToLinear(lut.red[level] / 255.0f);
+            return std::lround(std::fabs(measured / (blue / red) - 1.0) * 1000.0);
+        }
+
+        void FillPattern(Image& image, bool premultiplied, uint32_t seed)
+        {
+            // Grey (or premultiplied white) at random levels, with runs of
+            // dark and fully lit pixels like a rendered frame has
+            uint32_t* pixels = reinterpret_cast<uint32_t*>(image.pixels.data());
+            const size_t count = image.pixels.size() / 4;
+            for (size_t i = 0; i < count; i++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const uint32_t pick = seed >> 24;
+                const uint32_t v = pick < 96 ? 0 : (pick < 160 ? 255 : (seed >> 8) & 0xFF);
+                const uint32_t grey = (v << 16) | (v << 8) | v;
+                pixels[i] = premultiplied ? (v << 24) | grey : 0xFF000000u | grey;
+            }
+        }
+
+        void RunLutChecks(int& failures)
+        {
+            for (bool premultiplied : { false, true })
+            {
+                const ColorLut neutral = ColorLut::Build(ColorSettings(), premultiplied);
+                Check(premultiplied ? "premultiplied: neutral is identity" : "opaque: neutral is identity",
+                      1, neutral.IsIdentity(), failures);
+            }
+
+            float red, green, blue;
+            ColorGains(ColorSettings(), red, green, blue);
+            Check("6500 K gains are exactly 1", 1, red == 1.0f && green == 1.0f && blue == 1.0f, failures);
+            Check("neutral key is 0", 0, ColorSettings().Key(), failures);
+            Check("out of range kelvin clamps", 1, Settings(500).Key() == Settings(ColorSettings::MIN_KELVIN).Key(),
+                  failures);
+            Check("distinct settings, distinct keys", 1, Settings(3200).Key() != Settings(3300).Key() &&
+                  Settings(3200, 10).Key() != Settings(3200).Key(), failures);
+
+            ColorGains(Settings(2700), red, green, blue);
+            Check("2700 K: red >= green > blue", 1, red >= green && green > blue, failures);
+            Check("2700 K: red at full brightness", 1, red == 1.0f, failures);
+            ColorGains(Settings(9000), red, green, blue);
+            Check("9000 K: blue >= green > red", 1, blue >= green && green > red, failures);
+            ColorGains(Settings(6500, 100), red, green, blue);
+            Check("green tint: green brightest", 1, green == 1.0f && red < 1.0f, failures);
+            ColorGains(Settings(6500, -100), red, green, blue);
+            Check("magenta tint: green darkest", 1, green < red && green < blue, failures);
+            ColorGains(Settings(6500, 0, 128), red, green, blue);
+            Check("brightness scales linear light (x1000)", 502, std::lround(red * 1000), failures);
+
+            int holes = 0;
+            int badPremultiplied = 0;
+            int notMonotonic = 0;
+            int darkChanged = 0;
+            for (int kelvin = ColorSettings::MIN_KELVIN; kelvin <= ColorSettings::MAX_KELVIN; kelvin += 100)
+            {
+                for (int tint : { -100, 0, 100 })
+                {
+                    for (int brightness : { 255, 40 })
+                    {
+                        const ColorLut opaque = ColorLut::Build(Settings(kelvin, tint, brightness), false);
+                        const ColorLut premultiplied = ColorLut::Build(Settings(kelvin, tint, brightness), true);
+                        holes += KeyHoles(opaque);
+                        badPremultiplied += InvalidPremultiplied(premultiplied);
+                        darkChanged += opaque.packed[0] != 0xFF000000u;
+                        darkChanged += premultiplied.packed[0] != 0;
+                        for (const ColorLut* lut : { &opaque, &premultiplied })
+                            notMonotonic += !Monotonic(lut->red) + !Monotonic(lut->green) + !Monotonic(lut->blue);
+                    }
+                }
+            }
+            Check("sweep: lit pixels never hit the color key", 0, holes, failures);
+            Check("sweep: premultiplied color <= alpha", 0, badPremultiplied, failures);
+            Check("sweep: tables never decrease", 0, notMonotonic, failures);
+            Check("sweep: dark stays dark", 0, darkChanged, failures);
+
+            // Gamma-correct: the tint's hue holds along the falloff
+            const ColorSettings warm = Settings(3000);
+            const ColorLut warmLut = ColorLut::Build(warm, false);
+            Check("3000 K hue drift at level 255 < 1%", 1, HueDriftPermille(warmLut, warm, 255) < 10, failures);
+            Check("3000 K hue drift at level 128 < 2%", 1, HueDriftPermille(warmLut, warm, 128) < 20, failures);
+            Check("3000 K hue drift at level 64 < 2%", 1, HueDriftPermille(warmLut, warm, 64) < 20, failures);
+        }
+
+        void RunKernelChecks(int& failures)
+        {
+            const ColorSettings warm = Settings(2700, 20);
+            const ColorSettings cool = Settings(9000);
+
+            for (bool premultiplied : { false, true })
+            {
+                const ColorLut lut = ColorLut::Build(warm, premultiplied);
+                Image source(67, 9, 4);
+                FillPattern(source, premultiplied, 7);
+
+                Image expected = source;
+                ApplyColorLut(lut, View(expected, premultiplied), SimdLevel::Scalar);
+
+                int mismatches = 0;
+                for (SimdLevel level : LEVELS)
+                {
+                    if (!GetSdfKernels(level))
+                        continue;
+
+                    // Every row length up to the width covers all tails
+                    Image actual = source;
+                    for (int width = 0; width <= source.width; width++)
+                    {
+                        std::memcpy(actual.pixels.data(), source.pixels.data(), source.pixels.size());
+                        BgraBuffer view = View(actual, premultiplied);
+                        view.width = width;
+                        ApplyColorLut(lut, view, level);
+                        for (int y = 0; y < source.height; y++)
+                        {
+                            const size_t row = static_cast<size_t>(y) * source.stride;
+                            mismatches += std::memcmp(actual.pixels.data() + row, expected.pixels.data() + row, width * 4) != 0;
+                            mismatches += std::memcmp(actual.pixels.data() + row + width * 4,
+                                                      source.pixels.data() + row + width * 4,
+                                                      (source.width - width) * 4) != 0;
+                        }
+                    }
+                }
+                Check(premultiplied ? "premultiplied: every level matches scalar" : "opaque: every level matches scalar",
+                      0, mismatches, failures);
+            }
+
+            // A temperature change recolors premultiplied pixels in place
+            {
+                Image once(64, 4, 4);
+                FillPattern(once, true, 11);
+                Image twice = once;
+                ApplyColorLut(ColorLut::Build(cool, true), View(once, true));
+                ApplyColorLut(ColorLut::Build(warm, true), View(twice, true));
+                ApplyColorLut(ColorLut::Build(cool, true), View(twice, true));
+                Check("premultiplied: recolor in place is exact", 1, once.pixels == twice.pixels, failures);
+            }
+
+            // Only rects are touched
+            {
+                Image image(40, 30, 4);
+                FillPattern(image, false, 3);
+                const Image before = image;
+                const SpanRect rects[] = { { 5, 5, 15, 10 }, { -10, 25, 100, 40 } };
+                ApplyColorLut(ColorLut::Build(warm, false), rects, 2, View(image, false));
+                Image full = before;
+                ApplyColorLut(ColorLut::Build(warm, false), View(full, false));
+
+                int wrong = 0;
+                for (int y = 0; y < image.height; y++)
+                {
+                    for (int x = 0; x < image.width; x++)
+                    {
+                        const bool inside = (x >= 5 && x < 15 && y >= 5 && y < 10) || y >= 25;
+                        const size_t at = static_cast<size_t>(y) * image.stride + x * 4;
+                        wrong += std::memcmp(&image.pixels[at], inside ? &full.pixels[at] : &before.pixels[at], 4) != 0;
+                    }
+                }
+                Check("rects: colored inside, untouched outside", 0, wrong, failures);
+            }
+
+            // Applying to a rendered frame allocates nothing
+            {
+                Image image(800, 600, 4);
+                FrameParams params;
+                params.width = image.width;
+                params.height = image.height;
+                SdfFrameRenderer::Render(params, View(image, false));
+                const ColorLut lut = ColorLut::Build(warm, false);
+                const double allocations = AllocationsPerCall([&] { ApplyColorLut(lut, View(image, false)); });
+                Check("apply: allocations per frame", 0, std::lround(allocations), failures);
+            }
+        }
+
+        // The per-pixel float path the LUT replaces
+        void ColorizeFloat(const ColorSettings& settings, const BgraBuffer& target)
+        {
+            float gains[3];
+            ColorGains(settings, gains[0], gains[1], gains[2]);
+            for (int y = 0; y < target.height; y++)
+            {
+                uint32_t* row = reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+                for (int x = 0; x < target.width; x++)
+                {
+                    const float linear = SrgbToLinear((row[x] & 0xFF) / 255.0f);
+                    uint32_t out = 0xFF000000u;
+                    for (int c = 0; c < 3; c++)
+                        out |= static_cast<uint32_t>(std::lround(LinearToSrgb(linear * gains[c]) * 255.0f)) << (16 - 8 * c);
+                    row[x] = out;
+                }
+            }
+        }
+    }
+
+    void RunColorSuite(const Options& options)
+    {
+        int failures = 0;
+        PrintCheckHeader();
+        RunLutChecks(failures);
+        RunKernelChecks(failures);
+        RecordFailures(failures);
+
+        const ColorSettings warm = Settings(3200, 10);
+        const double buildNs = MeasureNs(options, [&]
+        {
+            const ColorLut lut = ColorLut::Build(warm, false);
+            if (lut.packed[255] == 0)
+                std::printf(" ");
+        });
+        std::printf("\n%-24s %12.1f\n", "us/LUT build", buildNs / 1000.0);
+
+        // A rendered frame with a glow: mostly dark, a lit band and a
+        // falloff, colored in place. Both columns include copying the grey
+        // frame back first.
+        std::printf("\n%-12s %-8s %12s %12s\n", "resolution", "level", "us/frame", "vs float");
+        for (const Resolution& resolution : RESOLUTIONS)
+        {
+            if (options.quick && resolution.width > 1920)
+                continue;
+
+            FrameParams params;
+            params.width = resolution.width;
+            params.height = resolution.height;
+            params.glowRadius = 24;
+            Image frame(resolution.width, resolution.height, 4);
+            SdfFrameRenderer::Render(params, View(frame, false));
+            Image work = frame;
+            const BgraBuffer view = View(work, false);
+
+            const double floatNs = MeasureNs(options, [&]
+            {
+                std::memcpy(work.pixels.data(), frame.pixels.data(), frame.pixels.size());
+                ColorizeFloat(warm, view);
+            });
+            std::printf("%-12s %-8s %12.1f %12s\n", resolution.name, "float", floatNs / 1000.0, "1.0x");
+
+            const ColorLut lut = ColorLut::Build(warm, false);
+            for (SimdLevel level : LEVELS)
+            {
+                if (!GetSdfKernels(level))
+                    continue;
+                const double ns = MeasureNs(options, [&]
+                {
+                    std::memcpy(work.pixels.data(), frame.pixels.data(), frame.pixels.size());
+                    ApplyColorLut(lut, view, level);
+                });
+                std::printf("%-12s %-8s %12.1f %11.1fx\n", resolution.name, SimdLevelName(level), ns / 1000.0,
+                            floatNs / ns);
+            }
+        }
+    }
+}
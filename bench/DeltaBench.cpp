@@ -0,0 +1,209 @@
+// Incremental re-raster on thickness changes: re-rendering only the dirty
+// rectangles of the previous frame must give exactly the full render of
+// the new one, for every slider step, SIMD level and odd frame size. Then
+// the pixels touched and time taken against a full re-render.
+
+#include "BenchCommon.h"
+
+#include "core/FrameDelta.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <cstring>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        // The control panel's slider range (MIN_THICKNESS .. MAX_THICKNESS)
+        constexpr int MIN_THICKNESS = 20;
+        constexpr int MAX_THICKNESS = 150;
+
+        // Renders before, patches it to after through the delta and
+        // returns the pixels that differ from a full render of after.
+        // -1 when the delta said a full redraw is needed.
+        long long PatchMismatches(const FrameParams& before, const FrameParams& after, SimdLevel level,
+                                  Image& patched, Image& full)
+        {
+            std::vector<SpanRect> dirty;
+            if (!FrameDelta::Compute(before, after, dirty))
+                return -1;
+
+            SdfFrameRenderer::Render(before, View(patched), level);
+            SdfFrameRenderer::RenderRects(after, dirty.data(), dirty.size(), View(patched), level);
+            SdfFrameRenderer::Render(after, View(full), level);
+
+            long long mismatches = 0;
+            for (int y = 0; y < full.height; y++)
+            {
+                const uint8_t* a = patched.pixels.data() + static_cast<size_t>(y) * patched.stride;
+                const uint8_t* b = full.pixels.data() + static_cast<size_t>(y) * full.stride;
+                if (std::memcmp(a, b, static_cast<size_t>(full.width) * 4) == 0)
+                    continue;
+                for (int x = 0; x < full.width * 4; x += 4)
+                    mismatches += std::memcmp(a + x, b + x, 4) != 0;
+            }
+            return mismatches;
+        }
+
+        // Adds one PatchMismatches result to the running totals, keeping
+        // full-redraw fallbacks out of the pixel count
+        void Tally(long long result, long long& mismatches, long long& fullRedraws)
+        {
+            if (result < 0)
+                fullRedraws++;
+            else
+                mismatches += result;
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            FrameParams base;
+            base.width = 640;
+            base.height = 400;
+            base.cornerRadius = 100;
+            base.inset = 20;
+            base.blurSize = 2;
+
+            std::vector<SpanRect> dirty;
+            FrameParams resized = base;
+            resized.width++;
+            Check("size change needs a full redraw", 0, FrameDelta::Compute(base, resized, dirty), failures);
+            FrameParams glowing = base;
+            glowing.glowRadius = 12;
+            Check("glow radius change needs a full redraw", 0, FrameDelta::Compute(base, glowing, dirty), failures);
+            FrameParams dimmer = base;
+            dimmer.opacity = 100;
+            Check("opacity change needs a full redraw", 0, FrameDelta::Compute(base, dimmer, dirty), failures);
+            Check("same geometry has nothing dirty", 1, FrameDelta::Compute(base, base, dirty) && dirty.empty(), failures);
+
+            // Every one-notch step across the slider range, both directions,
+            // at every SIMD level
+            for (int l = 0; l <= static_cast<int>(DetectSimdLevel()); l++)
+            {
+                const SimdLevel level = static_cast<SimdLevel>(l);
+                Image patched(base.width, base.height, 4);
+                Image full(base.width, base.height, 4);
+                long long mismatches = 0, fullRedraws = 0;
+                for (int t = MIN_THICKNESS; t < MAX_THICKNESS; t++)
+                {
+                    FrameParams thin = base, thick = base;
+                    thin.frameThickness = t;
+                    thick.frameThickness = t + 1;
+                    Tally(PatchMismatches(thin, thick, level, patched, full), mismatches, fullRedraws);
+                    Tally(PatchMismatches(thick, thin, level, patched, full), mismatches, fullRedraws);
+                }
+                const std::string prefix = SimdLevelName(level);
+                Check((prefix + ": every slider step is bit-exact").c_str(), 0, mismatches, failures);
+                Check((prefix + ": no slider step falls back to full").c_str(), 0, fullRedraws, failures);
+            }
+
+            // The same steps with the blurred glow on: the ring is wider
+            // but the patch must still match a full render
+            for (const int glowRadius : { 10, 24 })
+            {
+                Image patched(base.width, base.height, 4);
+                Image full(base.width, base.height, 4);
+                long long mismatches = 0, fullRedraws = 0;
+                for (int t = MIN_THICKNESS; t < MAX_THICKNESS; t += 3)
+                {
+                    FrameParams thin = base, thick = base;
+                    thin.glowRadius = thick.glowRadius = glowRadius;
+                    thin.glowStrength = thick.glowStrength = 96;
+                    thin.frameThickness = t;
+                    thick.frameThickness = t + 1;
+                    Tally(PatchMismatches(thin, thick, DetectSimdLevel(), patched, full), mismatches, fullRedraws);
+                    Tally(PatchMismatches(thick, thin, DetectSimdLevel(), patched, full), mismatches, fullRedraws);
+                }
+                const std::string prefix = "glow " + std::to_string(glowRadius);
+                Check((prefix + ": every 3rd slider step is bit-exact").c_str(), 0, mismatches, failures);
+                Check((prefix + ": no slider step falls back to full").c_str(), 0, fullRedraws, failures);
+            }
+
+            // Big jumps, odd sizes, no falloff, wide falloff, a radius
+            // clamped by the frame, and tiny frames. The last three have no
+            // hole left on one side, so they must fall back to a full redraw.
+            struct Case
+            {
+                int width, height, radius, blur, fromThickness, toThickness;
+            };
+            const Case cases[] = {
+                { 641, 401, 100, 2, 20, 150 },
+                { 333, 217, 60, 0, 30, 31 },
+                { 333, 217, 60, 10, 30, 45 },
+                { 640, 400, 150, 2, 80, 81 },
+                { 301, 181, 200, 2, 40, 50 },
+                { 200, 150, 100, 2, 40, 60 },
+                { 180, 140, 30, 3, 35, 55 },
+                { 97, 61, 20, 1, 10, 12 },
+            };
+            long long caseMismatches = 0, fullRedraws = 0;
+            for (const Case& c : cases)
+            {
+                Image patched(c.width, c.height, 4);
+                Image full(c.width, c.height, 4);
+                FrameParams from = base, to = base;
+                from.width = to.width = c.width;
+                from.height = to.height = c.height;
+                from.blurSize = to.blurSize = c.blur;
+                from.cornerRadius = to.cornerRadius = c.radius;
+                from.frameThickness = c.fromThickness;
+                to.frameThickness = c.toThickness;
+                Tally(PatchMismatches(from, to, DetectSimdLevel(), patched, full), caseMismatches, fullRedraws);
+            }
+            Check("edge cases are bit-exact", 0, caseMismatches, failures);
+            Check("frames with no hole fall back to full", 3, fullRedraws, failures);
+
+            FrameParams big = base, bigNext = base;
+            big.width = bigNext.width = 3840;
+            big.height = bigNext.height = 2160;
+            big.frameThickness = 80;
+            bigNext.frameThickness = 81;
+            FrameDelta::Compute(big, bigNext, dirty);
+            Check("one 4K notch dirties under 10% of the frame", 1,
+                  FrameDelta::PixelCount(dirty) * 10 < static_cast<size_t>(big.width) * big.height, failures);
+
+            RecordFailures(failures);
+        }
+    }
+
+    void RunDeltaSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        const Resolution resolutions[] = {
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+        };
+
+        std::printf("\n%-6s %10s %12s %12s %9s\n", "res", "dirty-%", "full-us", "delta-us", "speedup");
+        for (const Resolution& res : resolutions)
+        {
+            FrameParams before;
+            before.width = res.width;
+            before.height = res.height;
+            before.frameThickness = 80;
+            FrameParams after = before;
+            after.frameThickness = 81;
+
+            std::vector<SpanRect> dirty;
+            FrameDelta::Compute(before, after, dirty);
+            Image frame(res.width, res.height, 4);
+            SdfFrameRenderer::Render(before, View(frame));
+
+            const double fullNs = MeasureNs(options, [&] { SdfFrameRenderer::Render(after, View(frame)); });
+            const double deltaNs = MeasureNs(options, [&]
+            {
+                FrameDelta::Compute(before, after, dirty);
+                SdfFrameRenderer::RenderRects(after, dirty.data(), dirty.size(), View(frame));
+            });
+
+            const double dirtyPercent = 100.0 * FrameDelta::PixelCount(dirty) / (static_cast<double>(res.width) * res.height);
+            std::printf("%-6s %10.2f %12.1f %12.1f %8.1fx\n", res.name, dirtyPercent, fullNs / 1e3, deltaNs / 1e3, fullNs / deltaNs);
+        }
+    }
+}
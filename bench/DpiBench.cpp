@@ -0,0 +1,163 @@
+// Per-monitor DPI: scale math, bucketing, and the per-bucket geometry cache
+// when the overlay moves between monitors of different DPIs.
+
+#include "BenchCommon.h"
+
+#include "core/DpiScale.h"
+#include "core/FrameSpans.h"
+#include "core/SurfaceCache.h"
+
+#include <cstring>
+#include <memory>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        // What the overlay renders per geometry, with tiles from the cache.
+        class DpiSurface : public CachedSurface
+        {
+        public:
+            FrameSpans spans;
+            std::shared_ptr<const NineSliceFrame> slices;
+            size_t ByteSize() const override { return spans.ByteSize(); }
+        };
+
+        bool SameMask(const NineSliceFrame& a, const NineSliceFrame& b, int width, int height)
+        {
+            Image left(width, height, 1);
+            Image right(width, height, 1);
+            a.ComposeMask({ left.pixels.data(), width, height, left.stride });
+            b.ComposeMask({ right.pixels.data(), width, height, right.stride });
+            return left.pixels == right.pixels;
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            Check("100%: thickness unchanged", 80, ScaleForDpi(80, 96), failures);
+            Check("125%: thickness", 100, ScaleForDpi(80, 120), failures);
+            Check("150%: inset", 30, ScaleForDpi(20, 144), failures);
+            Check("175%: corner radius", 175, ScaleForDpi(100, 168), failures);
+            Check("200%: thickness doubles", 160, ScaleForDpi(80, 192), failures);
+            Check("112.5% custom: thickness", 90, ScaleForDpi(80, 108), failures);
+            Check("positive values never reach 0", 1, ScaleForDpi(1, 48), failures);
+            Check("unknown DPI counts as 96", 96, DpiBucket(0), failures);
+            Check("110% snaps to 112.5%", 108, DpiBucket(106), failures);
+            Check("presets are their own bucket", 168, DpiBucket(168), failures);
+            Check("scale factor at 150%", 150, static_cast<long long>(DpiScaleFactor(144) * 100 + 0.5), failures);
+
+            FrameParams logical;
+            logical.frameThickness = 80;
+            logical.blurSize = 40;
+            logical.width = 3840;
+            logical.height = 2112;
+            const FrameParams device = ScaleFrameParams(logical, 192);
+            Check("size passes through", 3840, device.width, failures);
+            Check("blur is capped at 64", 64, device.blurSize, failures);
+            Check("same DPI bucket, same geometry", 1,
+                  SurfaceKey::FromParams(ScaleFrameParams(logical, 106), DpiBucket(106)) ==
+                  SurfaceKey::FromParams(ScaleFrameParams(logical, 108), DpiBucket(108)), failures);
+
+            // Monitor hopping: a 1080p panel at 100% and a 4K panel at 200%
+            DpiGeometryCache geometry;
+            SurfaceCache surfaces(64 * 1024 * 1024);
+            auto render = [&](const SurfaceKey& key)
+            {
+                const FrameParams params = key.ToParams();
+                auto surface = std::make_shared<DpiSurface>();
+                surface->spans.Build(params);
+                surface->slices = geometry.Acquire(params, key.dpi);
+                return surface;
+            };
+            auto place = [&](int width, int height, int dpi)
+            {
+                FrameParams params = ScaleFrameParams(logical, dpi);
+                params.width = width;
+                params.height = height;
+                return surfaces.Acquire(SurfaceKey::FromParams(params, DpiBucket(dpi)), render);
+            };
+
+            place(1920, 1032, 96);
+            place(3840, 2112, 192);
+            Check("first visit to two DPIs builds two tile sets", 2, static_cast<long long>(geometry.Stats().builds), failures);
+            for (int hop = 0; hop < 10; hop++)
+            {
+                place(1920, 1032, 96);
+                place(3840, 2112, 192);
+            }
+            Check("hopping back and forth re-rasterizes nothing", 2, static_cast<long long>(surfaces.Stats().misses), failures);
+
+            place(2560, 1392, 192);
+            Check("new size at a known DPI reuses its tiles", 2, static_cast<long long>(geometry.Stats().builds), failures);
+            Check("  ... and only composes a new surface", 3, static_cast<long long>(surfaces.Stats().misses), failures);
+
+            place(1366, 728, 120);
+            Check("new DPI builds its own tiles", 3, static_cast<long long>(geometry.Stats().builds), failures);
+            Check("one tile set per bucket", 3, static_cast<long long>(geometry.Stats().entries), failures);
+
+            logical.frameThickness = 100;
+            place(3840, 2112, 192);
+            Check("shape change rebuilds that bucket", 4, static_cast<long long>(geometry.Stats().builds), failures);
+            Check("  ... replacing, not adding", 3, static_cast<long long>(geometry.Stats().entries), failures);
+
+            FrameParams tiny = ScaleFrameParams(logical, 192);
+            tiny.width = 300;
+            tiny.height = 200;
+            const bool fullFrame = geometry.Acquire(tiny, 192)->IsFullFrame();
+            Check("tiny work area gets a full-frame build", 1, fullFrame, failures);
+            Check("  ... that is not kept", 3, static_cast<long long>(geometry.Stats().entries), failures);
+
+            // Cached tiles compose exactly what a fresh build would
+            FrameParams fresh = ScaleFrameParams(logical, 192);
+            fresh.width = 2560;
+            fresh.height = 1392;
+            NineSliceFrame direct;
+            direct.Build(fresh);
+            Check("cached tiles match a fresh build", 1,
+                  SameMask(*geometry.Acquire(fresh, 192), direct, fresh.width, fresh.height), failures);
+
+            RecordFailures(failures);
+        }
+    }
+
+    void RunDpiSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        const Resolution resolutions[] = {
+            { "1080p", 1920, 1032 },
+            { "1440p", 2560, 1392 },
+            { "4K", 3840, 2112 },
+        };
+        const int dpis[] = { 96, 120, 144, 192 };
+
+        // Tile cost per DPI: what a move to an unseen DPI costs versus a
+        // known one
+        std::printf("\n%-8s %5s %6s %10s %11s %10s\n", "res", "dpi", "tile", "build-us", "cached-us", "tile-KB");
+        for (const Resolution& resolution : resolutions)
+        {
+            for (int dpi : dpis)
+            {
+                FrameParams params = ScaleFrameParams(FrameParams(), dpi);
+                params.width = resolution.width;
+                params.height = resolution.height;
+
+                NineSliceFrame frame;
+                const double buildNs = MeasureNs(options, [&] { frame.Build(params); });
+
+                DpiGeometryCache geometry;
+                geometry.Acquire(params, dpi);
+                const double cachedNs = MeasureNs(options, [&] { geometry.Acquire(params, dpi); });
+
+                std::printf("%-8s %5d %6d %10.1f %11.3f %10.1f\n",
+                            resolution.name, dpi, frame.TileSize(), buildNs / 1e3, cachedNs / 1e3,
+                            frame.ByteSize() / 1024.0);
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+// Portable render benchmarks for the EdgeLightCore library.
+//
+// Usage: EdgeLightBench [--quick] [--json=<path>] [--golden=<dir>]
+//                       [--update-golden] [--budget-scale=<x>] [suite...]
+// With no suite names every suite runs except the long ones (matrix) and
+// the regression gate (gate), which only run when named. The exit code is
+// 1 when any check failed.
+
+#include "BenchCommon.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    struct Suite
+    {
+        const char* name;
+        void (*run)(const EdgeLightBench::Options&);
+        bool onlyWhenNamed = false;
+    };
+
+    constexpr Suite SUITES[] = {
+        { "sdf", EdgeLightBench::RunSdfSuite },
+        { "spans", EdgeLightBench::RunSpanSuite },
+        { "glow", EdgeLightBench::RunGlowSuite },
+        { "nineslice", EdgeLightBench::RunNineSliceSuite },
+        { "present", EdgeLightBench::RunPresentSuite },
+        { "cache", EdgeLightBench::RunCacheSuite },
+        { "scheduler", EdgeLightBench::RunSchedulerSuite },
+        { "transition", EdgeLightBench::RunTransitionSuite },
+        { "monitors", EdgeLightBench::RunMonitorSuite },
+        { "topology", EdgeLightBench::RunTopologySuite },
+        { "dpi", EdgeLightBench::RunDpiSuite },
+        { "renderers", EdgeLightBench::RunRendererSuite },
+        { "trace", EdgeLightBench::RunTraceSuite },
+        { "gdipool", EdgeLightBench::RunGdiPoolSuite },
+        { "delta", EdgeLightBench::RunDeltaSuite },
+        { "layered", EdgeLightBench::RunLayeredSuite },
+        { "strips", EdgeLightBench::RunStripSuite },
+        { "startup", EdgeLightBench::RunStartupSuite },
+        { "memory", EdgeLightBench::RunMemorySuite },
+        { "color", EdgeLightBench::RunColorSuite },
+        { "brightness", EdgeLightBench::RunBrightnessSuite },
+        { "timers", EdgeLightBench::RunTimerSuite },
+        { "matrix", EdgeLightBench::RunMatrixSuite, true },
+        { "gate", EdgeLightBench::RunGateSuite, true },
+    };
+
+    int failedChecks = 0;
+}
+
+void EdgeLightBench::PrintCheckHeader()
+{
+    std::printf("  %-44s %8s %8s\n", "check", "expected", "actual");
+}
+
+void EdgeLightBench::Check(const char* name, long long expected, long long actual, int& failures)
+{
+    const bool ok = expected == actual;
+    failures += ok ? 0 : 1;
+    std::printf("  %-44s %8lld %8lld  %s\n", name, expected, actual, ok ? "ok" : "FAIL");
+}
+
+void EdgeLightBench::CheckNear(const char* name, double expected, double actual, int& failures)
+{
+    const bool ok = std::fabs(expected - actual) < 1e-6;
+    failures += ok ? 0 : 1;
+    std::printf("  %-44s %8.3f %8.3f  %s\n", name, expected, actual, ok ? "ok" : "FAIL");
+}
+
+void EdgeLightBench::RecordFailures(int failures)
+{
+    std::printf("  %d check(s) failed\n", failures);
+    failedChecks += failures;
+}
+
+EdgeLight::BgraBuffer EdgeLightBench::View(Image& image, bool premultiplied)
+{
+    EdgeLight::BgraBuffer buffer = { image.pixels.data(), image.width, image.height, image.stride };
+    buffer.premultiplied = premultiplied;
+    return buffer;
+}
+
+EdgeLight::MaskBuffer EdgeLightBench::MaskView(Image& image)
+{
+    return { image.pixels.data(), image.width, image.height, image.stride };
+}
+
+int main(int argc, char** argv)
+{
+    EdgeLightBench::Options options;
+    std::vector<std::string> selected;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--quick") == 0)
+        {
+            options.quick = true;
+        }
+        else if (std::strncmp(argv[i], "--json=", 7) == 0)
+        {
+            options.jsonPath = argv[i] + 7;
+        }
+        else if (std::strncmp(argv[i], "--golden=", 9) == 0)
+        {
+            options.goldenDir = argv[i] + 9;
+        }
+        else if (std::strcmp(argv[i], "--update-golden") == 0)
+        {
+            options.updateGolden = true;
+        }
+        else if (std::strncmp(argv[i], "--budget-scale=", 15) == 0)
+        {
+            options.budgetScale = std::atof(argv[i] + 15);
+        }
+        else if (argv[i][0] == '-')
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 2;
+        }
+        else
+        {
+            selected.emplace_back(argv[i]);
+        }
+    }
+
+    int ran = 0;
+    for (const Suite& suite : SUITES)
+    {
+        bool wanted = selected.empty() && !suite.onlyWhenNamed;
+        for (const std::string& name : selected)
+            wanted = wanted || name == suite.name;
+
+        if (wanted)
+        {
+            std::printf("== %s ==\n", suite.name);
+            suite.run(options);
+            ran++;
+        }
+    }
+
+    if (ran == 0)
+    {
+        std::fprintf(stderr, "No matching suite\n");
+        return 2;
+    }
+    return failedChecks > 0 ? 1 : 0;
+}
@@ -0,0 +1,227 @@
+// Regression gate: a fixed set of frames rendered headlessly and compared
+// against the golden masks in bench/golden/, plus a per-frame time budget
+// for each configuration at 4K. Any mismatch or blown budget counts as a
+// failed check, so `EdgeLightBench gate` exits non-zero.
+//
+// Every configuration is checked on each path that is supposed to draw it:
+// the backend's own mask, every SIMD level of the software kernels and the
+// composed nine-slice tiles. A faster path that changes the frame by more
+// than the tolerance fails here before it can replace the old one.
+//
+// The budget is the cost of a new geometry at 4K: building the tiles with
+// the backend and composing them into a BGRA surface, best of several
+// runs. Budgets are for a reference desktop core; --budget-scale=<x>
+// stretches them on slower machines.
+//
+// --update-golden rewrites the golden images from the current renderers.
+// Only do that for an intended change of the frame's look.
+
+#include "BenchCommon.h"
+
+#include "core/FrameRenderer.h"
+#include "core/NineSlice.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#ifndef EDGELIGHT_GOLDEN_DIR
+#define EDGELIGHT_GOLDEN_DIR "bench/golden"
+#endif
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        struct GateConfig
+        {
+            const char* name;
+            RendererBackend backend;
+            int width;
+            int height;
+            int frameThickness;
+            int cornerRadius;
+            int inset;
+            int blurSize;
+            int glowRadius;
+            int tolerance;          // largest allowed per-pixel difference
+            double budgetMs;        // tiles + compose at 4K on the reference core
+        };
+
+        // Small enough to keep the golden files in the tree; the budget
+        // run uses the same shape at 4K.
+        constexpr GateConfig CONFIGS[] = {
+            { "reference-default", RendererBackend::Reference, 320, 200, 40, 60, 10, 2, 0, 0, 2.0 },
+            { "reference-thin", RendererBackend::Reference, 320, 200, 4, 12, 4, 0, 0, 0, 2.0 },
+            { "software-default", RendererBackend::Software, 320, 200, 40, 60, 10, 2, 0, 1, 2.0 },
+            { "software-thin", RendererBackend::Software, 320, 200, 4, 12, 4, 0, 0, 1, 2.0 },
+            { "software-square", RendererBackend::Software, 320, 200, 30, 8, 6, 4, 0, 1, 2.0 },
+            { "software-portrait", RendererBackend::Software, 200, 360, 24, 40, 8, 2, 0, 1, 2.0 },
+            { "software-glow", RendererBackend::Software, 360, 240, 24, 50, 20, 2, 16, 1, 3.0 },
+            { "software-fullframe", RendererBackend::Software, 160, 120, 30, 50, 10, 2, 0, 1, 2.0 },
+        };
+
+        constexpr int BUDGET_WIDTH = 3840;
+        constexpr int BUDGET_HEIGHT = 2160;
+
+        FrameParams ParamsFor(const GateConfig& config)
+        {
+            FrameParams params;
+            params.width = config.width;
+            params.height = config.height;
+            params.frameThickness = config.frameThickness;
+            params.cornerRadius = config.cornerRadius;
+            params.inset = config.inset;
+            params.blurSize = config.blurSize;
+            params.glowRadius = config.glowRadius;
+            return params;
+        }
+
+        std::string GoldenPath(const Options& options, const GateConfig& config)
+        {
+            return std::string(options.goldenDir ? options.goldenDir : EDGELIGHT_GOLDEN_DIR) + "/" + config.name + ".pgm";
+        }
+
+        // Golden images are binary PGM (P5), one byte of intensity per pixel.
+        bool ReadPgm(const std::string& path, Image& image)
+        {
+            FILE* in = std::fopen(path.c_str(), "rb");
+            if (!in)
+                return false;
+
+            int width = 0, height = 0, maxValue = 0;
+            const bool ok = std::fscanf(in, "P5 %d %d %d", &width, &height, &maxValue) == 3 && maxValue == 255 &&
+                std::fgetc(in) != EOF && width == image.width && height == image.height &&
+                std::fread(image.pixels.data(), 1, image.pixels.size(), in) == image.pixels.size();
+            std::fclose(in);
+            return ok;
+        }
+
+        bool WritePgm(const std::string& path, const Image& image)
+        {
+            FILE* out = std::fopen(path.c_str(), "wb");
+            if (!out)
+                return false;
+
+            std::fprintf(out, "P5\n%d %d\n255\n", image.width, image.height);
+            const bool ok = std::fwrite(image.pixels.data(), 1, image.pixels.size(), out) == image.pixels.size();
+            return std::fclose(out) == 0 && ok;
+        }
+
+        // Pixels further than tolerance from the golden image.
+        long long Mismatches(const Image& golden, const Image& actual, int tolerance, int& worst)
+        {
+            long long count = 0;
+            for (size_t i = 0; i < golden.pixels.size(); i++)
+            {
+                const int difference = std::abs(golden.pixels[i] - actual.pixels[i]);
+                worst = std::max(worst, difference);
+                count += difference > tolerance;
+            }
+            return count;
+        }
+
+        template <class Fn>
+        double BestOfNs(int runs, Fn&& fn)
+        {
+            using Clock = std::chrono::steady_clock;
+            fn();
+            double best = 0;
+            for (int i = 0; i < runs; i++)
+            {
+                const auto start = Clock::now();
+                fn();
+                const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                best = i == 0 ? ns : std::min(best, ns);
+            }
+            return best;
+        }
+
+        void CheckOutput(const Options& options, const GateConfig& config, IFrameRenderer& renderer, int& failures)
+        {
+            const FrameParams params = ParamsFor(config);
+            Image actual(config.width, config.height, 1);
+            renderer.RenderMask(params, MaskView(actual));
+
+            const std::string path = GoldenPath(options, config);
+            if (options.updateGolden)
+            {
+                Check("golden image written", 1, WritePgm(path, actual), failures);
+                return;
+            }
+
+            Image golden(config.width, config.height, 1);
+            if (!ReadPgm(path, golden))
+            {
+                std::printf("  cannot read %s (run with --update-golden to create it)\n", path.c_str());
+                Check("golden image loads", 1, 0, failures);
+                return;
+            }
+
+            int worst = 0;
+            Check("backend mask matches the golden image", 0, Mismatches(golden, actual, config.tolerance, worst), failures);
+
+            if (config.backend == RendererBackend::Software)
+            {
+                for (int l = 0; l <= static_cast<int>(DetectSimdLevel()); l++)
+                {
+                    const SimdLevel level = static_cast<SimdLevel>(l);
+                    Image kernel(config.width, config.height, 1);
+                    SdfFrameRenderer::RenderMask(params, MaskView(kernel), level);
+                    const std::string name = std::string(SimdLevelName(level)) + " kernels match the golden image";
+                    Check(name.c_str(), 0, Mismatches(golden, kernel, config.tolerance, worst), failures);
+                }
+            }
+
+            NineSliceFrame slices;
+            Image composed(config.width, config.height, 1);
+            if (slices.Build(params, renderer))
+                slices.ComposeMask(MaskView(composed));
+            Check(slices.IsFullFrame() ? "full-frame tile matches the golden image" : "composed tiles match the golden image",
+                  0, Mismatches(golden, composed, config.tolerance, worst), failures);
+            Check("largest difference within tolerance", 1, worst <= config.tolerance, failures);
+        }
+
+        void CheckBudget(const Options& options, const GateConfig& config, IFrameRenderer& renderer, int& failures)
+        {
+            FrameParams params = ParamsFor(config);
+            params.width = BUDGET_WIDTH;
+            params.height = BUDGET_HEIGHT;
+
+            Image surface(BUDGET_WIDTH, BUDGET_HEIGHT, 4);
+            const BgraBuffer view = View(surface);
+            NineSliceFrame slices;
+            const double ns = BestOfNs(options.quick ? 3 : 10, [&]
+            {
+                slices.Build(params, renderer);
+                slices.Compose(view, 255);
+            });
+
+            const double budgetNs = config.budgetMs * options.budgetScale * 1e6;
+            std::printf("  4K frame %.3f ms, budget %.3f ms\n", ns / 1e6, budgetNs / 1e6);
+            Check("4K frame within budget", 1, ns <= budgetNs, failures);
+        }
+    }
+
+    void RunGateSuite(const Options& options)
+    {
+        int failures = 0;
+        PrintCheckHeader();
+
+        for (const GateConfig& config : CONFIGS)
+        {
+            std::unique_ptr<IFrameRenderer> renderer = CreateFrameRenderer(config.backend);
+            std::printf("  [%s]\n", config.name);
+            CheckOutput(options, config, *renderer, failures);
+            if (!options.updateGolden)
+                CheckBudget(options, config, *renderer, failures);
+        }
+
+        RecordFailures(failures);
+    }
+}
@@ -0,0 +1,191 @@
+// GDI resource pool: lifetime and reuse checks against a mock allocator
+// that tracks every handle, then the cost of a pooled lookup against
+// creating the objects again on every paint, as OnPaint used to.
+
+#include "BenchCommon.h"
+
+#include "core/GdiResourcePool.h"
+
+#include <set>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        // Hands out increasing fake handles and remembers which are live,
+        // so leaks and double deletes show up.
+        class MockGdiAllocator : public GdiAllocator
+        {
+        public:
+            GdiHandle CreateBrush(uint8_t) override { return New(); }
+            GdiHandle CreateRegion(const FrameSpans& spans) override { regionRects += spans.SpanCount(); return New(); }
+            GdiHandle CreateEmptyRegion() override { return New(); }
+
+            void Delete(GdiHandle handle) override
+            {
+                badDeletes += live.erase(handle) == 0;
+            }
+
+            bool failNext = false;
+            std::set<GdiHandle> live;
+            uint64_t created = 0;
+            uint64_t badDeletes = 0;
+            uint64_t regionRects = 0;
+
+        private:
+            GdiHandle New()
+            {
+                if (failNext)
+                {
+                    failNext = false;
+                    return 0;
+                }
+                created++;
+                live.insert(nextHandle);
+                return nextHandle++;
+            }
+
+            GdiHandle nextHandle = 0x1000;
+        };
+
+        struct Geometry
+        {
+            SurfaceKey key;
+            FrameSpans spans;
+        };
+
+        void MakeGeometry(int thickness, Geometry& geometry)
+        {
+            FrameParams params;
+            params.width = 640;
+            params.height = 400;
+            params.frameThickness = thickness;
+            geometry.key = SurfaceKey::FromParams(params, 96);
+            geometry.spans.Build(params);
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            MockGdiAllocator allocator;
+            {
+                GdiResourcePool pool(allocator);
+                Check("nothing created up front", 0, static_cast<long long>(allocator.created), failures);
+
+                const GdiHandle black = pool.Brush(0);
+                Check("brush is created on first use", 1, static_cast<long long>(allocator.created), failures);
+                Check("same intensity, same brush", 1, pool.Brush(0) == black, failures);
+                for (int i = 0; i < 256; i++)
+                    pool.Brush(static_cast<uint8_t>(i));
+                for (int i = 0; i < 256; i++)
+                    pool.Brush(static_cast<uint8_t>(i));
+                Check("one brush per intensity", 256, static_cast<long long>(pool.Stats().brushes), failures);
+
+                // The paint loop: alternate between two geometries, clearing
+                // the stale part of the previous one every paint
+                Geometry thin, thick;
+                MakeGeometry(40, thin);
+                MakeGeometry(120, thick);
+                const uint64_t before = allocator.created;
+                for (int paint = 0; paint < 1000; paint++)
+                {
+                    const Geometry& lit = paint % 2 ? thin : thick;
+                    const Geometry& next = paint % 2 ? thick : thin;
+                    pool.Region(lit.key, lit.spans);
+                    pool.Region(next.key, next.spans);
+                    pool.Scratch();
+                    pool.Brush(0);
+                }
+                Check("1000 paints create two regions and scratch", 3, static_cast<long long>(allocator.created - before), failures);
+                Check("region rebuilt only per geometry", static_cast<long long>(thin.spans.SpanCount() + thick.spans.SpanCount()),
+                      static_cast<long long>(allocator.regionRects), failures);
+
+                // More geometries than the pool keeps: the oldest go
+                std::vector<Geometry> many(GdiResourcePool::MAX_REGIONS + 4);
+                for (size_t i = 0; i < many.size(); i++)
+                {
+                    MakeGeometry(20 + static_cast<int>(i), many[i]);
+                    pool.Region(many[i].key, many[i].spans);
+                }
+                const GdiPoolStats stats = pool.Stats();
+                Check("regions bounded (plus scratch)", static_cast<long long>(GdiResourcePool::MAX_REGIONS + 1),
+                      static_cast<long long>(stats.regions), failures);
+                Check("pool live count matches the allocator", static_cast<long long>(allocator.live.size()),
+                      static_cast<long long>(stats.live), failures);
+                Check("peak is the most ever live", static_cast<long long>(256 + GdiResourcePool::MAX_REGIONS + 1),
+                      static_cast<long long>(stats.peak), failures);
+
+                allocator.failNext = true;
+                Geometry failed;
+                MakeGeometry(99, failed);
+                Check("failed creation returns 0", 0, static_cast<long long>(pool.Region(failed.key, failed.spans)), failures);
+                Check("failed creation is not cached", 1, pool.Region(failed.key, failed.spans) != 0, failures);
+
+                pool.Clear();
+                Check("Clear releases everything", 0, static_cast<long long>(allocator.live.size()), failures);
+                pool.Brush(7);
+                pool.Scratch();
+            }
+            Check("destructor releases everything", 0, static_cast<long long>(allocator.live.size()), failures);
+            Check("no double or foreign deletes", 0, static_cast<long long>(allocator.badDeletes), failures);
+
+            RecordFailures(failures);
+        }
+    }
+
+    void RunGdiPoolSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        const Resolution resolutions[] = {
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+        };
+
+        // Per paint that changes geometry: two frame regions, a scratch
+        // region and the color-key brush
+        std::printf("\n%-6s %14s %14s\n", "res", "pooled-ns", "recreate-ns");
+        for (const Resolution& res : resolutions)
+        {
+            Geometry a, b;
+            FrameParams params;
+            params.width = res.width;
+            params.height = res.height;
+            a.key = SurfaceKey::FromParams(params, 96);
+            a.spans.Build(params);
+            params.frameThickness = 120;
+            b.key = SurfaceKey::FromParams(params, 96);
+            b.spans.Build(params);
+
+            MockGdiAllocator allocator;
+            GdiResourcePool pool(allocator);
+            const double pooledNs = MeasureNs(options, [&]
+            {
+                pool.Region(a.key, a.spans);
+                pool.Region(b.key, b.spans);
+                pool.Scratch();
+                pool.Brush(0);
+            });
+
+            // What the mock cannot show is the kernel side of a real
+            // create/delete; this is only the user-mode part
+            std::vector<SpanRect> rects;
+            const double recreateNs = MeasureNs(options, [&]
+            {
+                for (const Geometry* geometry : { &a, &b })
+                {
+                    geometry->spans.ToRects(rects);
+                    allocator.Delete(allocator.CreateRegion(geometry->spans));
+                }
+                allocator.Delete(allocator.CreateEmptyRegion());
+                allocator.Delete(allocator.CreateBrush(0));
+            });
+
+            std::printf("%-6s %14.1f %14.1f\n", res.name, pooledNs, recreateNs);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+// Glow radius sweep. The box-blur glow should cost the same per pixel at
+// every radius, while the legacy ring rasterizer grows with the radius.
+
+#include "BenchCommon.h"
+
+#include "core/FrameRasterizer.h"
+#include "core/GlowEngine.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        constexpr int RADII[] = { 2, 5, 10, 20, 40, 80, 120 };
+
+        // Straightforward O(radius) triple box blur in doubles, zero padded.
+        std::vector<double> ReferenceBlur(const Image& mask, int radius)
+        {
+            int boxes[EdgeLight::GlowEngine::PASSES];
+            EdgeLight::GlowEngine::BoxRadii(radius, boxes);
+
+            const int w = mask.width;
+            const int h = mask.height;
+            std::vector<double> a(mask.pixels.begin(), mask.pixels.end());
+            std::vector<double> b(a.size());
+
+            auto pass = [&](int r, bool horizontal)
+            {
+                for (int y = 0; y < h; y++)
+                {
+                    for (int x = 0; x < w; x++)
+                    {
+                        double sum = 0.0;
+                        for (int k = -r; k <= r; k++)
+                        {
+                            const int sx = horizontal ? x + k : x;
+                            const int sy = horizontal ? y : y + k;
+                            if (sx >= 0 && sx < w && sy >= 0 && sy < h)
+                                sum += a[static_cast<size_t>(sy) * w + sx];
+                        }
+                        b[static_cast<size_t>(y) * w + x] = sum / (2 * r + 1);
+                    }
+                }
+                std::swap(a, b);
+            };
+
+            for (int r : boxes)
+                pass(r, true);
+            for (int r : boxes)
+                pass(r, false);
+            return a;
+        }
+    }
+
+    void RunGlowSuite(const Options& options)
+    {
+        using namespace EdgeLight;
+
+        // Full frames are blurred band by band; they must match one blur of
+        // the whole plane, across band boundaries included
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            FrameParams params;
+            params.width = 700;
+            params.height = 900;
+            params.glowRadius = 24;
+            params.glowStrength = 96;
+
+            Image expected(params.width, params.height, 1);
+            FrameParams plain = params;
+            plain.glowRadius = 0;
+            SdfFrameRenderer::RenderMask(plain, MaskView(expected));
+            GlowEngine().Apply(MaskView(expected), params.glowRadius, params.glowStrength);
+
+            Image mask(params.width, params.height, 1);
+            SdfFrameRenderer::RenderMask(params, MaskView(mask));
+            long long maskMismatch = 0;
+            for (size_t i = 0; i < mask.pixels.size(); i++)
+                maskMismatch += mask.pixels[i] != expected.pixels[i];
+            Check("banded glow mask matches a whole-plane blur", 0, maskMismatch, failures);
+
+            Image frame(params.width, params.height, 4);
+            SdfFrameRenderer::Render(params, View(frame));
+            long long frameMismatch = 0;
+            for (int y = 0; y < params.height; y++)
+            {
+                for (int x = 0; x < params.width; x++)
+                {
+                    frameMismatch += frame.pixels[static_cast<size_t>(y) * frame.stride + x * 4] !=
+                                     expected.pixels[static_cast<size_t>(y) * expected.stride + x];
+                }
+            }
+            Check("banded glow frame matches a whole-plane blur", 0, frameMismatch, failures);
+            RecordFailures(failures);
+            std::printf("\n");
+        }
+
+        const Resolution res = { "1080p", 1920, 1080 };
+        std::printf("%-6s %6s %6s %10s %10s %10s %10s\n", "res", "radius", "extent", "glow-ms", "ns/pixel", "rings-ms", "max-err");
+
+        GlowEngine engine;
+        for (int radius : RADII)
+        {
+            FrameParams params;
+            params.width = res.width;
+            params.height = res.height;
+            params.blurSize = 0;
+
+            Image mask(res.width, res.height, 1);
+            MaskBuffer maskTarget = MaskView(mask);
+            SdfFrameRenderer::RenderMask(params, maskTarget);
+
+            const double glowNs = MeasureNs(options, [&] { engine.Blur(maskTarget, radius); });
+
+            // The old approach: one region pair per glow ring.
+            FrameParams ringParams = params;
+            ringParams.blurSize = std::min(radius, 64);
+            Image bgra(res.width, res.height, 4);
+            BgraBuffer bgraTarget = View(bgra);
+            const double ringsNs = MeasureNs(options, [&] { FrameRasterizer::Render(ringParams, bgraTarget); });
+
+            // Accuracy against the naive blur on a small frame.
+            FrameParams small = params;
+            small.width = 320;
+            small.height = 200;
+            small.cornerRadius = 40;
+            small.frameThickness = 20;
+            Image smallMask(small.width, small.height, 1);
+            MaskBuffer smallTarget = MaskView(smallMask);
+            SdfFrameRenderer::RenderMask(small, smallTarget);
+            const std::vector<double> expected = ReferenceBlur(smallMask, radius);
+            engine.Blur(smallTarget, radius);
+
+            double maxError = 0.0;
+            for (size_t i = 0; i < expected.size(); i++)
+                maxError = std::max(maxError, std::fabs(expected[i] - smallMask.pixels[i]));
+
+            const double pixels = static_cast<double>(res.width) * res.height;
+            std::printf("%-6s %6d %6d %10.3f %10.2f %10.3f %10.2f\n", res.name, radius, GlowEngine::Extent(radius),
+                        glowNs / 1e6, glowNs / pixels, ringsNs / 1e6, maxError);
+        }
+    }
+}
@@ -0,0 +1,178 @@
+// Per-pixel alpha: the premultiplied output UpdateLayeredWindow composites,
+// rendered straight into a caller-owned buffer with its own stride the way
+// the overlay renders into its DIB section. Checks the format against the
+// opaque renderer, that nothing outside the rows is touched and nothing is
+// allocated, then the cost against rendering aside and copying in.
+
+#include "BenchCommon.h"
+
+#include "core/FrameDelta.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <cstring>
+#include <string>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        // Bytes past each row, filled with GUARD; a DIB section's stride is
+        // exactly width * 4 but the contract is any stride
+        constexpr int ROW_PADDING = 36;
+        constexpr uint8_t GUARD = 0xA5;
+
+        // A buffer the renderer does not own, rows padded with guard bytes
+        struct ExternalBuffer
+        {
+            std::vector<uint8_t> bytes;
+            BgraBuffer view;
+
+            ExternalBuffer(int width, int height)
+                : bytes(static_cast<size_t>(width * 4 + ROW_PADDING) * height, GUARD)
+            {
+                view = { bytes.data(), width, height, width * 4 + ROW_PADDING, true };
+            }
+
+            uint32_t Pixel(int x, int y) const
+            {
+                uint32_t pixel;
+                std::memcpy(&pixel, bytes.data() + static_cast<size_t>(y) * view.stride + x * 4, 4);
+                return pixel;
+            }
+
+            long long DamagedGuards() const
+            {
+                long long damaged = 0;
+                for (int y = 0; y < view.height; y++)
+                {
+                    const uint8_t* pad = bytes.data() + static_cast<size_t>(y) * view.stride + view.width * 4;
+                    for (int i = 0; i < ROW_PADDING; i++)
+                        damaged += pad[i] != GUARD;
+                }
+                return damaged;
+            }
+        };
+
+        // Pixels where the premultiplied output is not white at the opaque
+        // render's grey: colour != alpha, or alpha != grey
+        long long FormatMismatches(const FrameParams& params, SimdLevel level, ExternalBuffer& premultiplied)
+        {
+            Image opaque(params.width, params.height, 4);
+            SdfFrameRenderer::Render(params, View(opaque), level);
+            SdfFrameRenderer::Render(params, premultiplied.view, level);
+
+            long long mismatches = 0;
+            for (int y = 0; y < params.height; y++)
+            {
+                for (int x = 0; x < params.width; x++)
+                {
+                    const uint8_t grey = opaque.pixels[static_cast<size_t>(y) * opaque.stride + x * 4];
+                    const uint32_t expected = uint32_t(grey) * 0x01010101u;
+                    mismatches += premultiplied.Pixel(x, y) != expected;
+                }
+            }
+            return mismatches;
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            FrameParams params;
+            params.width = 333;
+            params.height = 217;
+            params.frameThickness = 40;
+            params.cornerRadius = 60;
+
+            FrameParams glowing = params;
+            glowing.glowRadius = 12;
+            FrameParams dim = params;
+            dim.opacity = 90;
+
+            for (int l = 0; l <= static_cast<int>(DetectSimdLevel()); l++)
+            {
+                const SimdLevel level = static_cast<SimdLevel>(l);
+                ExternalBuffer buffer(params.width, params.height);
+                long long mismatches = 0;
+                for (const FrameParams* p : { &params, &glowing, &dim })
+                    mismatches += FormatMismatches(*p, level, buffer);
+                const std::string prefix = std::string(SimdLevelName(level)) + ": ";
+                Check((prefix + "white at the opaque grey").c_str(), 0, mismatches, failures);
+                Check((prefix + "row padding untouched").c_str(), 0, buffer.DamagedGuards(), failures);
+            }
+
+            ExternalBuffer buffer(params.width, params.height);
+            SdfFrameRenderer::Render(params, buffer.view);
+            Check("dark corner is fully transparent", 0, static_cast<long long>(buffer.Pixel(0, 0)), failures);
+            Check("band middle is opaque white", 1, buffer.Pixel(params.width / 2, 30) == 0xFFFFFFFFu, failures);
+
+            FrameParams off = params;
+            off.opacity = 0;
+            SdfFrameRenderer::Render(off, buffer.view);
+            long long lit = 0;
+            for (int y = 0; y < params.height; y++)
+            {
+                for (int x = 0; x < params.width; x++)
+                    lit += buffer.Pixel(x, y) != 0;
+            }
+            Check("opacity 0 is fully transparent", 0, lit, failures);
+            Check("row padding untouched", 0, buffer.DamagedGuards(), failures);
+
+            // A thickness notch patched in place matches a full render
+            FrameParams thicker = params;
+            thicker.frameThickness++;
+            std::vector<SpanRect> dirty;
+            ExternalBuffer patched(params.width, params.height);
+            ExternalBuffer full(params.width, params.height);
+            SdfFrameRenderer::Render(params, patched.view);
+            FrameDelta::Compute(params, thicker, dirty);
+            SdfFrameRenderer::RenderRects(thicker, dirty.data(), dirty.size(), patched.view);
+            SdfFrameRenderer::Render(thicker, full.view);
+            Check("delta patch in place is bit-exact", 1, patched.bytes == full.bytes, failures);
+
+            // Once the row scratch exists, rendering into the caller's
+            // pixels allocates nothing
+            const double allocations = AllocationsPerCall([&] { SdfFrameRenderer::Render(params, buffer.view); });
+            Check("no allocations per render", 0, static_cast<long long>(allocations * 1000), failures);
+
+            RecordFailures(failures);
+        }
+    }
+
+    void RunLayeredSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        const Resolution resolutions[] = {
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+        };
+
+        // "copy" is what the color-key path's shape would cost here:
+        // render into a buffer of our own, then copy it into the DIB
+        std::printf("\n%-6s %12s %12s\n", "res", "in-place-us", "copy-us");
+        for (const Resolution& res : resolutions)
+        {
+            FrameParams params;
+            params.width = res.width;
+            params.height = res.height;
+
+            Image dib(res.width, res.height, 4);
+            Image aside(res.width, res.height, 4);
+            const BgraBuffer dibView = View(dib, true);
+            const BgraBuffer asideView = View(aside, true);
+
+            const double inPlaceNs = MeasureNs(options, [&] { SdfFrameRenderer::Render(params, dibView); });
+            const double copyNs = MeasureNs(options, [&]
+            {
+                SdfFrameRenderer::Render(params, asideView);
+                std::memcpy(dib.pixels.data(), aside.pixels.data(), dib.pixels.size());
+            });
+
+            std::printf("%-6s %12.1f %12.1f\n", res.name, inPlaceNs / 1e3, copyNs / 1e3);
+        }
+    }
+}
@@ -0,0 +1,202 @@
+// Render cost across the whole parameter space: every resolution from
+// 1366x768 to 8K against the control panel's thickness range, corner radii
+// and glow sizes. Each combination reports ns/frame, bytes touched and heap
+// allocations per frame, for two paths:
+//
+//   frame  one full-frame software render (what every paint cost before
+//          the nine-slice surfaces)
+//   tiles  what the overlay does for a new geometry now: build the
+//          nine-slice tiles and expand every piece to BGRA
+//
+// Bytes touched are computed from the buffers each pass reads or writes,
+// so they track working-set growth rather than cache misses.
+//
+// --json=<path> writes the results as JSON, one object per combination, so
+// runs can be diffed.
+
+#include "BenchCommon.h"
+
+#include "core/FrameRenderer.h"
+#include "core/GlowEngine.h"
+#include "core/NineSlice.h"
+
+#include <cstring>
+#include <memory>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr Resolution RESOLUTIONS[] = {
+            { "1366", 1366, 768 },
+            { "1080p", 1920, 1080 },
+            { "1440p", 2560, 1440 },
+            { "4K", 3840, 2160 },
+            { "8K", 7680, 4320 },
+        };
+
+        // MIN_THICKNESS .. MAX_THICKNESS of the control panel slider
+        constexpr int THICKNESSES[] = { 20, 50, 80, 115, 150 };
+        constexpr int RADII[] = { 40, 100, 200 };
+        constexpr int GLOWS[] = { 0, 20, 40 };
+
+        // --quick keeps the corners of the matrix
+        constexpr int QUICK_THICKNESSES[] = { 20, 150 };
+        constexpr int QUICK_RADII[] = { 100 };
+        constexpr int QUICK_GLOWS[] = { 0, 40 };
+
+        struct Result
+        {
+            const char* path;
+            const Resolution* resolution;
+            int thickness;
+            int radius;
+            int glow;
+            double nsPerFrame;
+            size_t bytesTouched;
+            double allocsPerFrame;
+        };
+
+        size_t GlowBytes(int width, int height, int glow)
+        {
+            // Mask plane plus the engine's 16-bit working copy
+            return glow > 0 ? static_cast<size_t>(width) * height * (1 + sizeof(uint16_t)) : 0;
+        }
+
+        Result MeasureFrame(const Options& options, IFrameRenderer& renderer, const FrameParams& params)
+        {
+            Image target(params.width, params.height, 4);
+            const BgraBuffer view = View(target);
+            auto render = [&] { renderer.Render(params, view); };
+
+            Result result = {};
+            result.path = "frame";
+            result.nsPerFrame = MeasureNs(options, render);
+            result.bytesTouched = static_cast<size_t>(target.stride) * target.height +
+                GlowBytes(params.width, params.height, params.glowRadius);
+            result.allocsPerFrame = AllocationsPerCall(render);
+            return result;
+        }
+
+        Result MeasureTiles(const Options& options, const FrameParams& params)
+        {
+            NineSliceFrame slices;
+            std::vector<uint8_t> pieces;
+            size_t pieceBytes = 0;
+            auto build = [&]
+            {
+                slices.Build(params);
+                pieceBytes = 0;
+                for (int i = 0; i < static_cast<int>(SlicePiece::Count); i++)
+                {
+                    const SlicePiece piece = static_cast<SlicePiece>(i);
+                    SliceLayout layout;
+                    if (!slices.Layout(piece, params.width, params.height, layout))
+                        continue;
+
+                    const size_t bytes = static_cast<size_t>(layout.sourceWidth) * layout.sourceHeight * 4;
+                    if (pieces.size() < bytes)
+                        pieces.resize(bytes);
+                    slices.RenderPiece(piece, { pieces.data(), layout.sourceWidth, layout.sourceHeight, layout.sourceWidth * 4 }, 255);
+                    pieceBytes += bytes;
+                }
+            };
+
+            Result result = {};
+            result.path = "tiles";
+            result.nsPerFrame = MeasureNs(options, build);
+
+            // The corner is cut from a rendered quadrant of the frame
+            const int blur = params.glowRadius > 0 ? GlowEngine::Extent(params.glowRadius) : 0;
+            const int work = slices.IsFullFrame() ? 0 : slices.TileSize() + blur + 1;
+            const int quadrantWidth = slices.IsFullFrame() ? params.width : work;
+            const int quadrantHeight = slices.IsFullFrame() ? params.height : work;
+            result.bytesTouched = static_cast<size_t>(quadrantWidth) * quadrantHeight + slices.ByteSize() + pieceBytes +
+                GlowBytes(quadrantWidth, quadrantHeight, params.glowRadius);
+            result.allocsPerFrame = AllocationsPerCall(build);
+            return result;
+        }
+
+        void WriteJson(const char* path, const Options& options, const std::vector<Result>& results)
+        {
+            FILE* out = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "w");
+            if (!out)
+            {
+                std::fprintf(stderr, "Cannot write %s\n", path);
+                return;
+            }
+
+            std::fprintf(out, "{\n  \"suite\": \"matrix\",\n  \"quick\": %s,\n  \"simd\": \"%s\",\n  \"results\": [\n",
+                         options.quick ? "true" : "false", SimdLevelName(DetectSimdLevel()));
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                const Result& r = results[i];
+                std::fprintf(out,
+                             "    { \"path\": \"%s\", \"resolution\": \"%s\", \"width\": %d, \"height\": %d, "
+                             "\"thickness\": %d, \"radius\": %d, \"glow\": %d, "
+                             "\"nsPerFrame\": %.0f, \"bytesTouched\": %zu, \"allocsPerFrame\": %.2f }%s\n",
+                             r.path, r.resolution->name, r.resolution->width, r.resolution->height,
+                             r.thickness, r.radius, r.glow, r.nsPerFrame, r.bytesTouched, r.allocsPerFrame,
+                             i + 1 < results.size() ? "," : "");
+            }
+            std::fprintf(out, "  ]\n}\n");
+
+            if (out != stdout)
+                std::fclose(out);
+        }
+
+        template <class T, size_t N>
+        std::vector<int> Axis(const T (&values)[N])
+        {
+            return std::vector<int>(values, values + N);
+        }
+    }
+
+    void RunMatrixSuite(const Options& options)
+    {
+        const std::vector<int> thicknesses = options.quick ? Axis(QUICK_THICKNESSES) : Axis(THICKNESSES);
+        const std::vector<int> radii = options.quick ? Axis(QUICK_RADII) : Axis(RADII);
+        const std::vector<int> glows = options.quick ? Axis(QUICK_GLOWS) : Axis(GLOWS);
+        std::unique_ptr<IFrameRenderer> renderer = CreateFrameRenderer(RendererBackend::Software);
+
+        std::vector<Result> results;
+        std::printf("%-6s %-6s %5s %6s %5s %13s %12s %8s\n",
+                    "path", "res", "thick", "radius", "glow", "ns/frame", "bytes", "allocs");
+        for (const Resolution& resolution : RESOLUTIONS)
+        {
+            for (int thickness : thicknesses)
+            {
+                for (int radius : radii)
+                {
+                    for (int glow : glows)
+                    {
+                        FrameParams params;
+                        params.width = resolution.width;
+                        params.height = resolution.height;
+                        params.frameThickness = thickness;
+                        params.cornerRadius = radius;
+                        params.glowRadius = glow;
+
+                        for (Result result : { MeasureFrame(options, *renderer, params), MeasureTiles(options, params) })
+                        {
+                            result.resolution = &resolution;
+                            result.thickness = thickness;
+                            result.radius = radius;
+                            result.glow = glow;
+                            results.push_back(result);
+
+                            std::printf("%-6s %-6s %5d %6d %5d %13.0f %12zu %8.2f\n",
+                                        result.path, resolution.name, thickness, radius, glow,
+                                        result.nsPerFrame, result.bytesTouched, result.allocsPerFrame);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (options.jsonPath)
+            WriteJson(options.jsonPath, options, results);
+    }
+}
@@ -0,0 +1,264 @@
+// Memory budget: accounting and eviction order against fake holders on a
+// simulated clock, then a session with the real surface and tile caches:
+// usage per category while the slider is dragged, after the ceiling is
+// enforced and after the idle trim.
+
+#include "BenchCommon.h"
+
+#include "core/DpiScale.h"
+#include "core/MemoryBudget.h"
+#include "core/NineSlice.h"
+#include "core/SurfaceCache.h"
+
+#include <memory>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr int64_t SECOND_US = 1000000;
+        constexpr size_t KB = 1024;
+
+        // Holds bytes in blocks; shrinking drops whole blocks from the back.
+        struct FakeHolder
+        {
+            std::vector<size_t> blocks;
+            int shrinks = 0;
+
+            size_t Bytes() const
+            {
+                size_t bytes = 0;
+                for (size_t block : blocks)
+                    bytes += block;
+                return bytes;
+            }
+
+            void Shrink(size_t keep)
+            {
+                shrinks++;
+                while (!blocks.empty() && Bytes() > keep)
+                    blocks.pop_back();
+            }
+        };
+
+        void Register(MemoryBudget& budget, MemoryCategory category, FakeHolder& holder, bool regenerable = true)
+        {
+            MemoryBudget::ShrinkFn shrink;
+            if (regenerable)
+                shrink = [&holder](size_t keep) { holder.Shrink(keep); };
+            budget.Register(category, [&holder] { return holder.Bytes(); }, shrink);
+        }
+
+        void RunPolicyChecks(int& failures)
+        {
+            {
+                ManualClock clock(0);
+                MemoryBudget budget(clock, 100 * KB, 60 * SECOND_US);
+                FakeHolder layered{ { 40 * KB } };
+                FakeHolder tiles{ { 10 * KB, 10 * KB } };
+                FakeHolder surfaces{ { 20 * KB, 20 * KB, 20 * KB } };
+                FakeHolder pinned{ { 30 * KB } };
+                // Registered out of eviction order on purpose
+                Register(budget, MemoryCategory::Layered, layered);
+                Register(budget, MemoryCategory::Tiles, tiles);
+                Register(budget, MemoryCategory::Surfaces, surfaces);
+                Register(budget, MemoryCategory::Surfaces, pinned, false);
+
+                const MemoryUsage usage = budget.Usage();
+                Check("usage: surfaces KB", 90, static_cast<long long>(usage.Of(MemoryCategory::Surfaces) / KB), failures);
+                Check("usage: tiles KB", 20, static_cast<long long>(usage.Of(MemoryCategory::Tiles) / KB), failures);
+                Check("usage: layered KB", 40, static_cast<long long>(usage.Of(MemoryCategory::Layered) / KB), failures);
+                Check("usage: total KB", 150, static_cast<long long>(usage.total / KB), failures);
+
+                Check("enforce: releases the excess KB", 60, static_cast<long long>(budget.Enforce() / KB), failures);
+                Check("enforce: surfaces go first", 0, static_cast<long long>(surfaces.Bytes()), failures);
+                Check("enforce: pinned holder untouched KB", 30, static_cast<long long>(pinned.Bytes() / KB), failures);
+                Check("enforce: tiles untouched once under", 2, static_cast<long long>(tiles.blocks.size()), failures);
+                Check("enforce: layered never asked", 0, layered.shrinks, failures);
+                Check("enforce: under the ceiling is a no-op", 0, static_cast<long long>(budget.Enforce()), failures);
+
+                // 15 KB over: tiles only free whole 10 KB blocks
+                budget.SetCeiling(75 * KB);
+                Check("enforce: next category in whole blocks KB", 20, static_cast<long long>(budget.Enforce() / KB), failures);
+                Check("enforce: tiles cleared", 0, static_cast<long long>(tiles.Bytes()), failures);
+                Check("enforce: layered kept KB", 40, static_cast<long long>(layered.Bytes() / KB), failures);
+                Check("enforce: usage KB", 70, static_cast<long long>(budget.Usage().total / KB), failures);
+
+                budget.SetCeiling(0);
+                budget.Enforce();
+                Check("enforce: only the pinned bytes remain KB", 30, static_cast<long long>(budget.Usage().total / KB), failures);
+                Check("stats: enforcements", 3, static_cast<long long>(budget.Stats().enforcements), failures);
+                Check("stats: released KB", 120, static_cast<long long>(budget.Stats().releasedBytes / KB), failures);
+            }
+
+            {
+                ManualClock clock(0);
+                MemoryBudget budget(clock, 1024 * KB, 60 * SECOND_US);
+                FakeHolder surfaces{ { 20 * KB } };
+                FakeHolder pinned{ { 30 * KB } };
+                Register(budget, MemoryCategory::Surfaces, surfaces);
+                Register(budget, MemoryCategory::Layered, pinned, false);
+
+                Check("idle: counts from construction", 60 * SECOND_US, budget.TimeUntilIdle(), failures);
+                clock.Advance(50 * SECOND_US);
+                budget.Touch();
+                clock.Advance(50 * SECOND_US);
+                Check("idle: touch restarts the countdown", 10 * SECOND_US, budget.TimeUntilIdle(), failures);
+                Check("idle: not due early", 0, budget.IdleDue(), failures);
+                Check("idle: under the ceiling, nothing enforced", 0, static_cast<long long>(budget.Enforce()), failures);
+
+                clock.Advance(10 * SECOND_US);
+                Check("idle: due after the timeout", 1, budget.IdleDue(), failures);
+                Check("idle: regenerable holders released", 0, static_cast<long long>(surfaces.Bytes()), failures);
+                Check("idle: pinned holder kept KB", 30, static_cast<long long>(pinned.Bytes() / KB), failures);
+                Check("idle: nothing pending after the trim", -1, budget.TimeUntilIdle(), failures);
+                Check("idle: trims once", 0, budget.IdleDue(), failures);
+
+                budget.Touch();
+                Check("idle: rearmed by the next change", 60 * SECOND_US, budget.TimeUntilIdle(), failures);
+                budget.SetIdleTimeout(-1);
+                Check("idle: negative timeout disables", -1, budget.TimeUntilIdle(), failures);
+                Check("stats: idle trims", 1, static_cast<long long>(budget.Stats().idleTrims), failures);
+            }
+
+            {
+                ManualClock clock(0);
+                MemoryBudget budget(clock, 50 * KB, 60 * SECOND_US);
+                FakeHolder sampler{ { 16 * KB } };
+                FakeHolder layered{ { 40 * KB } };
+                Register(budget, MemoryCategory::Sampler, sampler);
+                Register(budget, MemoryCategory::Layered, layered);
+
+                const MemoryUsage usage = budget.Usage();
+                Check("sampler: counted on its own KB", 16, static_cast<long long>(usage.Of(MemoryCategory::Sampler) / KB), failures);
+                Check("sampler: not counted as layered KB", 40, static_cast<long long>(usage.Of(MemoryCategory::Layered) / KB), failures);
+                Check("sampler: released after layered", 1, budget.Enforce() > 0 && sampler.shrinks == 0, failures);
+                Check("sampler: reported by name", 1, budget.Report().find("sampler") != std::string::npos, failures);
+            }
+
+            {
+                // Two 4K per-pixel DIBs on screen are over the default ceiling
+                // by themselves; they must survive Enforce until the idle trim
+                ManualClock clock(0);
+                MemoryBudget budget(clock, 64 * 1024 * KB, 60 * SECOND_US);
+                FakeHolder surfaces{ { 2048 * KB } };
+                FakeHolder onScreen{ { 33750 * KB, 33750 * KB } };
+                Register(budget, MemoryCategory::Surfaces, surfaces);
+                budget.RegisterPinned(MemoryCategory::Layered, [&onScreen] { return onScreen.Bytes(); },
+                                      [&onScreen](size_t keep) { onScreen.Shrink(keep); });
+
+                Check("on screen: counted against the ceiling KB", 69548,
+                      static_cast<long long>(budget.Usage().total / KB), failures);
+                Check("on screen: enforce releases the others KB", 2048, static_cast<long long>(budget.Enforce() / KB), failures);
+                Check("on screen: enforce never shrinks it", 0, onScreen.shrinks, failures);
+                Check("on screen: still held KB", 67500, static_cast<long long>(onScreen.Bytes() / KB), failures);
+                clock.Advance(60 * SECOND_US);
+                Check("on screen: idle trim is due", 1, budget.IdleDue(), failures);
+                Check("on screen: released by the idle trim", 0, static_cast<long long>(onScreen.Bytes()), failures);
+            }
+
+            {
+                ManualClock clock(0);
+                MemoryBudget budget(clock);
+                const std::string report = budget.Report();
+                Check("report: empty budget lists categories", 1, report.find("layered") != std::string::npos, failures);
+                Check("report: empty budget total", 0, static_cast<long long>(budget.Usage().total), failures);
+            }
+        }
+
+        class SliceSurface : public CachedSurface
+        {
+        public:
+            std::shared_ptr<const NineSliceFrame> slices;
+            size_t ByteSize() const override { return sizeof(*this); }
+        };
+
+        struct Session
+        {
+            ManualClock clock;
+            SurfaceCache surfaces;
+            DpiGeometryCache tiles;
+            MemoryBudget budget;
+
+            Session(size_t cacheBytes, size_t ceiling) :
+                surfaces(cacheBytes),
+                budget(clock, ceiling, 5 * 60 * SECOND_US)
+            {
+                budget.Register(MemoryCategory::Surfaces,
+                                [this] { return surfaces.Stats().bytes; },
+                                [this](size_t keep) { surfaces.Trim(keep); });
+                budget.Register(MemoryCategory::Tiles,
+                                [this] { return tiles.Stats().bytes; },
+                                [this](size_t keep) { if (keep < tiles.Stats().bytes) tiles.Clear(); });
+            }
+
+            // One slider notch on each of two monitors
+            void Step(int thickness)
+            {
+                for (int dpi : { 96, 144 })
+                {
+                    FrameParams params;
+                    params.width = 1920;
+                    params.height = 1080;
+                    params.frameThickness = thickness;
+                    const FrameParams device = ScaleFrameParams(params, dpi);
+                    surfaces.Acquire(SurfaceKey::FromParams(device, dpi), [&](const SurfaceKey&)
+                    {
+                        auto surface = std::make_shared<SliceSurface>();
+                        surface->slices = tiles.Acquire(device, dpi);
+                        return surface;
+                    });
+                }
+                budget.Touch();
+                budget.Enforce();
+                clock.Advance(16667);
+            }
+        };
+
+        void RunSessionChecks(int& failures)
+        {
+            // Below one DPI bucket's tiles, so every notch runs into it
+            Session session(4 * 1024 * KB, 32 * KB);
+            for (int thickness = 20; thickness <= 150; thickness += 10)
+                session.Step(thickness);
+
+            const MemoryUsage dragged = session.budget.Usage();
+            Check("session: held to the ceiling", 1, dragged.total <= session.budget.Ceiling(), failures);
+            Check("session: enforced on every notch", 14, static_cast<long long>(session.budget.Stats().enforcements), failures);
+
+            session.clock.Advance(session.budget.TimeUntilIdle());
+            Check("session: idle trim fires", 1, session.budget.IdleDue(), failures);
+            Check("session: nothing cached after the trim", 0, static_cast<long long>(session.budget.Usage().total), failures);
+
+            session.budget.SetCeiling(MemoryBudget::DEFAULT_CEILING_BYTES);
+            session.Step(80);
+            Check("session: rebuilt on the next change", 1, session.budget.Usage().total > 0, failures);
+        }
+    }
+
+    void RunMemorySuite(const Options& options)
+    {
+        int failures = 0;
+        PrintCheckHeader();
+        RunPolicyChecks(failures);
+        RunSessionChecks(failures);
+        RecordFailures(failures);
+
+        // Usage per category through a slider drag with no ceiling to
+        // speak of, then what the idle trim leaves behind
+        Session session(4 * 1024 * KB, 1024 * 1024 * KB);
+        for (int thickness = 20; thickness <= 150; thickness += 10)
+            session.Step(thickness);
+        std::printf("\nafter a slider drag on two monitors\n%s", session.budget.Report().c_str());
+        session.clock.Advance(session.budget.TimeUntilIdle());
+        session.budget.IdleDue();
+        std::printf("\nafter the idle trim\n%s", session.budget.Report().c_str());
+
+        // Enforce is called after every render; under the ceiling it only
+        // measures
+        const double ns = MeasureNs(options, [&] { session.budget.Enforce(); });
+        std::printf("\n%-24s %12.1f\n", "ns/Enforce (under)", ns);
+    }
+}
@@ -0,0 +1,194 @@
+// Multi-monitor overlays: surface sharing and parallel preparation against
+// simulated topologies, serial versus the worker pool.
+
+#include "BenchCommon.h"
+
+#include "core/FrameSpans.h"
+#include "core/NineSlice.h"
+#include "core/OverlayOrchestrator.h"
+
+#include <atomic>
+#include <memory>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        // What the overlay renders per geometry: spans plus nine-slice tiles.
+        class OverlaySurface : public CachedSurface
+        {
+        public:
+            FrameSpans spans;
+            NineSliceFrame slices;
+            size_t ByteSize() const override { return spans.ByteSize() + slices.ByteSize(); }
+        };
+
+        std::shared_ptr<CachedSurface> RenderOverlay(const SurfaceKey& key)
+        {
+            const FrameParams params = key.ToParams();
+            auto surface = std::make_shared<OverlaySurface>();
+            surface->spans.Build(params);
+            surface->slices.Build(params);
+            return surface;
+        }
+
+        // Monitors laid out left to right, taskbar shaved off the bottom.
+        std::vector<MonitorDesc> Topology(std::initializer_list<Resolution> screens, int dpi = 96)
+        {
+            std::vector<MonitorDesc> monitors;
+            int x = 0;
+            for (const Resolution& screen : screens)
+            {
+                MonitorDesc monitor;
+                monitor.id = monitors.size() + 1;
+                monitor.left = x;
+                monitor.top = 0;
+                monitor.right = x + screen.width;
+                monitor.bottom = screen.height - 48;
+                monitor.dpi = dpi;
+                monitors.push_back(monitor);
+                x += screen.width;
+            }
+            return monitors;
+        }
+
+        constexpr Resolution FHD = { "1080p", 1920, 1080 };
+        constexpr Resolution QHD = { "1440p", 2560, 1440 };
+        constexpr Resolution UHD = { "4K", 3840, 2160 };
+        constexpr Resolution PORTRAIT = { "portrait", 1080, 1920 };
+
+        struct Setup
+        {
+            const char* name;
+            std::vector<MonitorDesc> monitors;
+        };
+
+        void RunBehaviourChecks(WorkerPool& pool)
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            SurfaceCache cache(64 * 1024 * 1024);
+            OverlayOrchestrator orchestrator(cache, pool);
+            std::vector<std::shared_ptr<CachedSurface>> surfaces;
+
+            const std::vector<MonitorDesc> monitors = Topology({ FHD, UHD, FHD, QHD, FHD });
+            PrepareStats stats = orchestrator.Prepare(monitors, FrameParams(), RenderOverlay, surfaces);
+            Check("every monitor gets a surface", monitors.size(), surfaces.size(), failures);
+            Check("identical geometry renders once", 3, stats.rendered, failures);
+            Check("identical geometry shares the surface", 1, surfaces[0] == surfaces[2] && surfaces[2] == surfaces[4], failures);
+            Check("different geometry does not share", 0, surfaces[0] == surfaces[1], failures);
+
+            stats = orchestrator.Prepare(monitors, FrameParams(), RenderOverlay, surfaces);
+            Check("second prepare renders nothing", 0, stats.rendered, failures);
+
+            std::vector<MonitorDesc> scaled = monitors;
+            scaled[1].dpi = 192;
+            stats = orchestrator.Prepare(scaled, FrameParams(), RenderOverlay, surfaces);
+            Check("DPI change renders only that monitor", 1, stats.rendered, failures);
+
+            RecordFailures(failures);
+        }
+
+        // The app's pool is created at startup; it must not cost threads
+        // until several surfaces are actually rendered at once
+        void RunPoolChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            WorkerPool pool(8);
+            Check("pool: no threads before any work", 0, pool.StartedWorkers(), failures);
+
+            SurfaceCache cache(64 * 1024 * 1024);
+            OverlayOrchestrator orchestrator(cache, pool);
+            std::vector<std::shared_ptr<CachedSurface>> surfaces;
+            orchestrator.Prepare(Topology({ FHD }), FrameParams(), RenderOverlay, surfaces);
+            Check("pool: one missing surface renders inline", 0, pool.StartedWorkers(), failures);
+
+            orchestrator.Prepare(Topology({ FHD, QHD, UHD }), FrameParams(), RenderOverlay, surfaces);
+            Check("pool: two missing surfaces start one worker", 1, pool.StartedWorkers(), failures);
+
+            std::atomic<int> sum{ 0 };
+            pool.ParallelFor(100, [&](int i) { sum += i; });
+            Check("pool: grows to its concurrency", 7, pool.StartedWorkers(), failures);
+            Check("pool: every task runs once", 4950, sum.load(), failures);
+
+            RecordFailures(failures);
+        }
+    }
+
+    void RunMonitorSuite(const Options& options)
+    {
+        WorkerPool pool;
+        WorkerPool serial(1);
+        RunBehaviourChecks(pool);
+        RunPoolChecks();
+
+        const Setup setups[] = {
+            { "1x1080p", Topology({ FHD }) },
+            { "2x1080p", Topology({ FHD, FHD }) },
+            { "3 mixed", Topology({ FHD, QHD, UHD }) },
+            { "4 mixed", Topology({ FHD, QHD, UHD, PORTRAIT }) },
+            { "4x4K", Topology({ UHD, UHD, UHD, UHD }) },
+            { "8 mixed", Topology({ FHD, QHD, UHD, PORTRAIT, FHD, QHD, UHD, PORTRAIT }) },
+            { "8 mixed dpi", [] {
+                std::vector<MonitorDesc> monitors = Topology({ FHD, QHD, UHD, PORTRAIT, FHD, QHD, UHD, PORTRAIT });
+                for (size_t i = 0; i < monitors.size(); i++)
+                    monitors[i].dpi = 96 + 24 * static_cast<int>(i);
+                return monitors;
+            }() },
+        };
+
+        struct Shape
+        {
+            const char* name;
+            int glowRadius;
+        };
+        const Shape shapes[] = { { "default", 0 }, { "glow40", 40 } };
+
+        std::printf("\n%-8s %-12s %8s %7s %11s %11s %11s\n",
+                    "shape", "setup", "monitors", "unique", "serial-ms", "pool-ms", "warm-us");
+        for (const Shape& shape : shapes)
+        {
+            FrameParams base;
+            base.glowRadius = shape.glowRadius;
+
+            for (const Setup& setup : setups)
+            {
+                std::vector<std::shared_ptr<CachedSurface>> surfaces;
+                PrepareStats stats;
+
+                // Cold: every distinct geometry is rendered
+                const double serialNs = MeasureNs(options, [&]
+                {
+                    SurfaceCache cache(64 * 1024 * 1024);
+                    OverlayOrchestrator orchestrator(cache, serial);
+                    stats = orchestrator.Prepare(setup.monitors, base, RenderOverlay, surfaces);
+                });
+                const double poolNs = MeasureNs(options, [&]
+                {
+                    SurfaceCache cache(64 * 1024 * 1024);
+                    OverlayOrchestrator orchestrator(cache, pool);
+                    orchestrator.Prepare(setup.monitors, base, RenderOverlay, surfaces);
+                });
+
+                // Warm: reconfiguring back to a known layout
+                SurfaceCache cache(64 * 1024 * 1024);
+                OverlayOrchestrator orchestrator(cache, pool);
+                orchestrator.Prepare(setup.monitors, base, RenderOverlay, surfaces);
+                const double warmNs = MeasureNs(options, [&]
+                {
+                    orchestrator.Prepare(setup.monitors, base, RenderOverlay, surfaces);
+                });
+
+                std::printf("%-8s %-12s %8zu %7zu %11.3f %11.3f %11.1f\n",
+                            shape.name, setup.name, stats.monitors, stats.uniqueSurfaces,
+                            serialNs / 1e6, poolNs / 1e6, warmNs / 1e3);
+            }
+        }
+        std::printf("pool: %d threads\n", pool.Concurrency());
+    }
+}
@@ -0,0 +1,80 @@
+// Nine-slice tiles: memory, build and compose cost, and a pixel-exact
+// comparison of the composed frame against the full-frame renderer.
+
+#include "BenchCommon.h"
+
+#include "core/NineSlice.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <cstring>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        constexpr Resolution RESOLUTIONS[] = {
+            { "tiny", 400, 260 },
+            { "1366", 1366, 768 },
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+            { "8K", 7680, 4320 },
+        };
+
+        struct Shape
+        {
+            const char* name;
+            int thickness;
+            int blurSize;
+            int glowRadius;
+        };
+
+        constexpr Shape SHAPES[] = {
+            { "default", 80, 2, 0 },
+            { "thin", 20, 2, 0 },
+            { "thick", 150, 2, 0 },
+            { "glow40", 80, 0, 40 },
+        };
+    }
+
+    void RunNineSliceSuite(const Options& options)
+    {
+        using namespace EdgeLight;
+
+        std::printf("%-6s %-8s %5s %9s %12s %10s %10s %10s\n",
+                    "res", "shape", "tile", "tile-KB", "backbuf-KB", "build-us", "compose-ms", "mismatch");
+
+        for (const Resolution& res : RESOLUTIONS)
+        {
+            for (const Shape& shape : SHAPES)
+            {
+                FrameParams params;
+                params.width = res.width;
+                params.height = res.height;
+                params.frameThickness = shape.thickness;
+                params.blurSize = shape.blurSize;
+                params.glowRadius = shape.glowRadius;
+
+                NineSliceFrame slices;
+                const double buildNs = MeasureNs(options, [&] { slices.Build(params); });
+
+                Image bgra(res.width, res.height, 4);
+                BgraBuffer bgraTarget = View(bgra);
+                const double composeNs = MeasureNs(options, [&] { slices.Compose(bgraTarget, 255); });
+
+                Image expected(res.width, res.height, 1);
+                SdfFrameRenderer::RenderMask(params, MaskView(expected));
+                Image composed(res.width, res.height, 1);
+                slices.ComposeMask(MaskView(composed));
+
+                size_t mismatches = 0;
+                for (size_t i = 0; i < expected.pixels.size(); i++)
+                    mismatches += expected.pixels[i] != composed.pixels[i];
+
+                std::printf("%-6s %-8s %5d %9.1f %12.1f %10.1f %10.3f %10zu\n",
+                            res.name, shape.name, slices.IsFullFrame() ? 0 : slices.TileSize(),
+                            slices.ByteSize() / 1024.0, bgra.pixels.size() / 1024.0,
+                            buildNs / 1e3, composeNs / 1e6, mismatches);
+            }
+        }
+    }
+}
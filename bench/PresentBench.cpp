@@ -0,0 +1,92 @@
+// Brightness changes: re-rasterizing the frame at a new opacity versus
+// presenting a cached full-intensity frame with a constant alpha.
+
+#include "BenchCommon.h"
+
+#include "core/FramePresenter.h"
+#include "core/SdfFrameRenderer.h"
+
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        constexpr Resolution RESOLUTIONS[] = {
+            { "1366", 1366, 768 },
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+        };
+
+        constexpr int ALPHAS[] = { 51, 128, 217 };
+
+        void FillOpaqueBlack(Image& image)
+        {
+            for (size_t i = 0; i < image.pixels.size(); i += 4)
+            {
+                image.pixels[i + 0] = 0;
+                image.pixels[i + 1] = 0;
+                image.pixels[i + 2] = 0;
+                image.pixels[i + 3] = 0xFF;
+            }
+        }
+
+        size_t CountMismatches(const Image& a, const Image& b)
+        {
+            size_t mismatches = 0;
+            for (size_t i = 0; i < a.pixels.size(); i++)
+                mismatches += a.pixels[i] != b.pixels[i];
+            return mismatches;
+        }
+    }
+
+    void RunPresentSuite(const Options& options)
+    {
+        using namespace EdgeLight;
+
+        std::printf("%-6s %5s %12s %12s %12s %10s %10s\n",
+                    "res", "alpha", "render-ms", "present-ms", "scalar-ms", "vs-render", "vs-scalar");
+
+        for (const Resolution& res : RESOLUTIONS)
+        {
+            FrameParams params;
+            params.width = res.width;
+            params.height = res.height;
+
+            Image cached(res.width, res.height, 4);
+            const BgraBuffer cachedBuffer = View(cached);
+            SdfFrameRenderer::Render(params, cachedBuffer);
+
+            for (int alpha : ALPHAS)
+            {
+                FrameParams dimmed = params;
+                dimmed.opacity = alpha;
+
+                Image rendered(res.width, res.height, 4);
+                const BgraBuffer renderedBuffer = View(rendered);
+                const double renderNs = MeasureNs(options, [&] { SdfFrameRenderer::Render(dimmed, renderedBuffer); });
+
+                // Present over opaque black, the overlay's colour key. The
+                // clear is part of the timing, as it would be in a real present.
+                Image presented(res.width, res.height, 4);
+                const BgraBuffer presentedBuffer = View(presented);
+                const double presentNs = MeasureNs(options, [&]
+                {
+                    FillOpaqueBlack(presented);
+                    FramePresenter::PresentWithAlpha(cachedBuffer, presentedBuffer, alpha);
+                });
+
+                Image scalar(res.width, res.height, 4);
+                const BgraBuffer scalarBuffer = View(scalar);
+                const double scalarNs = MeasureNs(options, [&]
+                {
+                    FillOpaqueBlack(scalar);
+                    FramePresenter::PresentWithAlpha(cachedBuffer, scalarBuffer, alpha, SimdLevel::Scalar);
+                });
+
+                std::printf("%-6s %5d %12.3f %12.3f %12.3f %10zu %10zu\n",
+                            res.name, alpha, renderNs / 1e6, presentNs / 1e6, scalarNs / 1e6,
+                            CountMismatches(rendered, presented), CountMismatches(scalar, presented));
+            }
+        }
+    }
+}
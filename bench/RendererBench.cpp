@@ -0,0 +1,273 @@
+// Render backends: one correctness harness and one benchmark that every
+// IFrameRenderer runs through. GDI and Direct2D join on Windows builds.
+
+#include "BenchCommon.h"
+
+#include "core/FrameRenderer.h"
+#include "core/NineSlice.h"
+
+#if EDGELIGHT_HAVE_D2D
+#include "win/D2DFrameRenderer.h"
+#endif
+#if EDGELIGHT_HAVE_GDI
+#include "win/GdiFrameRenderer.h"
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        std::vector<std::unique_ptr<IFrameRenderer>> CreateBackends()
+        {
+            std::vector<std::unique_ptr<IFrameRenderer>> backends;
+            for (RendererBackend backend : { RendererBackend::Reference, RendererBackend::Software, RendererBackend::Null })
+                backends.push_back(CreateFrameRenderer(backend));
+#if EDGELIGHT_HAVE_GDI
+            backends.push_back(CreateGdiFrameRenderer());
+#endif
+#if EDGELIGHT_HAVE_D2D
+            if (auto d2d = CreateD2DFrameRenderer())
+                backends.push_back(std::move(d2d));
+#endif
+            return backends;
+        }
+
+        uint32_t Pixel(const Image& image, int x, int y)
+        {
+            return reinterpret_cast<const uint32_t*>(image.pixels.data() + static_cast<size_t>(y) * image.stride)[x];
+        }
+
+        // Pixels that are not opaque grey; every backend writes only those.
+        long long NonGrey(const Image& image)
+        {
+            long long count = 0;
+            for (int y = 0; y < image.height; y++)
+            {
+                for (int x = 0; x < image.width; x++)
+                {
+                    const uint32_t p = Pixel(image, x, y);
+                    const uint32_t b = p & 0xFF;
+                    if ((p >> 24) != 0xFF || ((p >> 8) & 0xFF) != b || ((p >> 16) & 0xFF) != b)
+                        count++;
+                }
+            }
+            return count;
+        }
+
+        // Largest difference between a pixel and its mirror images.
+        int Asymmetry(const Image& image)
+        {
+            int worst = 0;
+            for (int y = 0; y < image.height; y++)
+            {
+                for (int x = 0; x < image.width; x++)
+                {
+                    const int v = Pixel(image, x, y) & 0xFF;
+                    const int h = Pixel(image, image.width - 1 - x, y) & 0xFF;
+                    const int w = Pixel(image, x, image.height - 1 - y) & 0xFF;
+                    worst = std::max(worst, std::max(std::abs(v - h), std::abs(v - w)));
+                }
+            }
+            return worst;
+        }
+
+        void CheckBackend(IFrameRenderer& renderer, IFrameRenderer& reference, int& failures)
+        {
+            const bool lit = renderer.Backend() != RendererBackend::Null;
+            std::printf("  [%s]\n", renderer.Name());
+
+            FrameParams params;
+            params.width = 640;
+            params.height = 400;
+            params.frameThickness = 60;
+            params.cornerRadius = 80;
+            params.blurSize = 4;
+
+            Image full(params.width, params.height, 4);
+            Check("renders", 1, renderer.Render(params, View(full)), failures);
+            Check("every pixel opaque grey", 0, NonGrey(full), failures);
+            Check("outside the frame is the color key", 0, Pixel(full, 2, 2) & 0xFF, failures);
+            Check("interior is the color key", 0, Pixel(full, params.width / 2, params.height / 2) & 0xFF, failures);
+            Check("middle of the band is fully lit", lit ? 255 : 0,
+                  Pixel(full, params.width / 2, params.inset + params.frameThickness / 2) & 0xFF, failures);
+            Check("mirror symmetric (max level difference)", 0, Asymmetry(full) > 1, failures);
+
+            // Top-left quadrant alone must match the full render
+            Image quadrant(params.width / 2, params.height / 2, 4);
+            renderer.Render(params, View(quadrant));
+            long long quadrantMismatch = 0;
+            for (int y = 0; y < quadrant.height; y++)
+            {
+                for (int x = 0; x < quadrant.width; x++)
+                    quadrantMismatch += Pixel(quadrant, x, y) != Pixel(full, x, y);
+            }
+            Check("partial target is the top-left of the frame", 0, quadrantMismatch, failures);
+
+            // Mask equals the full-opacity BGRA output
+            Image mask(params.width, params.height, 1);
+            renderer.RenderMask(params, MaskView(mask));
+            long long maskMismatch = 0;
+            for (int y = 0; y < params.height; y++)
+            {
+                for (int x = 0; x < params.width; x++)
+                    maskMismatch += mask.pixels[static_cast<size_t>(y) * mask.stride + x] != (Pixel(full, x, y) & 0xFF);
+            }
+            Check("mask matches the full-opacity frame", 0, maskMismatch, failures);
+
+            FrameParams dark = params;
+            dark.opacity = 0;
+            Image off(params.width, params.height, 4);
+            renderer.Render(dark, View(off));
+            long long litPixels = 0;
+            for (int y = 0; y < params.height; y++)
+            {
+                for (int x = 0; x < params.width; x++)
+                    litPixels += (Pixel(off, x, y) & 0xFF) != 0;
+            }
+            Check("opacity 0 is all color key", 0, litPixels, failures);
+
+            // Nine-slice tiles built by the backend compose its own mask
+            FrameParams large = params;
+            large.width = 1280;
+            large.height = 720;
+            NineSliceFrame slices;
+            Check("nine-slice tiles build", 1, slices.Build(large, renderer), failures);
+            Image composed(large.width, large.height, 1);
+            Image direct(large.width, large.height, 1);
+            slices.ComposeMask(MaskView(composed));
+            renderer.RenderMask(large, MaskView(direct));
+            long long sliceMismatch = 0;
+            for (size_t i = 0; i < composed.pixels.size(); i++)
+                sliceMismatch += composed.pixels[i] != direct.pixels[i];
+            Check("composed tiles match the backend's frame", 0, sliceMismatch, failures);
+
+            // Same frame as the anti-aliased reference. The ring falloff
+            // sits a few pixels inside the band where the analytic one
+            // glows into the hole, so compare coverage, not levels.
+            if (lit && &renderer != &reference)
+            {
+                Image expected(params.width, params.height, 4);
+                reference.Render(params, View(expected));
+                long long band = 0, covered = 0, stray = 0;
+                for (int y = 0; y < params.height; y++)
+                {
+                    for (int x = 0; x < params.width; x++)
+                    {
+                        const int actual = Pixel(full, x, y) & 0xFF;
+                        const int wanted = Pixel(expected, x, y) & 0xFF;
+                        band += wanted == 255;
+                        covered += wanted == 255 && actual >= 128;
+                        stray += wanted == 0 && actual >= 128;
+                    }
+                }
+                Check("covers 90% of the software frame's band", 1, covered * 10 >= band * 9, failures);
+                Check("lit only where the software frame is", 0, stray, failures);
+            }
+        }
+
+#if EDGELIGHT_HAVE_GDI
+        // How far the portable reference rings are from the GDI regions they
+        // emulate. Reported rather than checked: GDI's round-rect scan
+        // conversion has no published spec to hold the reference to.
+        void ReportEmulation(std::vector<std::unique_ptr<IFrameRenderer>>& backends)
+        {
+            IFrameRenderer* gdi = nullptr;
+            IFrameRenderer* emulation = nullptr;
+            for (const auto& backend : backends)
+            {
+                if (backend->Backend() == RendererBackend::Gdi)
+                    gdi = backend.get();
+                else if (backend->Backend() == RendererBackend::Reference)
+                    emulation = backend.get();
+            }
+
+            FrameParams params;
+            params.width = 640;
+            params.height = 400;
+            params.frameThickness = 60;
+            params.cornerRadius = 80;
+            params.blurSize = 4;
+
+            Image expected(params.width, params.height, 1);
+            Image actual(params.width, params.height, 1);
+            gdi->RenderMask(params, MaskView(expected));
+            emulation->RenderMask(params, MaskView(actual));
+
+            long long differing = 0;
+            int worst = 0;
+            for (size_t i = 0; i < expected.pixels.size(); i++)
+            {
+                const int difference = std::abs(expected.pixels[i] - actual.pixels[i]);
+                differing += difference != 0;
+                worst = std::max(worst, difference);
+            }
+            std::printf("  reference vs gdi: %lld of %zu pixels differ, worst by %d levels\n",
+                        differing, expected.pixels.size(), worst);
+        }
+#endif
+
+        void RunBehaviourChecks(std::vector<std::unique_ptr<IFrameRenderer>>& backends)
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            RendererBackend parsed = RendererBackend::Null;
+            Check("backend names round-trip", 1,
+                  ParseRendererBackend("d2d", parsed) && parsed == RendererBackend::Direct2D, failures);
+            Check("unknown names are rejected", 0, ParseRendererBackend("vulkan", parsed), failures);
+            Check("GDI is not portable", 1, CreateFrameRenderer(RendererBackend::Gdi) == nullptr, failures);
+            Check("Direct2D is not portable", 1, CreateFrameRenderer(RendererBackend::Direct2D) == nullptr, failures);
+
+            IFrameRenderer* reference = nullptr;
+            for (const auto& backend : backends)
+            {
+                if (backend->Backend() == RendererBackend::Software)
+                    reference = backend.get();
+            }
+            for (const auto& backend : backends)
+                CheckBackend(*backend, *reference, failures);
+
+#if EDGELIGHT_HAVE_GDI
+            ReportEmulation(backends);
+#endif
+            RecordFailures(failures);
+        }
+    }
+
+    void RunRendererSuite(const Options& options)
+    {
+        std::vector<std::unique_ptr<IFrameRenderer>> backends = CreateBackends();
+        RunBehaviourChecks(backends);
+
+        const Resolution resolutions[] = {
+            { "1366", 1366, 768 },
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+        };
+
+        std::printf("\n%-10s %-6s %11s %10s\n", "backend", "res", "frame-ms", "tiles-us");
+        for (const auto& backend : backends)
+        {
+            for (const Resolution& res : resolutions)
+            {
+                FrameParams params;
+                params.width = res.width;
+                params.height = res.height;
+
+                Image frame(res.width, res.height, 4);
+                const double frameNs = MeasureNs(options, [&] { backend->Render(params, View(frame)); });
+
+                NineSliceFrame slices;
+                const double tilesNs = MeasureNs(options, [&] { slices.Build(params, *backend); });
+
+                std::printf("%-10s %-6s %11.3f %10.1f\n", backend->Name(), res.name, frameNs / 1e6, tilesNs / 1e3);
+            }
+        }
+    }
+}
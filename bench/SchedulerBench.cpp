@@ -0,0 +1,143 @@
+// Render scheduler: coalescing checks against a simulated clock, then a
+// simulated slider drag and hotkey repeat showing invalidations versus
+// renders.
+
+#include "BenchCommon.h"
+
+#include "core/RenderScheduler.h"
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr int64_t INTERVAL_US = 16667;
+
+        // Drives the scheduler the way the overlay's timer does: fire as soon
+        // as the pending render is due.
+        int Pump(ManualClock& clock, RenderScheduler& scheduler, uint32_t* flags = nullptr)
+        {
+            int renders = 0;
+            const int64_t wait = scheduler.TimeUntilDue();
+            if (wait < 0)
+                return 0;
+
+            clock.Advance(wait);
+            const uint32_t released = scheduler.BeginFrame();
+            if (released != DIRTY_NONE)
+                renders++;
+            if (flags)
+                *flags = released;
+            return renders;
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            {
+                ManualClock clock(10 * INTERVAL_US + 100);
+                RenderScheduler scheduler(clock, INTERVAL_US);
+                Check("idle: nothing due", -1, scheduler.TimeUntilDue(), failures);
+                Check("idle: BeginFrame releases nothing", DIRTY_NONE, scheduler.BeginFrame(), failures);
+
+                for (int i = 0; i < 50; i++)
+                {
+                    scheduler.Invalidate(i % 2 ? DIRTY_GEOMETRY : DIRTY_BRIGHTNESS);
+                    clock.Advance(300);
+                }
+                Check("burst: not due before the boundary", DIRTY_NONE, scheduler.BeginFrame(), failures);
+
+                uint32_t flags = 0;
+                const int renders = Pump(clock, scheduler, &flags);
+                Check("50 updates in one interval -> 1 render", 1, renders, failures);
+                Check("render lands on the refresh grid", 0, clock.NowUs() % INTERVAL_US, failures);
+                Check("flags are merged", DIRTY_GEOMETRY | DIRTY_BRIGHTNESS, flags, failures);
+                Check("clean after the render", -1, scheduler.TimeUntilDue(), failures);
+            }
+
+            {
+                ManualClock clock(0);
+                RenderScheduler scheduler(clock, INTERVAL_US);
+                int renders = 0;
+                for (int frame = 0; frame < 3; frame++)
+                {
+                    scheduler.Invalidate(DIRTY_GEOMETRY);
+                    renders += Pump(clock, scheduler);
+                    clock.Advance(100);
+                }
+                Check("one update per interval -> 1 render each", 3, renders, failures);
+            }
+
+            {
+                // The timer fired late, well into the next slot; a change
+                // straight after must wait for the following boundary.
+                ManualClock clock(0);
+                RenderScheduler scheduler(clock, INTERVAL_US);
+                scheduler.Invalidate(DIRTY_GEOMETRY);
+                const int64_t late = INTERVAL_US + INTERVAL_US / 2;
+                clock.Set(late);
+                scheduler.BeginFrame();
+                scheduler.Invalidate(DIRTY_GEOMETRY);
+                Check("late render: next waits for the boundary", 2 * INTERVAL_US - late, scheduler.TimeUntilDue(), failures);
+            }
+
+            RecordFailures(failures);
+        }
+
+        struct Storm
+        {
+            const char* name;
+            int64_t eventIntervalUs;    // time between input events
+            int64_t durationUs;
+            int64_t refreshUs;
+        };
+
+        constexpr Storm STORMS[] = {
+            { "slider-1kHz@60", 1000, 1000000, 16667 },
+            { "slider-1kHz@144", 1000, 1000000, 6944 },
+            { "hotkey-30Hz@60", 33333, 1000000, 16667 },
+        };
+    }
+
+    void RunSchedulerSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        std::printf("\n%-16s %8s %8s %12s\n", "storm", "updates", "renders", "ns/update");
+        for (const Storm& storm : STORMS)
+        {
+            uint64_t updates = 0;
+            uint64_t renders = 0;
+            const double ns = MeasureNs(options, [&]
+            {
+                ManualClock clock(0);
+                RenderScheduler scheduler(clock, storm.refreshUs);
+                int64_t nextEvent = 0;
+                while (clock.NowUs() < storm.durationUs)
+                {
+                    // Whichever comes first: the next input event or the
+                    // pending render.
+                    const int64_t wait = scheduler.TimeUntilDue();
+                    if (wait >= 0 && clock.NowUs() + wait <= nextEvent)
+                    {
+                        clock.Advance(wait);
+                        scheduler.BeginFrame();
+                        continue;
+                    }
+                    clock.Set(nextEvent);
+                    scheduler.Invalidate(DIRTY_GEOMETRY);
+                    nextEvent += storm.eventIntervalUs;
+                }
+                updates = scheduler.Invalidations();
+                renders = scheduler.Renders();
+            });
+
+            std::printf("%-16s %8llu %8llu %12.1f\n", storm.name,
+                        static_cast<unsigned long long>(updates), static_cast<unsigned long long>(renders),
+                        updates ? ns / updates : 0.0);
+        }
+    }
+}
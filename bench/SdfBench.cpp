@@ -0,0 +1,70 @@
+// Signed-distance renderer vs. the scalar reference and the legacy
+// ring rasterizer at common monitor resolutions.
+
+#include "BenchCommon.h"
+
+#include "core/FrameRasterizer.h"
+#include "core/SdfFrameRenderer.h"
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        constexpr Resolution RESOLUTIONS[] = {
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+            { "8K", 7680, 4320 },
+        };
+
+        size_t CountMismatches(const Image& a, const Image& b)
+        {
+            size_t mismatches = 0;
+            for (size_t i = 0; i < a.pixels.size(); i++)
+                mismatches += a.pixels[i] != b.pixels[i];
+            return mismatches;
+        }
+    }
+
+    void RunSdfSuite(const Options& options)
+    {
+        using namespace EdgeLight;
+
+        std::printf("%-6s %-10s %12s %10s %10s\n", "res", "path", "ms/frame", "speedup", "mismatch");
+
+        for (const Resolution& res : RESOLUTIONS)
+        {
+            FrameParams params;
+            params.width = res.width;
+            params.height = res.height;
+
+            Image bgra(res.width, res.height, 4);
+            BgraBuffer bgraTarget = View(bgra);
+
+            const double ringsNs = MeasureNs(options, [&] { FrameRasterizer::Render(params, bgraTarget); });
+            std::printf("%-6s %-10s %12.3f %10s %10s\n", res.name, "rings", ringsNs / 1e6, "-", "-");
+
+            Image reference(res.width, res.height, 1);
+            MaskBuffer referenceTarget = MaskView(reference);
+            const double scalarNs = MeasureNs(options, [&] { SdfFrameRenderer::RenderMask(params, referenceTarget, SimdLevel::Scalar); });
+            std::printf("%-6s %-10s %12.3f %10.2f %10s\n", res.name, "sdf-scalar", scalarNs / 1e6, 1.0, "-");
+
+            for (SimdLevel level : { SimdLevel::Sse2, SimdLevel::Avx2 })
+            {
+                if (!GetSdfKernels(level))
+                    continue;
+
+                Image mask(res.width, res.height, 1);
+                MaskBuffer maskTarget = MaskView(mask);
+                const double ns = MeasureNs(options, [&] { SdfFrameRenderer::RenderMask(params, maskTarget, level); });
+
+                char name[16];
+                std::snprintf(name, sizeof(name), "sdf-%s", SimdLevelName(level));
+                std::printf("%-6s %-10s %12.3f %10.2f %10zu\n", res.name, name, ns / 1e6, scalarNs / ns,
+                            CountMismatches(reference, mask));
+            }
+
+            const double fullNs = MeasureNs(options, [&] { SdfFrameRenderer::Render(params, bgraTarget); });
+            std::printf("%-6s %-10s %12.3f %10.2f %10s\n", res.name, "sdf+bgra", fullNs / 1e6, scalarNs / fullNs, "-");
+        }
+    }
+}
@@ -0,0 +1,65 @@
+// Span-list painting vs. full-surface rendering. Reports how many pixels
+// each approach touches and checks that both produce the same image.
+
+#include "BenchCommon.h"
+
+#include "core/FrameSpans.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        constexpr Resolution RESOLUTIONS[] = {
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+            { "8K", 7680, 4320 },
+        };
+    }
+
+    void RunSpanSuite(const Options& options)
+    {
+        using namespace EdgeLight;
+
+        std::printf("%-6s %10s %10s %8s %10s %10s %10s %10s %9s\n",
+                    "res", "build-us", "spans", "rects", "touched", "full-ms", "spans-ms", "speedup", "mismatch");
+
+        for (const Resolution& res : RESOLUTIONS)
+        {
+            FrameParams params;
+            params.width = res.width;
+            params.height = res.height;
+
+            FrameSpans spans;
+            const double buildNs = MeasureNs(options, [&] { spans.Build(params); });
+
+            std::vector<SpanRect> rects;
+            spans.ToRects(rects);
+
+            Image full(res.width, res.height, 4);
+            BgraBuffer fullTarget = View(full);
+            const double fullNs = MeasureNs(options, [&] { SdfFrameRenderer::Render(params, fullTarget); });
+
+            Image partial(res.width, res.height, 4);
+            BgraBuffer partialTarget = View(partial);
+            std::fill(reinterpret_cast<uint32_t*>(partial.pixels.data()),
+                      reinterpret_cast<uint32_t*>(partial.pixels.data() + partial.pixels.size()), 0xFF000000u);
+            const double spanNs = MeasureNs(options, [&] { SdfFrameRenderer::RenderSpans(params, spans, partialTarget); });
+
+            const size_t total = static_cast<size_t>(res.width) * res.height;
+            const double touched = 100.0 * spans.PixelCount() / total;
+            const size_t mismatches = std::memcmp(full.pixels.data(), partial.pixels.data(), full.pixels.size()) == 0
+                ? 0 : std::inner_product(full.pixels.begin(), full.pixels.end(), partial.pixels.begin(), size_t(0),
+                                         std::plus<>(), std::not_equal_to<>());
+
+            std::printf("%-6s %10.1f %10zu %8zu %9.1f%% %10.3f %10.3f %10.2f %9zu\n",
+                        res.name, buildNs / 1e3, spans.SpanCount(), rects.size(), touched,
+                        fullNs / 1e6, spanNs / 1e6, fullNs / spanNs, mismatches);
+        }
+    }
+}
@@ -0,0 +1,160 @@
+// Startup: the phase timeline and the control panel's on-demand lifetime
+// against a simulated clock, then what a phase scope costs and a sample
+// report.
+
+#include "BenchCommon.h"
+
+#include "core/OnDemandLifetime.h"
+#include "core/StartupTimeline.h"
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr int64_t SECOND_US = 1000000;
+
+        // The overlay's startup sequence with made-up durations.
+        void SimulateStartup(ManualClock& clock, StartupTimeline& timeline)
+        {
+            {
+                StartupPhaseScope phase(timeline, "renderer");
+                clock.Advance(1500);
+            }
+            {
+                StartupPhaseScope phase(timeline, "monitor enumeration");
+                clock.Advance(800);
+            }
+            {
+                StartupPhaseScope phase(timeline, "window creation");
+                clock.Advance(4200);
+            }
+            {
+                StartupPhaseScope phase(timeline, "tray icon");
+                clock.Advance(2600);
+            }
+            {
+                StartupPhaseScope phase(timeline, "hotkeys");
+                clock.Advance(100);
+            }
+            clock.Advance(7000); // message loop until WM_PAINT
+            timeline.Milestone("first paint");
+        }
+
+        void RunTimelineChecks(int& failures)
+        {
+            ManualClock clock(5 * SECOND_US);
+            StartupTimeline timeline(clock);
+            SimulateStartup(clock, timeline);
+
+            const std::vector<StartupPhase>& phases = timeline.Phases();
+            Check("timeline: phases recorded", 6, static_cast<long long>(phases.size()), failures);
+            Check("timeline: starts are relative", 0, phases[0].startUs, failures);
+            Check("timeline: window creation start", 2300, phases[2].startUs, failures);
+            Check("timeline: window creation duration", 4200, phases[2].durationUs, failures);
+            Check("timeline: first paint counts from start", 16200, phases[5].durationUs, failures);
+            Check("timeline: milestone recorded once", 0, timeline.Milestone("first paint"), failures);
+            Check("timeline: has hotkeys", 1, timeline.Has("hotkeys"), failures);
+            Check("timeline: elapsed", 16200, timeline.ElapsedUs(), failures);
+
+            {
+                StartupPhaseScope outer(timeline, "outer");
+                clock.Advance(10);
+                {
+                    StartupPhaseScope inner(timeline, "inner");
+                    clock.Advance(20);
+                }
+                clock.Advance(30);
+            }
+            const size_t count = timeline.Phases().size();
+            Check("timeline: nested inner finishes first", 20, timeline.Phases()[count - 2].durationUs, failures);
+            Check("timeline: nested outer spans both", 60, timeline.Phases()[count - 1].durationUs, failures);
+
+            timeline.Record("backwards", clock.NowUs(), clock.NowUs() - 5);
+            Check("timeline: negative duration clamps", 0, timeline.Phases().back().durationUs, failures);
+
+            const std::string report = timeline.Report();
+            Check("report: lists first paint", 1, report.find("first paint") != std::string::npos, failures);
+            Check("report: has a total", 1, report.find("total") != std::string::npos, failures);
+        }
+
+        void RunLifetimeChecks(int& failures)
+        {
+            {
+                ManualClock clock(0);
+                OnDemandLifetime panel(clock, 60 * SECOND_US);
+                Check("panel: nothing at startup", 0, panel.Exists(), failures);
+                Check("panel: no release pending", -1, panel.TimeUntilRelease(), failures);
+                Check("panel: first show creates", 1, panel.Show(), failures);
+                Check("panel: second show reuses", 0, panel.Show(), failures);
+                Check("panel: visible never released", -1, panel.TimeUntilRelease(), failures);
+
+                panel.Hide();
+                clock.Advance(20 * SECOND_US);
+                Check("panel: hidden 20 s of 60", 40 * SECOND_US, panel.TimeUntilRelease(), failures);
+                Check("panel: not due early", 0, panel.ReleaseDue(), failures);
+                Check("panel: reshow before timeout reuses", 0, panel.Show(), failures);
+
+                panel.Hide();
+                clock.Advance(30 * SECOND_US);
+                Check("panel: reshow restarts the countdown", 30 * SECOND_US, panel.TimeUntilRelease(), failures);
+                clock.Advance(30 * SECOND_US);
+                Check("panel: due after timeout", 1, panel.ReleaseDue(), failures);
+                Check("panel: released once", 0, panel.ReleaseDue(), failures);
+                Check("panel: gone after release", 0, panel.Exists(), failures);
+                Check("panel: show after release recreates", 1, panel.Show(), failures);
+                Check("panel: creations", 2, static_cast<long long>(panel.Creations()), failures);
+                Check("panel: releases", 1, static_cast<long long>(panel.Releases()), failures);
+            }
+
+            {
+                ManualClock clock(0);
+                OnDemandLifetime panel(clock, 60 * SECOND_US);
+                panel.Hide();
+                Check("panel: hide before show is a no-op", -1, panel.TimeUntilRelease(), failures);
+                panel.Show();
+                panel.Hide();
+                clock.Advance(10 * SECOND_US);
+                panel.Hide();
+                Check("panel: repeated hide keeps the countdown", 50 * SECOND_US, panel.TimeUntilRelease(), failures);
+
+                panel.SetIdleTimeout(-1);
+                Check("panel: negative timeout keeps it", -1, panel.TimeUntilRelease(), failures);
+                panel.SetIdleTimeout(0);
+                Check("panel: zero timeout releases at once", 1, panel.ReleaseDue(), failures);
+
+                panel.Show();
+                panel.Lost();
+                Check("panel: lost window is recreated", 1, panel.Show(), failures);
+            }
+        }
+    }
+
+    void RunStartupSuite(const Options& options)
+    {
+        int failures = 0;
+        PrintCheckHeader();
+        RunTimelineChecks(failures);
+        RunLifetimeChecks(failures);
+        RecordFailures(failures);
+
+        // A phase scope reads the clock twice and appends one entry; a
+        // fresh timeline per batch keeps the vector from growing without
+        // bound, and 16 phases fit its initial reserve.
+        constexpr int PHASES = 16;
+        SteadyClock steady;
+        const double ns = MeasureNs(options, [&]
+        {
+            StartupTimeline timeline(steady);
+            for (int i = 0; i < PHASES; i++)
+                StartupPhaseScope phase(timeline, "phase");
+        });
+        std::printf("\n%-24s %12.1f\n", "ns/phase scope", ns / PHASES);
+
+        ManualClock clock(0);
+        StartupTimeline sample(clock);
+        SimulateStartup(clock, sample);
+        std::printf("\n%s", sample.Report().c_str());
+    }
+}
@@ -0,0 +1,238 @@
+// Edge-strip layout: every lit pixel must land in exactly one piece for
+// the whole slider range, falloffs and glows, tiny work areas must fall
+// back to fewer pieces, and each strip's own render must match its window
+// of the full frame. Then the composited area and backbuffer memory of
+// each layout.
+
+#include "BenchCommon.h"
+
+#include "core/EdgeStripLayout.h"
+#include "core/SdfFrameRenderer.h"
+
+#include <cstring>
+#include <string>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        struct CoverageErrors
+        {
+            long long uncovered = 0;    // lit pixels outside every piece
+            long long overlapping = 0;  // pixels in more than one piece
+            long long outside = 0;      // piece pixels outside the work area
+        };
+
+        void CheckCoverage(const FrameParams& params, const EdgeStripLayout& layout, CoverageErrors& errors)
+        {
+            Image mask(params.width, params.height, 1);
+            SdfFrameRenderer::RenderMask(params, MaskView(mask));
+
+            std::vector<uint8_t> hits(mask.pixels.size(), 0);
+            for (int i = 0; i < layout.count; i++)
+            {
+                const SpanRect& piece = layout.pieces[i];
+                for (int y = piece.top; y < piece.bottom; y++)
+                {
+                    for (int x = piece.left; x < piece.right; x++)
+                    {
+                        if (x < 0 || y < 0 || x >= params.width || y >= params.height)
+                        {
+                            errors.outside++;
+                            continue;
+                        }
+                        hits[static_cast<size_t>(y) * params.width + x]++;
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < hits.size(); i++)
+            {
+                errors.uncovered += mask.pixels[i] != 0 && hits[i] == 0;
+                errors.overlapping += hits[i] > 1;
+            }
+        }
+
+        // Pixels where a strip rendered on its own differs from its window
+        // of the full render
+        long long StripMismatches(const FrameParams& params, const EdgeStripLayout& layout)
+        {
+            Image full(params.width, params.height, 4);
+            SdfFrameRenderer::Render(params, View(full, true));
+
+            long long mismatches = 0;
+            for (int i = 0; i < layout.count; i++)
+            {
+                const SpanRect& piece = layout.pieces[i];
+                Image strip(piece.right - piece.left, piece.bottom - piece.top, 4);
+                SdfFrameRenderer::RenderRegion(params, piece, View(strip, true));
+                for (int y = 0; y < strip.height; y++)
+                {
+                    const uint8_t* a = strip.pixels.data() + static_cast<size_t>(y) * strip.stride;
+                    const uint8_t* b = full.pixels.data() + static_cast<size_t>(piece.top + y) * full.stride + piece.left * 4;
+                    for (int x = 0; x < strip.width; x++)
+                        mismatches += std::memcmp(a + x * 4, b + x * 4, 4) != 0;
+                }
+            }
+            return mismatches;
+        }
+
+        void RunBehaviourChecks(const Options& options)
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            const int thicknesses[] = { 20, 50, 80, 115, 150 };
+            const int radii[] = { 40, 100, 200 };
+            const int blurs[] = { 0, 2, 10 };
+            const int glows[] = { 0, 12 };
+            const Resolution sizes[] = {
+                { "800x500", 800, 500 },
+                { "333x1001", 333, 1001 },
+            };
+
+            for (EdgeStripMode mode : { EdgeStripMode::FourStrips, EdgeStripMode::EightPieces })
+            {
+                CoverageErrors errors;
+                long long layouts = 0, fallbacks = 0;
+                for (const Resolution& size : sizes)
+                {
+                    for (int thickness : thicknesses)
+                    {
+                        for (int radius : radii)
+                        {
+                            for (int blur : blurs)
+                            {
+                                for (int glow : glows)
+                                {
+                                    if (options.quick && (blur == 10 || glow > 0) && thickness != 80)
+                                        continue;
+
+                                    FrameParams params;
+                                    params.width = size.width;
+                                    params.height = size.height;
+                                    params.frameThickness = thickness;
+                                    params.cornerRadius = radius;
+                                    params.blurSize = blur;
+                                    params.glowRadius = glow;
+                                    const EdgeStripLayout layout = EdgeStripLayout::Solve(params, mode);
+                                    CheckCoverage(params, layout, errors);
+                                    layouts++;
+                                    fallbacks += layout.mode != mode;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                const std::string prefix = std::string(EdgeStripModeName(mode)) + ": ";
+                std::printf("  (%s: %lld layouts, %lld fell back)\n", EdgeStripModeName(mode), layouts, fallbacks);
+                Check((prefix + "every lit pixel covered").c_str(), 0, errors.uncovered, failures);
+                Check((prefix + "no pixel in two pieces").c_str(), 0, errors.overlapping, failures);
+                Check((prefix + "pieces inside the work area").c_str(), 0, errors.outside, failures);
+            }
+
+            FrameParams params;
+            params.width = 640;
+            params.height = 400;
+
+            FrameParams empty = params;
+            empty.width = 0;
+            Check("empty work area has no pieces", 0, EdgeStripLayout::Solve(empty, EdgeStripMode::EightPieces).count, failures);
+
+            // Strips deeper than half the work area meet: one piece
+            FrameParams tiny = params;
+            tiny.width = 150;
+            tiny.height = 100;
+            const EdgeStripLayout tinyLayout = EdgeStripLayout::Solve(tiny, EdgeStripMode::FourStrips);
+            Check("tiny work area falls back to one piece", 1, tinyLayout.count, failures);
+            Check("  which is the whole work area", 150 * 100, static_cast<long long>(tinyLayout.Area()), failures);
+            CoverageErrors tinyErrors;
+            CheckCoverage(tiny, tinyLayout, tinyErrors);
+            Check("  and covers every lit pixel", 0, tinyErrors.uncovered, failures);
+
+            // Corner squares that would meet, strips that still fit
+            FrameParams narrow = params;
+            narrow.width = 225;
+            const EdgeStripLayout narrowLayout = EdgeStripLayout::Solve(narrow, EdgeStripMode::EightPieces);
+            Check("narrow work area falls back to 4 strips", 1, narrowLayout.mode == EdgeStripMode::FourStrips, failures);
+            CoverageErrors narrowErrors;
+            CheckCoverage(narrow, narrowLayout, narrowErrors);
+            Check("  and covers every lit pixel", 0, narrowErrors.uncovered + narrowErrors.overlapping, failures);
+
+            FrameParams single = params;
+            Check("single mode is one piece", 1, EdgeStripLayout::Solve(single, EdgeStripMode::Single).count, failures);
+
+            FrameParams big = params;
+            big.width = 3840;
+            big.height = 2160;
+            const size_t bigArea = static_cast<size_t>(big.width) * big.height;
+            Check("4K strips composite under 20% of the area", 1,
+                  EdgeStripLayout::Solve(big, EdgeStripMode::FourStrips).Area() * 5 < bigArea, failures);
+
+            long long mismatches = 0;
+            FrameParams glowing = params;
+            glowing.glowRadius = 12;
+            for (const FrameParams* p : { &params, &glowing })
+            {
+                for (EdgeStripMode mode : { EdgeStripMode::FourStrips, EdgeStripMode::EightPieces })
+                    mismatches += StripMismatches(*p, EdgeStripLayout::Solve(*p, mode));
+            }
+            Check("strip renders match the full frame", 0, mismatches, failures);
+
+            RecordFailures(failures);
+        }
+    }
+
+    void RunStripSuite(const Options& options)
+    {
+        RunBehaviourChecks(options);
+
+        const Resolution resolutions[] = {
+            { "1080p", 1920, 1080 },
+            { "1440p", 2560, 1440 },
+            { "4K", 3840, 2160 },
+        };
+
+        // Default frame, thinnest and thickest slider positions
+        std::printf("\n%-6s %9s %-9s %7s %8s %10s %12s\n", "res", "thickness", "mode", "pieces", "area-%", "buffer-MB", "render-us");
+        for (const Resolution& res : resolutions)
+        {
+            for (int thickness : { 20, 80, 150 })
+            {
+                FrameParams params;
+                params.width = res.width;
+                params.height = res.height;
+                params.frameThickness = thickness;
+
+                for (EdgeStripMode mode : { EdgeStripMode::Single, EdgeStripMode::FourStrips, EdgeStripMode::EightPieces })
+                {
+                    const EdgeStripLayout layout = EdgeStripLayout::Solve(params, mode);
+                    std::vector<Image> strips;
+                    for (int i = 0; i < layout.count; i++)
+                    {
+                        const SpanRect& piece = layout.pieces[i];
+                        strips.emplace_back(piece.right - piece.left, piece.bottom - piece.top, 4);
+                    }
+
+                    const double renderNs = MeasureNs(options, [&]
+                    {
+                        for (int i = 0; i < layout.count; i++)
+                        {
+                            Image& strip = strips[i];
+                            SdfFrameRenderer::RenderRegion(params, layout.pieces[i],
+                                                           View(strip, true));
+                        }
+                    });
+
+                    const double area = static_cast<double>(layout.Area());
+                    std::printf("%-6s %9d %-9s %7d %8.1f %10.2f %12.1f\n", res.name, thickness, EdgeStripModeName(layout.mode),
+                                layout.count, 100.0 * area / (static_cast<double>(res.width) * res.height),
+                                area * 4 / (1024.0 * 1024.0), renderNs / 1e3);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,293 @@
+// Timer wheel: deadlines across every level fire on their tick and never
+// early, callbacks can re-arm and disarm, and a random workload matches a
+// plain sorted reference. Then wakeup counts over long simulated idle
+// periods, driven the way RunMessageLoop drives it (sleep for
+// TimeUntilNext, Advance on waking), next to what a periodic WM_TIMER
+// would have cost. Then what arming and advancing cost.
+
+#include "BenchCommon.h"
+
+#include "core/TimerWheel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr int64_t MS_US = 1000;
+        constexpr int64_t SECOND_US = 1000 * MS_US;
+        constexpr int64_t MINUTE_US = 60 * SECOND_US;
+        constexpr int64_t HOUR_US = 60 * MINUTE_US;
+
+        // Sleeps until the next deadline and advances, until nothing is
+        // armed or until is reached. Returns the number of wakeups.
+        long long RunUntil(ManualClock& clock, TimerWheel& wheel, int64_t until)
+        {
+            long long wakeups = 0;
+            for (;;)
+            {
+                const int64_t wait = wheel.TimeUntilNext();
+                if (wait < 0 || clock.NowUs() + wait > until)
+                    break;
+                clock.Advance(wait);
+                wakeups++;
+                wheel.Advance();
+            }
+            clock.Set(std::max(clock.NowUs(), until));
+            return wakeups;
+        }
+
+        void RunDeadlineChecks(int& failures)
+        {
+            // One timer per delay, spanning every level and past the top
+            const int64_t delays[] = {
+                0, 1, 999, MS_US, 63 * MS_US, 64 * MS_US, 65 * MS_US, 4095 * MS_US, 4096 * MS_US,
+                262143 * MS_US, 262144 * MS_US, 5 * MINUTE_US, 3 * HOUR_US, 5 * HOUR_US, 30 * HOUR_US,
+            };
+            constexpr int COUNT = sizeof(delays) / sizeof(delays[0]);
+
+            ManualClock clock(12345);
+            TimerWheel wheel(clock);
+            int64_t firedAt[COUNT];
+            for (int i = 0; i < COUNT; i++)
+            {
+                firedAt[i] = -1;
+                wheel.Add([&clock, &firedAt, i] { firedAt[i] = clock.NowUs(); });
+            }
+            const int64_t start = clock.NowUs();
+            for (int i = 0; i < COUNT; i++)
+                wheel.Arm(i, delays[i]);
+            Check("deadlines: all armed", COUNT, static_cast<long long>(wheel.ArmedCount()), failures);
+
+            const long long wakeups = RunUntil(clock, wheel, start + 40 * HOUR_US);
+
+            int early = 0;
+            int late = 0;
+            for (int i = 0; i < COUNT; i++)
+            {
+                const int64_t due = start + delays[i];
+                const int64_t tick = std::max((due + 999) / 1000, start / 1000 + 1) * 1000;
+                early += firedAt[i] < due;
+                late += firedAt[i] != tick;
+            }
+            Check("deadlines: none early", 0, early, failures);
+            Check("deadlines: each on its tick", 0, late, failures);
+            Check("deadlines: one wakeup per distinct tick", COUNT - 2, wakeups, failures);
+            Check("deadlines: nothing left armed", -1, wheel.TimeUntilNext(), failures);
+            Check("deadlines: wait forever when idle", 1, wheel.WaitTimeoutMs() == TimerWheel::WAIT_FOREVER, failures);
+        }
+
+        void RunCallbackChecks(int& failures)
+        {
+            ManualClock clock(0);
+            TimerWheel wheel(clock);
+            int aFired = 0;
+            int bFired = 0;
+            int periodic = 0;
+            TimerWheel::TimerId a = -1;
+            TimerWheel::TimerId b = -1;
+            TimerWheel::TimerId self = -1;
+            a = wheel.Add([&] { aFired++; wheel.Disarm(b); });
+            b = wheel.Add([&] { bFired++; wheel.Disarm(a); });
+            self = wheel.Add([&]
+            {
+                if (++periodic < 12)
+                    wheel.Arm(self, 16667);
+            });
+
+            wheel.Arm(a, 10 * MS_US);
+            wheel.Arm(b, 10 * MS_US);
+            wheel.Arm(self, 16667);
+            Check("callbacks: next deadline", 10 * MS_US, wheel.TimeUntilNext(), failures);
+            Check("callbacks: os wait in ms", 10, wheel.WaitTimeoutMs(), failures);
+
+            const long long wakeups = RunUntil(clock, wheel, HOUR_US);
+            Check("callbacks: one disarms the other on its tick", 1, aFired + bFired, failures);
+            Check("callbacks: self re-arming runs out", 12, periodic, failures);
+            Check("callbacks: wakeups (1 + a 200 ms fade)", 13, wakeups, failures);
+
+            // Re-arming pushes a deadline back instead of adding one
+            wheel.Arm(b, 5 * MS_US);
+            wheel.Arm(b, 50 * MS_US);
+            Check("rearm: replaces the deadline", 50 * MS_US, wheel.TimeUntilNext(), failures);
+            Check("rearm: still one armed", 1, static_cast<long long>(wheel.ArmedCount()), failures);
+            wheel.Disarm(b);
+            Check("disarm: nothing pending", -1, wheel.TimeUntilNext(), failures);
+
+            const double allocations = AllocationsPerCall([&]
+            {
+                wheel.Arm(a, 3 * MS_US);
+                clock.Advance(3 * MS_US);
+                wheel.Advance();
+            });
+            Check("arm + advance: allocations", 0, std::lround(allocations), failures);
+        }
+
+        // Random arms, re-arms and disarms against a map of deadlines
+        void RunReferenceChecks(int& failures)
+        {
+            constexpr int TIMERS = 64;
+            ManualClock clock(777);
+            TimerWheel wheel(clock);
+            std::map<int, int64_t> expected;     // id -> due tick
+            std::vector<int> firedNow;
+            for (int i = 0; i < TIMERS; i++)
+                wheel.Add([&firedNow, i] { firedNow.push_back(i); });
+
+            uint32_t seed = 1;
+            auto next = [&seed](uint32_t range)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                return (seed >> 8) % range;
+            };
+
+            int wrong = 0;
+            int fired = 0;
+            for (int step = 0; step < 20000; step++)
+            {
+                const int id = static_cast<int>(next(TIMERS));
+                if (next(4) == 0)
+                {
+                    wheel.Disarm(id);
+                    expected.erase(id);
+                }
+                else
+                {
+                    // Mostly short, sometimes minutes or hours out
+                    const uint32_t kind = next(16);
+                    const int64_t delay = kind < 12 ? next(100000) : kind < 15 ? next(600) * SECOND_US : next(10) * HOUR_US;
+                    wheel.Arm(id, delay);
+                    const int64_t due = clock.NowUs() + delay;
+                    expected[id] = std::max((due + 999) / 1000, clock.NowUs() / 1000 + 1);
+                }
+
+                // Advance by a random amount, as a late wakeup would
+                clock.Advance(next(3) == 0 ? next(50000) : next(2000) * MS_US);
+                firedNow.clear();
+                wheel.Advance();
+                fired += static_cast<int>(firedNow.size());
+
+                const int64_t nowTick = clock.NowUs() / 1000;
+                std::vector<int> due;
+                for (auto it = expected.begin(); it != expected.end();)
+                {
+                    if (it->second <= nowTick)
+                    {
+                        due.push_back(it->first);
+                        it = expected.erase(it);
+                    }
+                    else
+                        ++it;
+                }
+                std::sort(firedNow.begin(), firedNow.end());
+                wrong += firedNow != due;
+                wrong += wheel.ArmedCount() != expected.size();
+            }
+            Check("reference: same timers fire on each advance", 0, wrong, failures);
+            Check("reference: something fired", 1, fired > 1000, failures);
+        }
+
+        // The overlay's timers after the last change: the render throttle,
+        // the panel's release a minute later, the idle trim after five
+        struct IdleSession
+        {
+            ManualClock clock;
+            TimerWheel wheel;
+            TimerWheel::TimerId render;
+            TimerWheel::TimerId panel;
+            TimerWheel::TimerId memory;
+
+            IdleSession() : clock(0), wheel(clock)
+            {
+                render = wheel.Add([] {});
+                panel = wheel.Add([] {});
+                memory = wheel.Add([] {});
+            }
+
+            void Change()
+            {
+                wheel.Arm(render, 16667);
+                wheel.Arm(panel, MINUTE_US);
+                wheel.Arm(memory, 5 * MINUTE_US);
+            }
+        };
+
+        void RunIdleChecks(int& failures)
+        {
+            {
+                IdleSession session;
+                Check("idle: nothing armed, an hour", 0, RunUntil(session.clock, session.wheel, HOUR_US), failures);
+            }
+            {
+                IdleSession session;
+                session.Change();
+                Check("idle: one change then an hour", 3, RunUntil(session.clock, session.wheel, HOUR_US), failures);
+            }
+            {
+                // A slider drag: sixty changes a second for two seconds
+                IdleSession session;
+                long long wakeups = 0;
+                for (int i = 0; i < 120; i++)
+                {
+                    session.Change();
+                    wakeups += RunUntil(session.clock, session.wheel, session.clock.NowUs() + 17 * MS_US);
+                }
+                wakeups += RunUntil(session.clock, session.wheel, 24 * HOUR_US);
+                Check("idle: drag then a day", 122, wakeups, failures);
+                Check("idle: cascades stay bounded", 1, session.wheel.Stats().cascaded < 1000, failures);
+            }
+        }
+    }
+
+    void RunTimerSuite(const Options& options)
+    {
+        int failures = 0;
+        PrintCheckHeader();
+        RunDeadlineChecks(failures);
+        RunCallbackChecks(failures);
+        RunReferenceChecks(failures);
+        RunIdleChecks(failures);
+        RecordFailures(failures);
+
+        // Wakeups per idle hour against a 16 ms WM_TIMER left running
+        {
+            IdleSession session;
+            session.Change();
+            const long long wheelWakeups = RunUntil(session.clock, session.wheel, HOUR_US);
+            std::printf("\n%-32s %12s\n", "idle hour after one change", "wakeups");
+            std::printf("%-32s %12lld\n", "timer wheel", wheelWakeups);
+            std::printf("%-32s %12lld\n", "periodic 16 ms WM_TIMER", static_cast<long long>(HOUR_US / 16 / MS_US));
+        }
+
+        // Arming and advancing with a few hundred timers spread over all
+        // levels
+        ManualClock clock(0);
+        TimerWheel wheel(clock);
+        constexpr int TIMERS = 256;
+        for (int i = 0; i < TIMERS; i++)
+        {
+            wheel.Add([] {});
+            wheel.Arm(i, (static_cast<int64_t>(i) * 7919 % 100000) * MS_US);
+        }
+        int id = 0;
+        const double armNs = MeasureNs(options, [&]
+        {
+            wheel.Arm(id, (static_cast<int64_t>(id) * 7919 % 100000) * MS_US);
+            id = (id + 1) % TIMERS;
+        });
+        const double nextNs = MeasureNs(options, [&] { volatile int64_t wait = wheel.TimeUntilNext(); (void)wait; });
+        const double advanceNs = MeasureNs(options, [&]
+        {
+            clock.Advance(MS_US);
+            wheel.Advance();
+        });
+        std::printf("\n%-24s %12.1f\n", "ns/Arm", armNs);
+        std::printf("%-24s %12.1f\n", "ns/TimeUntilNext", nextNs);
+        std::printf("%-24s %12.1f\n", "ns/Advance (1 ms)", advanceNs);
+    }
+}
@@ -0,0 +1,109 @@
+// Monitor topology diffing: synthetic hot-plug, dock/undock and resolution
+// changes, then the cost of a diff as the number of displays grows.
+
+#include "BenchCommon.h"
+
+#include "core/MonitorTopology.h"
+
+#include <algorithm>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        MonitorDesc Monitor(uint64_t id, int left, int width, int height, int dpi = 96)
+        {
+            MonitorDesc monitor;
+            monitor.id = id;
+            monitor.left = left;
+            monitor.top = 0;
+            monitor.right = left + width;
+            monitor.bottom = height;
+            monitor.dpi = dpi;
+            return monitor;
+        }
+
+        // count monitors side by side, 1080p with the odd 4K panel
+        std::vector<MonitorDesc> Row(int count)
+        {
+            std::vector<MonitorDesc> monitors;
+            int x = 0;
+            for (int i = 0; i < count; i++)
+            {
+                const bool uhd = i % 3 == 2;
+                monitors.push_back(Monitor(1000 + i, x, uhd ? 3840 : 1920, uhd ? 2112 : 1032));
+                x += uhd ? 3840 : 1920;
+            }
+            return monitors;
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            MonitorTopology topology;
+            TopologyDiff diff = topology.Update(Row(3));
+            Check("first snapshot: all added", 3, diff.added.size(), failures);
+
+            std::vector<MonitorDesc> shuffled = Row(3);
+            std::reverse(shuffled.begin(), shuffled.end());
+            diff = topology.Update(shuffled);
+            Check("enumeration order is ignored", 1, diff.Empty(), failures);
+            Check("unchanged counted", 3, diff.unchanged, failures);
+
+            // Dock: a fourth screen appears at the right
+            diff = topology.Update(Row(4));
+            Check("hot-plug: one added", 1, diff.added.size(), failures);
+            Check("hot-plug: others untouched", 3, diff.unchanged, failures);
+
+            // Undock: the middle screen goes away, the right one slides left
+            std::vector<MonitorDesc> undocked = { Row(4)[0], Row(4)[2], Row(4)[3] };
+            undocked[1].left -= 1920;
+            undocked[1].right -= 1920;
+            undocked[2].left -= 1920;
+            undocked[2].right -= 1920;
+            diff = topology.Update(undocked);
+            Check("undock: one removed", 1, diff.removed.size(), failures);
+            Check("undock: the middle one is removed", 1001, diff.removed.empty() ? 0 : diff.removed[0].id, failures);
+            Check("undock: shifted screens only move", 2, diff.moved.size(), failures);
+            Check("undock: nothing re-rendered", 0, diff.resized.size(), failures);
+
+            // Taskbar moved, resolution or scale changed
+            std::vector<MonitorDesc> changed = undocked;
+            changed[0].bottom -= 40;
+            changed[1].dpi = 144;
+            diff = topology.Update(changed);
+            Check("work area and DPI changes resize", 2, diff.resized.size(), failures);
+            Check("lookup by id", 144, topology.Find(changed[1].id) ? topology.Find(changed[1].id)->dpi : 0, failures);
+
+            diff = topology.Update(Row(40));
+            Check("no monitor cap: 40 displays", 40, topology.Monitors().size(), failures);
+            Check("37 new of 40", 37, diff.added.size(), failures);
+
+            RecordFailures(failures);
+        }
+    }
+
+    void RunTopologySuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        std::printf("\n%8s %12s %12s\n", "monitors", "same-us", "resize1-us");
+        for (int count : { 1, 2, 4, 8, 16, 64, 256, 1024 })
+        {
+            const std::vector<MonitorDesc> before = Row(count);
+            std::vector<MonitorDesc> after = before;
+            after[count / 2].bottom -= 40;
+
+            size_t sink = 0;
+            const double sameNs = MeasureNs(options, [&] { sink += MonitorTopology::Diff(before, before).unchanged; });
+            const double resizeNs = MeasureNs(options, [&] { sink += MonitorTopology::Diff(before, after).resized.size(); });
+            std::printf("%8d %12.2f %12.2f\n", count, sameNs / 1e3, resizeNs / 1e3);
+            if (sink == 0)
+                std::printf("unexpected empty diff\n");
+        }
+    }
+}
@@ -0,0 +1,181 @@
+// Trace rings: concurrent writers with a reader snapshotting while they
+// run, ring reuse across threads, the Chrome trace export, and the cost of
+// a traced scope with tracing off and on.
+
+#include "BenchCommon.h"
+
+#include "core/Tracer.h"
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <thread>
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr int WRITERS = 4;
+        constexpr int SCOPES_PER_WRITER = 20000;
+        const char* const SCOPE_NAME = "bench.scope";
+
+        // Events that could not have been written: unknown names, time
+        // going backwards within a thread, or two Begins (or Ends) in a row.
+        long long Inconsistencies(const std::vector<TraceEvent>& events)
+        {
+            long long bad = 0;
+            std::map<uint32_t, const TraceEvent*> last;
+            for (const TraceEvent& event : events)
+            {
+                if (event.name != SCOPE_NAME)
+                    continue;
+
+                const TraceEvent*& previous = last[event.threadId];
+                if (previous && (event.timestampNs < previous->timestampNs || event.phase == previous->phase))
+                    bad++;
+                previous = &event;
+            }
+            return bad;
+        }
+
+        std::map<uint32_t, size_t> EventsPerThread(const std::vector<TraceEvent>& events)
+        {
+            std::map<uint32_t, size_t> counts;
+            for (const TraceEvent& event : events)
+            {
+                if (event.name == SCOPE_NAME)
+                    counts[event.threadId]++;
+            }
+            return counts;
+        }
+
+        size_t Occurrences(const std::string& text, const char* needle)
+        {
+            size_t count = 0;
+            for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1))
+                count++;
+            return count;
+        }
+
+        // Writers all hold their ring before any of them starts writing,
+        // so none can exit early and hand its ring to the next one.
+        // leaveOpen ends every writer inside one more Begin, which shifts
+        // the ring window so it starts on an End.
+        void RunWriters(bool leaveOpen = false)
+        {
+            std::atomic<int> ready{ 0 };
+            std::vector<std::thread> writers;
+            for (int w = 0; w < WRITERS; w++)
+            {
+                writers.emplace_back([&ready, leaveOpen]
+                {
+                    Tracer::Instance().SetThreadName("bench writer");
+                    ready.fetch_add(1);
+                    while (ready.load() < WRITERS)
+                        std::this_thread::yield();
+
+                    for (int i = 0; i < SCOPES_PER_WRITER; i++)
+                        TraceScope scope(SCOPE_NAME);
+                    if (leaveOpen)
+                        Tracer::Instance().Record(SCOPE_NAME, TracePhase::Begin);
+                });
+            }
+            for (std::thread& writer : writers)
+                writer.join();
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            Tracer& tracer = Tracer::Instance();
+            tracer.SetEnabled(false);
+            tracer.Clear();
+            {
+                TraceScope scope(SCOPE_NAME);
+            }
+            Check("nothing recorded while disabled", 0, static_cast<long long>(tracer.Snapshot().size()), failures);
+
+            tracer.SetEnabled(true);
+            const size_t ringsBefore = tracer.Stats().threads;
+
+            // A reader snapshots continuously while the writers run
+            std::atomic<bool> writing{ true };
+            long long torn = 0, snapshots = 0;
+            std::thread reader([&]
+            {
+                while (writing.load())
+                {
+                    torn += Inconsistencies(tracer.Snapshot());
+                    snapshots++;
+                }
+            });
+            RunWriters();
+            writing.store(false);
+            reader.join();
+            std::printf("  (%lld snapshots taken during the writes)\n", snapshots);
+            Check("concurrent snapshots are consistent", 0, torn, failures);
+
+            const std::vector<TraceEvent> events = tracer.Snapshot();
+            const std::map<uint32_t, size_t> perThread = EventsPerThread(events);
+            long long fullRings = 0;
+            for (const auto& entry : perThread)
+                fullRings += entry.second == Tracer::RING_CAPACITY;
+            Check("writer threads seen", WRITERS, static_cast<long long>(perThread.size()), failures);
+            Check("each ring holds its newest events", WRITERS, fullRings, failures);
+            Check("final snapshot is consistent", 0, Inconsistencies(events), failures);
+
+            // Only the writer rings and the reader's are new (the reader
+            // never records, so it does not get one)
+            const TraceStats stats = tracer.Stats();
+            Check("one ring per writer thread", static_cast<long long>(ringsBefore + WRITERS), static_cast<long long>(stats.threads), failures);
+            Check("overwritten events counted", static_cast<long long>(WRITERS) * (2 * SCOPES_PER_WRITER - Tracer::RING_CAPACITY),
+                  static_cast<long long>(stats.dropped), failures);
+
+            tracer.Clear();
+            RunWriters(true);
+            Check("exited threads' rings are reused", static_cast<long long>(stats.threads),
+                  static_cast<long long>(tracer.Stats().threads), failures);
+
+            // Wrapped rings start with orphaned Ends; the export drops them
+            const std::string json = ToChromeTraceJson(tracer.Snapshot(), tracer.Threads());
+            const size_t begins = Occurrences(json, "\"ph\":\"B\"");
+            const size_t ends = Occurrences(json, "\"ph\":\"E\"");
+            Check("export has every Begin", static_cast<long long>(WRITERS) * Tracer::RING_CAPACITY / 2, static_cast<long long>(begins), failures);
+            Check("export has no orphaned End", static_cast<long long>(begins - WRITERS), static_cast<long long>(ends), failures);
+            Check("export names the writer threads", WRITERS, static_cast<long long>(Occurrences(json, "\"name\":\"bench writer\"")), failures);
+            Check("export braces balance", static_cast<long long>(Occurrences(json, "{")), static_cast<long long>(Occurrences(json, "}")), failures);
+
+            tracer.SetEnabled(false);
+            tracer.Clear();
+            RecordFailures(failures);
+        }
+    }
+
+    void RunTraceSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        Tracer& tracer = Tracer::Instance();
+        const auto scope = [] { TraceScope scope(SCOPE_NAME); };
+        const auto thousandScopes = [&]
+        {
+            for (int i = 0; i < 1000; i++)
+                scope();
+        };
+
+        tracer.SetEnabled(false);
+        const double offNs = MeasureNs(options, thousandScopes) / 1000;
+        tracer.SetEnabled(true);
+        const double onNs = MeasureNs(options, thousandScopes) / 1000;
+        tracer.SetEnabled(false);
+        tracer.Clear();
+
+        std::printf("\n%-24s %10s\n", "scope", "ns");
+        std::printf("%-24s %10.2f\n", "tracing off", offNs);
+        std::printf("%-24s %10.2f\n", "tracing on", onNs);
+    }
+}
@@ -0,0 +1,164 @@
+// Transitions: easing and lifetime checks on a simulated clock, then the
+// per-frame cost of a fade done as constant-alpha presents of one cached
+// frame versus re-rendering the frame for every step.
+
+#include "BenchCommon.h"
+
+#include "core/FramePresenter.h"
+#include "core/SdfFrameRenderer.h"
+#include "core/TransitionEngine.h"
+
+namespace EdgeLightBench
+{
+    namespace
+    {
+        using namespace EdgeLight;
+
+        constexpr int64_t FRAME_US = 16667;
+
+        // Samples on every frame tick until the engine stops, like the
+        // overlay's transition timer; returns the number of ticks.
+        int RunToEnd(ManualClock& clock, TransitionEngine& engine, TransitionState& last)
+        {
+            int ticks = 0;
+            while (engine.IsRunning())
+            {
+                clock.Advance(FRAME_US);
+                last = engine.Sample();
+                ticks++;
+            }
+            return ticks;
+        }
+
+        void RunBehaviourChecks()
+        {
+            int failures = 0;
+            PrintCheckHeader();
+
+            bool monotonic = true;
+            for (Easing easing : { Easing::Linear, Easing::EaseIn, Easing::EaseOut, Easing::EaseInOut })
+            {
+                float previous = Ease(easing, 0.0f);
+                for (int i = 1; i <= 100; i++)
+                {
+                    const float v = Ease(easing, i / 100.0f);
+                    monotonic = monotonic && v >= previous;
+                    previous = v;
+                }
+                monotonic = monotonic && Ease(easing, 0.0f) == 0.0f && Ease(easing, 1.0f) == 1.0f;
+            }
+            CheckNear("easings monotonic, exact end points", 1, monotonic, failures);
+
+            ManualClock clock(5000);
+            TransitionEngine engine(clock);
+            TransitionState on;
+            on.opacity = 1.0f;
+            on.thickness = 80.0f;
+            TransitionState off = on;
+            off.opacity = 0.0f;
+
+            engine.Reset(on);
+            CheckNear("reset: not running", 0, engine.IsRunning(), failures);
+
+            engine.Start(off, 200000, Easing::Linear);
+            CheckNear("start: value unchanged at t=0", 1.0, engine.Sample().opacity, failures);
+            clock.Advance(50000);
+            CheckNear("linear quarter way", 0.75, engine.Sample().opacity, failures);
+
+            TransitionState last;
+            const int ticks = RunToEnd(clock, engine, last);
+            CheckNear("200 ms fade at 60 Hz: ticks", 9, ticks, failures);
+            CheckNear("ends exactly on target", 0.0, last.opacity, failures);
+            CheckNear("stopped after the duration", 0, engine.IsRunning(), failures);
+            CheckNear("untouched fields stay put", 80.0, last.thickness, failures);
+
+            // Reverse half way: no jump, and the full distance is not replayed
+            engine.Start(on, 200000, Easing::EaseInOut);
+            clock.Advance(100000);
+            const float halfway = engine.Sample().opacity;
+            engine.Start(off, 200000, Easing::EaseInOut);
+            CheckNear("retarget continues from current", halfway, engine.Sample().opacity, failures);
+
+            engine.Start(on, 0);
+            CheckNear("zero duration jumps", 1.0, engine.Sample().opacity, failures);
+            CheckNear("zero duration never runs", 0, engine.IsRunning(), failures);
+
+            TransitionState moved = on;
+            moved.offsetX = 1920.0f;
+            engine.Start(moved, 200000, Easing::EaseOut);
+            RunToEnd(clock, engine, last);
+            CheckNear("position reaches target", 1920.0, last.offsetX, failures);
+
+            RecordFailures(failures);
+        }
+
+        constexpr Resolution RESOLUTIONS[] = {
+            { "1080p", 1920, 1080 },
+            { "4K", 3840, 2160 },
+        };
+    }
+
+    void RunTransitionSuite(const Options& options)
+    {
+        RunBehaviourChecks();
+
+        // A 200 ms fade at 60 Hz is 12 frames; compare what each frame costs.
+        std::printf("\n%-6s %6s %14s %14s %12s\n", "res", "frames", "rerender-ms", "present-ms", "sample-ns");
+        for (const Resolution& res : RESOLUTIONS)
+        {
+            FrameParams params;
+            params.width = res.width;
+            params.height = res.height;
+
+            Image cached(res.width, res.height, 4);
+            const BgraBuffer cachedBuffer = View(cached);
+            SdfFrameRenderer::Render(params, cachedBuffer);
+            Image target(res.width, res.height, 4);
+            const BgraBuffer targetBuffer = View(target);
+
+            const int frames = static_cast<int>(TransitionEngine::DEFAULT_DURATION_US / FRAME_US);
+            TransitionState visible;
+            TransitionState hidden;
+            hidden.opacity = 0.0f;
+
+            const double rerenderNs = MeasureNs(options, [&]
+            {
+                ManualClock clock;
+                TransitionEngine engine(clock);
+                engine.Start(hidden);
+                for (int i = 0; i < frames; i++)
+                {
+                    clock.Advance(FRAME_US);
+                    FrameParams step = params;
+                    step.opacity = static_cast<int>(engine.Sample().opacity * 255.0f + 0.5f);
+                    SdfFrameRenderer::Render(step, targetBuffer);
+                }
+            });
+
+            const double presentNs = MeasureNs(options, [&]
+            {
+                ManualClock clock;
+                TransitionEngine engine(clock);
+                engine.Start(hidden);
+                for (int i = 0; i < frames; i++)
+                {
+                    clock.Advance(FRAME_US);
+                    FramePresenter::PresentWithAlpha(cachedBuffer, targetBuffer,
+                                                     static_cast<int>(engine.Sample().opacity * 255.0f + 0.5f));
+                }
+            });
+
+            ManualClock clock;
+            TransitionEngine engine(clock);
+            engine.Start(visible);
+            const double sampleNs = MeasureNs(options, [&]
+            {
+                clock.Advance(1);
+                engine.Sample();
+            });
+
+            std::printf("%-6s %6d %14.3f %14.3f %12.1f\n", res.name, frames,
+                        rerenderNs / 1e6 / frames, presentNs / 1e6 / frames, sampleNs);
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#include "AutoBrightness.h"
+
+#include "SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        void AddBand(SpanRect bands[4], int& count, int left, int top, int right, int bottom)
+        {
+            if (right > left && bottom > top)
+                bands[count++] = { left, top, right, bottom };
+        }
+    }
+
+    double LuminanceSum::Mean() const
+    {
+        if (pixels == 0)
+            return -1.0;
+        return static_cast<double>(weighted) / (256.0 * static_cast<double>(pixels));
+    }
+
+    LuminanceSum SampleLuminance(const BgraBuffer& image, const SpanRect& rect, int step, SimdLevel level)
+    {
+        LuminanceSum sum;
+        step = std::max(step, 1);
+        const int x0 = std::max(rect.left, 0);
+        const int x1 = std::min(rect.right, image.width);
+        const int y0 = std::max(rect.top, 0);
+        const int y1 = std::min(rect.bottom, image.height);
+        if (!image.pixels || x1 <= x0 || y1 <= y0)
+            return sum;
+
+        const SdfKernels* kernels = GetSdfKernels(level);
+        const LumaRowFn luma = (kernels ? kernels : GetSdfKernels(SimdLevel::Scalar))->lumaRow;
+        const int count = (x1 - x0 + step - 1) / step;
+        for (int y = y0; y < y1; y += step)
+        {
+            const uint32_t* row = reinterpret_cast<const uint32_t*>(image.pixels + static_cast<size_t>(y) * image.stride);
+            sum.weighted += luma(row + x0, count, step);
+            sum.pixels += count;
+        }
+        return sum;
+    }
+
+    int LuminanceBands(const FrameParams& params, bool underFrame, SpanRect bands[4])
+    {
+        const int width = params.width;
+        const int height = params.height;
+        const int depth = params.frameThickness;
+        if (width <= 0 || height <= 0 || depth <= 0)
+            return 0;
+
+        const int edge = underFrame
+            ? params.inset
+            : static_cast<int>(std::ceil(params.inset + params.frameThickness + SdfFrameRenderer::LitReach(params)));
+        const int inner = edge + depth;
+
+        int count = 0;
+        if (2 * inner > width || 2 * inner > height)
+            return count;
+
+        AddBand(bands, count, edge, edge, width - edge, inner);
+        AddBand(bands, count, edge, height - inner, width - edge, height - edge);
+        AddBand(bands, count, edge, inner, inner, height - inner);
+        AddBand(bands, count, width - inner, inner, width - edge, height - inner);
+        return count;
+    }
+
+    AutoBrightness::AutoBrightness(const Clock& clock, const AutoBrightnessSettings& settings) :
+        clock(clock),
+        settings(settings)
+    {
+    }
+
+    void AutoBrightness::SetEnabled(bool enable)
+    {
+        if (enable == enabled)
+            return;
+
+        enabled = enable;
+        sampled = false;
+        smoothed = -1.0;
+        anchor = -1.0;
+        opacity = -1;
+    }
+
+    int64_t AutoBrightness::TimeUntilSample() const
+    {
+        if (!enabled)
+            return -1;
+        if (!sampled)
+            return 0;
+        return std::max<int64_t>(lastSampleAt + settings.intervalUs - clock.NowUs(), 0);
+    }
+
+    bool AutoBrightness::Feed(double luma)
+    {
+        const int64_t now = clock.NowUs();
+        const int64_t elapsed = sampled ? std::max<int64_t>(now - lastSampleAt, 0) : 0;
+        sampled = true;
+        lastSampleAt = now;
+        stats.samples++;
+        if (luma < 0.0)
+            return false;
+
+        luma = std::min(luma, 255.0);
+        if (smoothed < 0.0)
+        {
+            smoothed = luma;
+        }
+        else
+        {
+            // Exponential smoothing that does not depend on how regular
+            // the captures were
+            const double weight = settings.smoothingUs > 0
+                ? 1.0 - std::exp(-static_cast<double>(elapsed) / static_cast<double>(settings.smoothingUs))
+                : 1.0;
+            smoothed += (luma - smoothed) * weight;
+        }
+
+        if (anchor >= 0.0 && std::abs(smoothed - anchor) < settings.hysteresis)
+            return false;
+
+        anchor = smoothed;
+        const int next = OpacityFor(anchor);
+        if (next == opacity)
+            return false;
+
+        opacity = next;
+        stats.changes++;
+        return true;
+    }
+
+    int AutoBrightness::OpacityFor(double luma) const
+    {
+        const double t = std::clamp(luma / 255.0, 0.0, 1.0);
+        return static_cast<int>(std::lround(settings.darkOpacity + (settings.brightOpacity - settings.darkOpacity) * t));
+    }
+}
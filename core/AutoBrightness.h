@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Clock.h"
+#include "FrameSpans.h"
+#include "FrameTypes.h"
+#include "SdfKernels.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // Luma of a set of sampled pixels, kept as a sum so samples of several
+    // strips and monitors add up before the mean is taken.
+    struct LuminanceSum
+    {
+        uint64_t weighted = 0;  // sum of 256 x Rec. 709 luma
+        size_t pixels = 0;
+
+        void Add(const LuminanceSum& other)
+        {
+            weighted += other.weighted;
+            pixels += other.pixels;
+        }
+
+        // 0 (black) .. 255 (white); -1 when nothing was sampled.
+        double Mean() const;
+    };
+
+    // Luma of every step-th pixel of every step-th row of image inside rect
+    // (clipped to image). Alpha is ignored, so this reads a screen capture
+    // as it is.
+    LuminanceSum SampleLuminance(const BgraBuffer& image, const SpanRect& rect, int step,
+                                 SimdLevel level = DetectSimdLevel());
+
+    // Where the screen is sampled for params' frame, in work-area
+    // coordinates: the four sides of the frame band itself when our own
+    // windows are kept out of the capture (underFrame), otherwise bands of
+    // the same depth just past the light's reach, so the light never reads
+    // itself. Returns how many of bands were filled (at most 4).
+    int LuminanceBands(const FrameParams& params, bool underFrame, SpanRect bands[4]);
+
+    struct AutoBrightnessSettings
+    {
+        int64_t intervalUs = 500000;        // at most two captures a second
+        int64_t smoothingUs = 3000000;      // time constant of the smoothing
+        double hysteresis = 12.0;           // luma change the light ignores
+        int darkOpacity = 255;              // opacity over black content
+        int brightOpacity = 51;             // opacity over white content
+    };
+
+    struct AutoBrightnessStats
+    {
+        uint64_t samples = 0;       // captures fed, empty ones included
+        uint64_t changes = 0;       // opacity updates handed out
+    };
+
+    // Turns screen luminance into an opacity for the light: dark content
+    // gets a bright light and bright content a dim one. Samples are
+    // smoothed exponentially over time, and the opacity only follows once
+    // the smoothed luma has left a dead band around the value it was last
+    // set from, so flickering content or a blinking cursor does not make
+    // the light pump.
+    //
+    // Like RenderScheduler this owns no timer and captures nothing: the
+    // owner arms its timer from TimeUntilSample, captures the screen and
+    // feeds the result.
+    class AutoBrightness
+    {
+    public:
+        explicit AutoBrightness(const Clock& clock, const AutoBrightnessSettings& settings = {});
+
+        // Enabling starts over: the next sample is due at once and is
+        // taken as it is.
+        void SetEnabled(bool enabled);
+        bool Enabled() const { return enabled; }
+
+        const AutoBrightnessSettings& Settings() const { return settings; }
+
+        // Microseconds until the next capture is due: -1 when disabled, 0
+        // when it is due now. Captures are never closer than intervalUs.
+        int64_t TimeUntilSample() const;
+
+        // Feeds the mean luma of a capture (< 0 when nothing could be
+        // sampled, which only restarts the interval). Returns true when
+        // Opacity changed.
+        bool Feed(double luma);
+
+        // Opacity for the light; -1 before the first sample.
+        int Opacity() const { return opacity; }
+
+        // Smoothed luma, -1 before the first sample.
+        double Smoothed() const { return smoothed; }
+
+        const AutoBrightnessStats& Stats() const { return stats; }
+
+    private:
+        int OpacityFor(double luma) const;
+
+        const Clock& clock;
+        AutoBrightnessSettings settings;
+        bool enabled = false;
+        bool sampled = false;       // lastSampleAt is valid
+        int64_t lastSampleAt = 0;
+        double smoothed = -1.0;
+        double anchor = -1.0;       // smoothed luma the opacity was set from
+        int opacity = -1;
+        AutoBrightnessStats stats;
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // Monotonic time source in microseconds. Schedulers take one by
+    // reference so they can be driven by a simulated clock off Windows.
+    class Clock
+    {
+    public:
+        virtual ~Clock() = default;
+        virtual int64_t NowUs() const = 0;
+    };
+
+    class SteadyClock : public Clock
+    {
+    public:
+        int64_t NowUs() const override
+        {
+            using namespace std::chrono;
+            return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+        }
+    };
+
+    // Only moves when told to.
+    class ManualClock : public Clock
+    {
+    public:
+        explicit ManualClock(int64_t startUs = 0) : now(startUs) {}
+
+        int64_t NowUs() const override { return now; }
+        void Advance(int64_t us) { now += us; }
+        void Set(int64_t us) { now = us; }
+
+    private:
+        int64_t now;
+    };
+}
@@ -0,0 +1,215 @@
+#include "ColorLut.h"
+
+#include "FrameSpans.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        struct Rgb
+        {
+            double red;
+            double green;
+            double blue;
+        };
+
+        int ClampKelvin(int kelvin)
+        {
+            return std::clamp(kelvin, ColorSettings::MIN_KELVIN, ColorSettings::MAX_KELVIN);
+        }
+
+        // Linear sRGB of the Planckian locus at kelvin, luminance 1. The
+        // chromaticity is the cubic spline fit of Kim et al. (valid 1667 K
+        // to 25000 K); XYZ to linear sRGB is the standard D65 matrix.
+        Rgb PlanckianRgb(int kelvin)
+        {
+            const double t = kelvin;
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+
+            const double x = kelvin <= 4000
+                ? -0.2661239e9 / t3 - 0.2343589e6 / t2 + 0.8776956e3 / t + 0.179910
+                : -3.0258469e9 / t3 + 2.1070379e6 / t2 + 0.2226347e3 / t + 0.240390;
+            const double x2 = x * x;
+            const double x3 = x2 * x;
+
+            double y;
+            if (kelvin <= 2222)
+                y = -1.1063814 * x3 - 1.34811020 * x2 + 2.18555832 * x - 0.20219683;
+            else if (kelvin <= 4000)
+                y = -0.9549476 * x3 - 1.37418593 * x2 + 2.09137015 * x - 0.16748867;
+            else
+                y = 3.0817580 * x3 - 5.87338670 * x2 + 3.75112997 * x - 0.37001483;
+
+            const double X = x / y;
+            const double Y = 1.0;
+            const double Z = (1.0 - x - y) / y;
+
+            return {
+                std::max(3.2404542 * X - 1.5371385 * Y - 0.4985314 * Z, 0.0),
+                std::max(-0.9692660 * X + 1.8760108 * Y + 0.0415560 * Z, 0.0),
+                std::max(0.0556434 * X - 0.2040259 * Y + 1.0572252 * Z, 0.0),
+            };
+        }
+
+        double SrgbToLinear(double v)
+        {
+            return v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4);
+        }
+
+        double LinearToSrgb(double v)
+        {
+            v = std::clamp(v, 0.0, 1.0);
+            return v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+        }
+
+        uint8_t ToByte(double v)
+        {
+            return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0, 255.0)));
+        }
+
+        // Grey level through the gain in linear light
+        uint8_t OpaqueEntry(int level, double gain)
+        {
+            if (gain == 1.0)
+                return static_cast<uint8_t>(level);
+            return ToByte(255.0 * LinearToSrgb(SrgbToLinear(level / 255.0) * gain));
+        }
+
+        void ApplyRows(const ColorLut& lut, const BgraBuffer& target, int x0, int x1, int y0, int y1, SimdLevel level)
+        {
+            const SdfKernels* kernels = GetSdfKernels(level);
+            const ColorizeRowFn colorize = (kernels ? kernels : GetSdfKernels(SimdLevel::Scalar))->colorizeRow;
+            const int shift = lut.IndexShift();
+            for (int y = y0; y < y1; y++)
+            {
+                uint32_t* row = reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+                colorize(row + x0, x1 - x0, lut.packed, shift);
+            }
+        }
+    }
+
+    bool ColorSettings::IsNeutral() const
+    {
+        return ClampKelvin(kelvin) == NEUTRAL_KELVIN && std::clamp(tint, -100, 100) == 0 &&
+            std::clamp(brightness, 0, 255) == 255;
+    }
+
+    uint32_t ColorSettings::Key() const
+    {
+        if (IsNeutral())
+            return 0;
+        return (static_cast<uint32_t>(ClampKelvin(kelvin)) << 16) |
+            (static_cast<uint32_t>(std::clamp(tint, -100, 100) + 100) << 8) |
+            static_cast<uint32_t>(std::clamp(brightness, 0, 255));
+    }
+
+    void ColorGains(const ColorSettings& settings, float& red, float& green, float& blue)
+    {
+        // Relative to the neutral white point, so 6500 K is exactly grey
+        const Rgb white = PlanckianRgb(ClampKelvin(settings.kelvin));
+        const Rgb neutral = PlanckianRgb(ColorSettings::NEUTRAL_KELVIN);
+        Rgb gain = { white.red / neutral.red, white.green / neutral.green, white.blue / neutral.blue };
+
+        // A full tint moves green by half a stop either way
+        gain.green *= std::exp2(std::clamp(settings.tint, -100, 100) / 200.0);
+
+        const double peak = std::max({ gain.red, gain.green, gain.blue });
+        const double scale = std::clamp(settings.brightness, 0, 255) / 255.0 / peak;
+        red = static_cast<float>(gain.red * scale);
+        green = static_cast<float>(gain.green * scale);
+        blue = static_cast<float>(gain.blue * scale);
+    }
+
+    float SrgbToLinear(float value)
+    {
+        return static_cast<float>(SrgbToLinear(static_cast<double>(value)));
+    }
+
+    float LinearToSrgb(float value)
+    {
+        return static_cast<float>(LinearToSrgb(static_cast<double>(value)));
+    }
+
+    ColorLut ColorLut::Build(const ColorSettings& settings, bool premultiplied)
+    {
+        float red, green, blue;
+        ColorGains(settings, red, green, blue);
+        const double gains[3] = { red, green, blue };
+
+        ColorLut lut;
+        lut.premultiplied = premultiplied;
+        uint8_t* tables[3] = { lut.red, lut.green, lut.blue };
+
+        if (premultiplied)
+        {
+            // Premultiplied color: the tint in sRGB, times coverage
+            for (int c = 0; c < 3; c++)
+            {
+                const double color = gains[c] == 1.0 ? 1.0 : LinearToSrgb(gains[c]);
+                for (int i = 0; i < 256; i++)
+                    tables[c][i] = ToByte(i * color);
+            }
+        }
+        else
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                for (int i = 0; i < 256; i++)
+                    tables[c][i] = OpaqueEntry(i, gains[c]);
+            }
+
+            // Keep faint pixels off the color key
+            const int brightest = red >= green && red >= blue ? 0 : (green >= blue ? 1 : 2);
+            for (int i = 1; i < 256; i++)
+            {
+                if (lut.red[i] == 0 && lut.green[i] == 0 && lut.blue[i] == 0)
+                    tables[brightest][i] = 1;
+            }
+        }
+
+        for (int i = 0; i < 256; i++)
+        {
+            const uint32_t alpha = premultiplied ? static_cast<uint32_t>(i) : 0xFFu;
+            lut.packed[i] = (alpha << 24) | (uint32_t(lut.red[i]) << 16) | (uint32_t(lut.green[i]) << 8) | lut.blue[i];
+        }
+        return lut;
+    }
+
+    bool ColorLut::IsIdentity() const
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            const uint32_t grey = (i << 16) | (i << 8) | i;
+            if (packed[i] != (premultiplied ? (i << 24) | grey : 0xFF000000u | grey))
+                return false;
+        }
+        return true;
+    }
+
+    void ApplyColorLut(const ColorLut& lut, const BgraBuffer& target, SimdLevel level)
+    {
+        if (target.pixels)
+            ApplyRows(lut, target, 0, target.width, 0, target.height, level);
+    }
+
+    void ApplyColorLut(const ColorLut& lut, const SpanRect* rects, size_t count, const BgraBuffer& target,
+                       SimdLevel level)
+    {
+        if (!target.pixels)
+            return;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const int x0 = std::max(rects[i].left, 0);
+            const int x1 = std::min(rects[i].right, target.width);
+            const int y0 = std::max(rects[i].top, 0);
+            const int y1 = std::min(rects[i].bottom, target.height);
+            if (x1 > x0)
+                ApplyRows(lut, target, x0, x1, y0, y1, level);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "FrameTypes.h"
+#include "SdfKernels.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace EdgeLight
+{
+    struct SpanRect;
+
+    // What the light looks like. Neutral is the grey frame the renderers
+    // write, untouched.
+    struct ColorSettings
+    {
+        static constexpr int NEUTRAL_KELVIN = 6500;
+        static constexpr int MIN_KELVIN = 1700;
+        static constexpr int MAX_KELVIN = 12000;
+
+        int kelvin = NEUTRAL_KELVIN;    // white point, clamped to MIN_KELVIN..MAX_KELVIN
+        int tint = 0;                   // -100 (magenta) .. 100 (green)
+        int brightness = 255;           // 0..255, scales the light in linear space
+
+        bool IsNeutral() const;
+
+        // Distinct per setting once clamped; 0 for neutral, so surface keys
+        // of the plain grey frame stay what they were.
+        uint32_t Key() const;
+
+        bool operator==(const ColorSettings& other) const { return Key() == other.Key(); }
+        bool operator!=(const ColorSettings& other) const { return !(*this == other); }
+    };
+
+    // Linear-light gain per channel for settings, the largest being
+    // brightness / 255 (all exactly 1 when neutral).
+    void ColorGains(const ColorSettings& settings, float& red, float& green, float& blue);
+
+    float SrgbToLinear(float value);
+    float LinearToSrgb(float value);
+
+    // Per-channel tables from the renderers' output to colored pixels,
+    // built once per setting so applying them is a table lookup per pixel.
+    //
+    // Opaque tables take grey pixels (dark = black) and index by the grey
+    // level; the level is decoded to linear light, scaled by the channel's
+    // gain and encoded again, so the falloff keeps its hue instead of
+    // drifting the way scaling the sRGB values would. A lit pixel never
+    // maps to pure black, which is the overlay's color key.
+    //
+    // Premultiplied tables take premultiplied white and index by alpha,
+    // which coloring leaves alone, so colored pixels can be recolored in
+    // place with another table.
+    struct ColorLut
+    {
+        uint8_t red[256];
+        uint8_t green[256];
+        uint8_t blue[256];
+        uint32_t packed[256];   // BGRA per index, what the kernel writes
+        bool premultiplied = false;
+
+        static ColorLut Build(const ColorSettings& settings, bool premultiplied);
+
+        // Applying it leaves every pixel as it is.
+        bool IsIdentity() const;
+
+        // Byte of a pixel the tables are indexed by.
+        int IndexShift() const { return premultiplied ? 24 : 0; }
+    };
+
+    // Colors target in place. target's pixels must be in the format lut was
+    // built for: grey for an opaque table, premultiplied white (or colored
+    // by another premultiplied table) otherwise.
+    void ApplyColorLut(const ColorLut& lut, const BgraBuffer& target, SimdLevel level = DetectSimdLevel());
+
+    // Same, only inside rects (clipped to target).
+    void ApplyColorLut(const ColorLut& lut, const SpanRect* rects, size_t count, const BgraBuffer& target,
+                       SimdLevel level = DetectSimdLevel());
+}
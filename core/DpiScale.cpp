@@ -0,0 +1,101 @@
+#include "DpiScale.h"
+
+#include <algorithm>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        // Widest glow falloff the renderer accepts (see FrameParams).
+        constexpr int MAX_BLUR_SIZE = 64;
+    }
+
+    int DpiBucket(int dpi)
+    {
+        if (dpi <= 0)
+            return BASE_DPI;
+
+        const int bucket = (dpi + DPI_BUCKET_STEP / 2) / DPI_BUCKET_STEP * DPI_BUCKET_STEP;
+        return std::max(bucket, DPI_BUCKET_STEP);
+    }
+
+    double DpiScaleFactor(int dpi)
+    {
+        return static_cast<double>(DpiBucket(dpi)) / BASE_DPI;
+    }
+
+    int ScaleForDpi(int value, int dpi)
+    {
+        if (value <= 0)
+            return value;
+
+        const int64_t scaled = (static_cast<int64_t>(value) * DpiBucket(dpi) + BASE_DPI / 2) / BASE_DPI;
+        return static_cast<int>(std::max<int64_t>(scaled, 1));
+    }
+
+    FrameParams ScaleFrameParams(const FrameParams& logical, int dpi)
+    {
+        FrameParams device = logical;
+        device.frameThickness = ScaleForDpi(logical.frameThickness, dpi);
+        device.cornerRadius = ScaleForDpi(logical.cornerRadius, dpi);
+        device.inset = ScaleForDpi(logical.inset, dpi);
+        device.blurSize = std::min(ScaleForDpi(logical.blurSize, dpi), MAX_BLUR_SIZE);
+        device.glowRadius = ScaleForDpi(logical.glowRadius, dpi);
+        return device;
+    }
+
+    std::shared_ptr<const NineSliceFrame> DpiGeometryCache::Acquire(const FrameParams& device, int dpi)
+    {
+        const int bucket = DpiBucket(dpi);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = frames.find(bucket);
+            if (found != frames.end() && found->second->Matches(device))
+            {
+                hits++;
+                return found->second;
+            }
+            builds++;
+        }
+
+        // Built outside the lock so buckets rasterize in parallel; two
+        // threads racing on one bucket just build the same tiles twice.
+        auto built = std::make_shared<NineSliceFrame>();
+        if (!renderer)
+            built->Build(device);
+        else if (!built->Build(device, *renderer))
+            return nullptr;
+
+        if (!built->IsFullFrame())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames[bucket] = built;
+        }
+        return built;
+    }
+
+    void DpiGeometryCache::SetRenderer(IFrameRenderer* backend)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        renderer = backend;
+        frames.clear();
+    }
+
+    void DpiGeometryCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames.clear();
+    }
+
+    GeometryCacheStats DpiGeometryCache::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        GeometryCacheStats stats;
+        stats.hits = hits;
+        stats.builds = builds;
+        stats.entries = frames.size();
+        for (const auto& entry : frames)
+            stats.bytes += entry.second->ByteSize();
+        return stats;
+    }
+}
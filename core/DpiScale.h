@@ -0,0 +1,77 @@
+#pragma once
+
+#include "FrameTypes.h"
+#include "NineSlice.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace EdgeLight
+{
+    // DPI at which logical and device pixels are the same (100% scaling).
+    constexpr int BASE_DPI = 96;
+
+    // Buckets are 1/8 scale steps: 100%, 112.5%, 125%, ... Every preset in
+    // Windows display settings (25% steps) lands exactly on one, and custom
+    // factors snap to the nearest.
+    constexpr int DPI_BUCKET_STEP = BASE_DPI / 8;
+
+    // Nearest bucket to dpi; every DPI in a bucket draws the same frame.
+    // Unknown (<= 0) DPIs are treated as 96.
+    int DpiBucket(int dpi);
+
+    // Scale factor of dpi's bucket relative to 96, e.g. 1.25 for 120.
+    double DpiScaleFactor(int dpi);
+
+    // value logical pixels in device pixels at dpi's bucket, rounded to
+    // nearest. Positive values never round down to 0.
+    int ScaleForDpi(int value, int dpi);
+
+    // Device-pixel frame for logical (96 DPI) params on a dpi monitor.
+    // width and height are already device pixels (a client rect) and pass
+    // through unchanged.
+    FrameParams ScaleFrameParams(const FrameParams& logical, int dpi);
+
+    struct GeometryCacheStats
+    {
+        uint64_t hits = 0;
+        uint64_t builds = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    // Nine-slice tiles per DPI bucket. Tiles only depend on the frame shape,
+    // so a bucket keeps the last shape it was asked for and any work area
+    // size on a monitor of that DPI composes from it. Moving back and forth
+    // between monitors of known DPIs never re-rasterizes tiles; only a
+    // shape change (thickness, radius, ...) does, once per bucket.
+    //
+    // Thread-safe: surfaces are rendered on the worker pool.
+    class DpiGeometryCache
+    {
+    public:
+        // Backend that rasterizes the tiles; nullptr (the default) uses the
+        // software renderer directly. Drops every cached tile set. Not to be
+        // called while Acquire may be running.
+        void SetRenderer(IFrameRenderer* renderer);
+
+        // Tiles for device params at dpi, building them on a miss. Work
+        // areas too small for separate corners get a full-frame build that
+        // is not kept, as it only fits that exact size. nullptr if the
+        // backend failed to render.
+        std::shared_ptr<const NineSliceFrame> Acquire(const FrameParams& device, int dpi);
+
+        void Clear();
+        GeometryCacheStats Stats() const;
+
+    private:
+        IFrameRenderer* renderer = nullptr;
+        mutable std::mutex mutex;
+        std::unordered_map<int, std::shared_ptr<const NineSliceFrame>> frames;    // by bucket
+        uint64_t hits = 0;
+        uint64_t builds = 0;
+    };
+}
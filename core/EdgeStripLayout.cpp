@@ -0,0 +1,95 @@
+#include "EdgeStripLayout.h"
+
+#include "SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        void AddPiece(EdgeStripLayout& layout, int left, int top, int right, int bottom)
+        {
+            if (right > left && bottom > top)
+                layout.pieces[layout.count++] = { left, top, right, bottom };
+        }
+
+        EdgeStripLayout SinglePiece(int width, int height)
+        {
+            EdgeStripLayout layout;
+            AddPiece(layout, 0, 0, width, height);
+            return layout;
+        }
+    }
+
+    const char* EdgeStripModeName(EdgeStripMode mode)
+    {
+        switch (mode)
+        {
+        case EdgeStripMode::Single: return "single";
+        case EdgeStripMode::FourStrips: return "4 strips";
+        case EdgeStripMode::EightPieces: return "8 pieces";
+        }
+        return "?";
+    }
+
+    size_t EdgeStripLayout::Area() const
+    {
+        size_t area = 0;
+        for (int i = 0; i < count; i++)
+            area += static_cast<size_t>(pieces[i].right - pieces[i].left) * (pieces[i].bottom - pieces[i].top);
+        return area;
+    }
+
+    // A pixel is dark once its distance into the hole is at least the lit
+    // reach. Along the straight runs that is edge = innerEdge + reach from
+    // the side. In a corner the hole's arc of radius r around (c, c),
+    // c = innerEdge + r, comes closer: a strip depth D keeps every pixel
+    // with both coordinates >= D dark when the diagonal from (D, D) to the
+    // arc's center, sqrt(2) (c - D), is within r - reach. Corner squares
+    // of side max(c, edge) instead leave only straight runs between them.
+    EdgeStripLayout EdgeStripLayout::Solve(const FrameParams& params, EdgeStripMode requested)
+    {
+        const int width = params.width;
+        const int height = params.height;
+        if (width <= 0 || height <= 0)
+            return {};
+
+        const float reach = SdfFrameRenderer::LitReach(params);
+        const float radius = SdfFrameRenderer::BuildShape(params).inner.radius;
+        const float innerEdge = static_cast<float>(params.inset + params.frameThickness);
+        const float center = innerEdge + radius;
+
+        const int edge = static_cast<int>(std::ceil(innerEdge + reach));
+        const int depth = std::max(edge, static_cast<int>(std::ceil(center - (radius - reach) / std::sqrt(2.0f))));
+        const int corner = std::max(edge, static_cast<int>(std::ceil(center)));
+
+        EdgeStripLayout layout;
+        if (requested == EdgeStripMode::EightPieces && 2 * corner <= width && 2 * corner <= height)
+        {
+            layout.mode = EdgeStripMode::EightPieces;
+            AddPiece(layout, 0, 0, corner, corner);
+            AddPiece(layout, width - corner, 0, width, corner);
+            AddPiece(layout, 0, height - corner, corner, height);
+            AddPiece(layout, width - corner, height - corner, width, height);
+            AddPiece(layout, corner, 0, width - corner, edge);
+            AddPiece(layout, corner, height - edge, width - corner, height);
+            AddPiece(layout, 0, corner, edge, height - corner);
+            AddPiece(layout, width - edge, corner, width, height - corner);
+            return layout;
+        }
+
+        if (requested != EdgeStripMode::Single && 2 * depth <= width && 2 * depth <= height)
+        {
+            layout.mode = EdgeStripMode::FourStrips;
+            AddPiece(layout, 0, 0, width, depth);
+            AddPiece(layout, 0, height - depth, width, height);
+            AddPiece(layout, 0, depth, depth, height - depth);
+            AddPiece(layout, width - depth, depth, width, height - depth);
+            return layout;
+        }
+
+        return SinglePiece(width, height);
+    }
+}
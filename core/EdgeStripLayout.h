@@ -0,0 +1,41 @@
+#pragma once
+
+#include "FrameSpans.h"
+#include "FrameTypes.h"
+
+#include <cstddef>
+
+namespace EdgeLight
+{
+    enum class EdgeStripMode
+    {
+        Single,         // one window over the whole work area
+        FourStrips,     // full-width top and bottom, left and right between them
+        EightPieces,    // four corner squares and four edge strips
+    };
+
+    const char* EdgeStripModeName(EdgeStripMode mode);
+
+    // Splits the overlay into windows that together cover every pixel the
+    // frame or its glow can light, so the compositor only blends the strips
+    // along the edges instead of a mostly transparent work-area-sized
+    // surface. Pieces are in work-area coordinates, non-overlapping and
+    // non-empty.
+    struct EdgeStripLayout
+    {
+        static constexpr int MAX_PIECES = 8;
+
+        EdgeStripMode mode = EdgeStripMode::Single;     // what was solved
+        int count = 0;
+        SpanRect pieces[MAX_PIECES] = {};
+
+        // Pixels covered by all pieces.
+        size_t Area() const;
+
+        // Layout for params' work area and frame. Work areas too small for
+        // the requested mode fall back to fewer pieces: eight pieces whose
+        // corners would meet become four strips, and strips that would meet
+        // become a single piece. An empty work area has no pieces.
+        static EdgeStripLayout Solve(const FrameParams& params, EdgeStripMode requested);
+    };
+}
@@ -0,0 +1,95 @@
+#include "FrameDelta.h"
+
+#include "GlowEngine.h"
+#include "SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        bool SameOuterShape(const FrameParams& a, const FrameParams& b)
+        {
+            return a.width == b.width && a.height == b.height && a.inset == b.inset &&
+                a.cornerRadius == b.cornerRadius && std::clamp(a.blurSize, 0, 64) == std::clamp(b.blurSize, 0, 64) &&
+                a.glowRadius == b.glowRadius && a.glowStrength == b.glowStrength && a.opacity == b.opacity;
+        }
+
+        void AddRect(std::vector<SpanRect>& rects, int left, int top, int right, int bottom)
+        {
+            if (right > left && bottom > top)
+                rects.push_back({ left, top, right, bottom });
+        }
+    }
+
+    // A pixel's coverage only depends on the inner edge while its signed
+    // distance d to that edge is inside the anti-aliasing and falloff
+    // window: beyond it the band term is saturated (fully lit) or the
+    // pixel is dark in the hole either way. So everything further than
+    // that window from both inner edges is unchanged. Straight runs of the
+    // edge give four bands; the rounded corners reach further in, so each
+    // corner adds the square spanned by the larger radius.
+    bool FrameDelta::Compute(const FrameParams& before, const FrameParams& after, std::vector<SpanRect>& dirty)
+    {
+        dirty.clear();
+        if (!SameOuterShape(before, after))
+            return false;
+
+        const SdfFrameShape a = SdfFrameRenderer::BuildShape(before);
+        const SdfFrameShape b = SdfFrameRenderer::BuildShape(after);
+
+        // An empty inner rect has no edge to move
+        if (a.inner.halfWidth <= 0.0f || a.inner.halfHeight <= 0.0f || b.inner.halfWidth <= 0.0f || b.inner.halfHeight <= 0.0f)
+            return false;
+
+        const int width = after.width;
+        const int height = after.height;
+        const float window = std::max(a.glowScale > 0.0f ? a.glowReach : 0.5f, 0.5f);
+        // The blurred glow spreads every coverage change by its extent
+        // along each axis
+        const int glow = after.glowRadius > 0 ? GlowEngine::Extent(after.glowRadius) : 0;
+        const int reach = static_cast<int>(std::ceil(window)) + 1 + glow;
+
+        // Inner edges sit at the same distance from every side
+        const int edgeA = before.inset + before.frameThickness;
+        const int edgeB = after.inset + after.frameThickness;
+        if (edgeA == edgeB && a.inner.radius == b.inner.radius)
+            return true;
+
+        const int outer = std::max(std::min(edgeA, edgeB) - reach, 0);
+        const int inner = std::max(edgeA, edgeB) + reach;
+        const int corner = std::max(edgeA + static_cast<int>(std::ceil(a.inner.radius)),
+                                    edgeB + static_cast<int>(std::ceil(b.inner.radius))) + reach;
+
+        // Bands along the straight edges, then the rest of each corner
+        // square. Clamped to the middle so tiny frames do not overlap.
+        const int leftEnd = std::min(inner, width / 2);
+        const int rightStart = std::max(width - inner, leftEnd);
+        const int topEnd = std::min(inner, height / 2);
+        const int bottomStart = std::max(height - inner, topEnd);
+        const int cornerLeftEnd = std::min(corner, width / 2);
+        const int cornerRightStart = std::max(width - corner, cornerLeftEnd);
+        const int cornerTopEnd = std::min(corner, height / 2);
+        const int cornerBottomStart = std::max(height - corner, cornerTopEnd);
+
+        AddRect(dirty, outer, outer, width - outer, topEnd);
+        AddRect(dirty, outer, bottomStart, width - outer, height - outer);
+        AddRect(dirty, outer, topEnd, leftEnd, bottomStart);
+        AddRect(dirty, rightStart, topEnd, width - outer, bottomStart);
+        AddRect(dirty, leftEnd, topEnd, cornerLeftEnd, cornerTopEnd);
+        AddRect(dirty, cornerRightStart, topEnd, rightStart, cornerTopEnd);
+        AddRect(dirty, leftEnd, cornerBottomStart, cornerLeftEnd, bottomStart);
+        AddRect(dirty, cornerRightStart, cornerBottomStart, rightStart, bottomStart);
+        return true;
+    }
+
+    size_t FrameDelta::PixelCount(const std::vector<SpanRect>& rects)
+    {
+        size_t pixels = 0;
+        for (const SpanRect& rect : rects)
+            pixels += static_cast<size_t>(rect.right - rect.left) * (rect.bottom - rect.top);
+        return pixels;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "FrameSpans.h"
+#include "FrameTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace EdgeLight
+{
+    // What changes on screen when only the inner edge of the frame moves,
+    // e.g. one notch of the thickness slider: the outer edge, its falloff
+    // and the middle of the band stay exactly as they were, and only a
+    // ring around the old and new inner edges has to be re-rasterized and
+    // presented.
+    class FrameDelta
+    {
+    public:
+        // Rectangles (frame coordinates, non-overlapping) outside of which
+        // frames rendered for before and after are bit-identical. Returns
+        // false, and leaves dirty empty, when anything besides the inner
+        // edge differs: size, outer shape, falloff, opacity or the blurred
+        // glow's radius or strength. The whole frame has to be redrawn
+        // then. With the blurred glow on, the ring is wider by its extent.
+        static bool Compute(const FrameParams& before, const FrameParams& after, std::vector<SpanRect>& dirty);
+
+        static size_t PixelCount(const std::vector<SpanRect>& rects);
+    };
+}
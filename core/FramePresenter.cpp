@@ -0,0 +1,34 @@
+#include "FramePresenter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace EdgeLight
+{
+    void FramePresenter::PresentWithAlpha(const BgraBuffer& source, const BgraBuffer& target, int alpha, SimdLevel level)
+    {
+        if (!source.pixels || !target.pixels)
+            return;
+
+        const SdfKernels* kernels = GetSdfKernels(level);
+        if (!kernels)
+            kernels = GetSdfKernels(SimdLevel::Scalar);
+
+        alpha = std::max(0, std::min(alpha, 255));
+        const int width = std::min(source.width, target.width);
+        const int height = std::min(source.height, target.height);
+        if (alpha == 0 || width <= 0)
+            return;
+
+        for (int y = 0; y < height; y++)
+        {
+            const uint8_t* src = source.pixels + static_cast<size_t>(y) * source.stride;
+            uint8_t* dst = target.pixels + static_cast<size_t>(y) * target.stride;
+
+            if (alpha == 255)
+                std::memcpy(dst, src, static_cast<size_t>(width) * 4);
+            else
+                kernels->blendRow(reinterpret_cast<const uint32_t*>(src), width, alpha, reinterpret_cast<uint32_t*>(dst));
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "FrameTypes.h"
+#include "SdfKernels.h"
+
+namespace EdgeLight
+{
+    // Brightness is not part of the rasterized frame. The frame is rendered
+    // once at full intensity and every brightness change is a single
+    // present with a constant alpha, which is what the overlay gets from
+    // the compositor via the layered window's constant alpha.
+    class FramePresenter
+    {
+    public:
+        // target = lerp(target, source, alpha / 255) over the overlapping
+        // area, per channel and rounded. alpha 255 copies, alpha 0 leaves
+        // target untouched. Presenting over black is bit-identical to
+        // rendering the frame at opacity = alpha.
+        static void PresentWithAlpha(const BgraBuffer& source, const BgraBuffer& target, int alpha,
+                                     SimdLevel level = DetectSimdLevel());
+    };
+}
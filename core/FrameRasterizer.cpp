@@ -0,0 +1,163 @@
+#include "FrameRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        // A ring is everything inside outer but not inside inner, painted
+        // with a single grey level. This is exactly what one
+        // CombineRgn(RGN_DIFF) + FillRgn pair used to produce.
+        struct Ring
+        {
+            RoundRect outer;
+            RoundRect inner;
+            uint8_t value;
+        };
+
+        RoundRect MakeRoundRect(int left, int top, int right, int bottom, int radius)
+        {
+            return { left, top, right, bottom, radius * 2, radius * 2 };
+        }
+
+        inline uint32_t GreyPixel(uint8_t v)
+        {
+            return 0xFF000000u | (uint32_t(v) << 16) | (uint32_t(v) << 8) | v;
+        }
+
+        void FillRun(uint32_t* row, int width, int x0, int x1, uint32_t color)
+        {
+            x0 = std::max(x0, 0);
+            x1 = std::min(x1, width);
+            if (x1 > x0)
+            {
+                std::fill(row + x0, row + x1, color);
+            }
+        }
+
+        int BuildRings(const FrameParams& p, Ring* rings)
+        {
+            const int W = p.width;
+            const int H = p.height;
+            const int inset = p.inset;
+            const int intensity = std::clamp(p.opacity, 0, 255);
+            const int blurSize = std::max(p.blurSize, 0);
+
+            int innerRadius = p.cornerRadius - p.frameThickness;
+            if (innerRadius < MIN_INNER_RADIUS) innerRadius = MIN_INNER_RADIUS;
+
+            int count = 0;
+
+            // Outer glow, farthest ring first.
+            for (int i = blurSize; i >= 1; i--)
+            {
+                uint8_t v = static_cast<uint8_t>((intensity * (blurSize - i + 1)) / (blurSize + 3));
+                rings[count++] = {
+                    MakeRoundRect(inset - i, inset - i, W - inset + i, H - inset + i, p.cornerRadius + i),
+                    MakeRoundRect(inset - i + 1, inset - i + 1, W - inset + i - 1, H - inset + i - 1, p.cornerRadius + i - 1),
+                    v };
+            }
+
+            // Main frame.
+            const int innerEdge = inset + p.frameThickness;
+            rings[count++] = {
+                MakeRoundRect(inset, inset, W - inset, H - inset, p.cornerRadius),
+                MakeRoundRect(innerEdge, innerEdge, W - innerEdge, H - innerEdge, innerRadius),
+                static_cast<uint8_t>(intensity) };
+
+            // Inner glow, nearest ring first.
+            for (int i = 1; i <= blurSize; i++)
+            {
+                uint8_t v = static_cast<uint8_t>((intensity * (blurSize - i + 1)) / (blurSize + 3));
+                int adjustedInnerRadius = innerRadius - i;
+                if (adjustedInnerRadius < MIN_INNER_RADIUS) adjustedInnerRadius = MIN_INNER_RADIUS;
+
+                rings[count++] = {
+                    MakeRoundRect(innerEdge - i, innerEdge - i, W - innerEdge + i, H - innerEdge + i, adjustedInnerRadius + i),
+                    MakeRoundRect(innerEdge - i + 1, innerEdge - i + 1, W - innerEdge + i - 1, H - innerEdge + i - 1, adjustedInnerRadius + i - 1),
+                    v };
+            }
+
+            return count;
+        }
+    }
+
+    bool FrameRasterizer::RowExtent(const RoundRect& rr, int y, int& x0, int& x1)
+    {
+        if (rr.right <= rr.left || rr.bottom <= rr.top)
+            return false;
+
+        const double yc = y + 0.5;
+        if (yc < rr.top || yc >= rr.bottom)
+            return false;
+
+        // GDI clamps the corner ellipse to the rectangle.
+        const double rx = std::min(rr.cornerWidth, rr.right - rr.left) * 0.5;
+        const double ry = std::min(rr.cornerHeight, rr.bottom - rr.top) * 0.5;
+
+        double dy = 0.0;
+        if (yc < rr.top + ry)
+            dy = (rr.top + ry) - yc;
+        else if (yc > rr.bottom - ry)
+            dy = yc - (rr.bottom - ry);
+
+        double indent = 0.0;
+        if (dy > 0.0 && ry > 0.0)
+        {
+            double t = dy / ry;
+            if (t >= 1.0)
+                return false;
+            indent = rx - rx * std::sqrt(1.0 - t * t);
+        }
+
+        x0 = static_cast<int>(std::ceil(rr.left + indent - 0.5));
+        x1 = static_cast<int>(std::ceil(rr.right - indent - 0.5));
+        return x1 > x0;
+    }
+
+    void FrameRasterizer::Render(const FrameParams& params, const BgraBuffer& target)
+    {
+        if (!target.pixels || target.width <= 0 || target.height <= 0)
+            return;
+
+        const uint32_t black = GreyPixel(0);
+        const bool lit = params.opacity > 0;
+
+        Ring rings[2 * 64 + 1];
+        int ringCount = 0;
+        if (lit)
+        {
+            FrameParams clamped = params;
+            clamped.blurSize = std::min(params.blurSize, 64);
+            ringCount = BuildRings(clamped, rings);
+        }
+
+        for (int y = 0; y < target.height; y++)
+        {
+            uint32_t* row = reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+            std::fill(row, row + target.width, black);
+
+            for (int r = 0; r < ringCount; r++)
+            {
+                const Ring& ring = rings[r];
+                int ox0, ox1;
+                if (!RowExtent(ring.outer, y, ox0, ox1))
+                    continue;
+
+                const uint32_t color = GreyPixel(ring.value);
+                int ix0, ix1;
+                if (!RowExtent(ring.inner, y, ix0, ix1) || ix1 <= ox0 || ix0 >= ox1)
+                {
+                    FillRun(row, target.width, ox0, ox1, color);
+                }
+                else
+                {
+                    FillRun(row, target.width, ox0, ix0, color);
+                    FillRun(row, target.width, ix1, ox1, color);
+                }
+            }
+        }
+    }
+}
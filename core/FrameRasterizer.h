@@ -0,0 +1,31 @@
+#pragma once
+
+#include "FrameTypes.h"
+
+namespace EdgeLight
+{
+    // Axis aligned rectangle with elliptical corners, same conventions as
+    // CreateRoundRectRgn: [left, right) x [top, bottom), corner ellipse of
+    // cornerWidth x cornerHeight.
+    struct RoundRect
+    {
+        int left;
+        int top;
+        int right;
+        int bottom;
+        int cornerWidth;
+        int cornerHeight;
+    };
+
+    class FrameRasterizer
+    {
+    public:
+        // Renders the frame into target. Pixels outside the frame and its
+        // glow are written as opaque black (the overlay's color key).
+        static void Render(const FrameParams& params, const BgraBuffer& target);
+
+        // Horizontal extent [x0, x1) of row y inside rr. Returns false when
+        // the row does not intersect the shape.
+        static bool RowExtent(const RoundRect& rr, int y, int& x0, int& x1);
+    };
+}
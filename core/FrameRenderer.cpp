@@ -0,0 +1,155 @@
+#include "FrameRenderer.h"
+
+#include "FrameRasterizer.h"
+#include "SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        struct BackendName
+        {
+            RendererBackend backend;
+            const char* name;
+        };
+
+        constexpr BackendName BACKEND_NAMES[] = {
+            { RendererBackend::Gdi, "gdi" },
+            { RendererBackend::Reference, "reference" },
+            { RendererBackend::Software, "software" },
+            { RendererBackend::Direct2D, "d2d" },
+            { RendererBackend::Null, "null" },
+        };
+
+        // The region rings the CreateRoundRectRgn / CombineRgn / FillRgn
+        // overlay used to draw, scan-converted by FrameRasterizer so they
+        // can be rendered and compared anywhere. This is an emulation of
+        // GDI's region rules, not GDI; the real thing is the Windows-only
+        // gdi backend (win/GdiFrameRenderer).
+        class ReferenceFrameRenderer : public IFrameRenderer
+        {
+        public:
+            RendererBackend Backend() const override { return RendererBackend::Reference; }
+
+            bool RenderMask(const FrameParams& params, const MaskBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+
+                // Rings are only drawn as BGRA; grey, so any channel is the mask
+                thread_local std::vector<uint32_t> scratch;
+                scratch.resize(static_cast<size_t>(target.width) * target.height);
+                FrameParams full = params;
+                full.opacity = 255;
+                FrameRasterizer::Render(full, { reinterpret_cast<uint8_t*>(scratch.data()), target.width, target.height, target.width * 4 });
+
+                for (int y = 0; y < target.height; y++)
+                {
+                    const uint32_t* in = scratch.data() + static_cast<size_t>(y) * target.width;
+                    uint8_t* out = target.pixels + static_cast<size_t>(y) * target.stride;
+                    for (int x = 0; x < target.width; x++)
+                        out[x] = static_cast<uint8_t>(in[x]);
+                }
+                return true;
+            }
+
+            bool Render(const FrameParams& params, const BgraBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+                FrameRasterizer::Render(params, target);
+                return true;
+            }
+        };
+
+        class SoftwareFrameRenderer : public IFrameRenderer
+        {
+        public:
+            RendererBackend Backend() const override { return RendererBackend::Software; }
+
+            bool RenderMask(const FrameParams& params, const MaskBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+                SdfFrameRenderer::RenderMask(params, target);
+                return true;
+            }
+
+            bool Render(const FrameParams& params, const BgraBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+                SdfFrameRenderer::Render(params, target);
+                return true;
+            }
+        };
+
+        class NullFrameRenderer : public IFrameRenderer
+        {
+        public:
+            RendererBackend Backend() const override { return RendererBackend::Null; }
+
+            bool RenderMask(const FrameParams&, const MaskBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+                for (int y = 0; y < target.height; y++)
+                    std::memset(target.pixels + static_cast<size_t>(y) * target.stride, 0, target.width);
+                return true;
+            }
+
+            bool Render(const FrameParams&, const BgraBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+                for (int y = 0; y < target.height; y++)
+                {
+                    uint32_t* row = reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+                    std::fill(row, row + target.width, 0xFF000000u);
+                }
+                return true;
+            }
+        };
+    }
+
+    const char* RendererBackendName(RendererBackend backend)
+    {
+        for (const BackendName& entry : BACKEND_NAMES)
+        {
+            if (entry.backend == backend)
+                return entry.name;
+        }
+        return "unknown";
+    }
+
+    bool ParseRendererBackend(const char* name, RendererBackend& backend)
+    {
+        if (!name)
+            return false;
+
+        for (const BackendName& entry : BACKEND_NAMES)
+        {
+            if (std::strcmp(entry.name, name) == 0)
+            {
+                backend = entry.backend;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::unique_ptr<IFrameRenderer> CreateFrameRenderer(RendererBackend backend)
+    {
+        switch (backend)
+        {
+        case RendererBackend::Reference: return std::make_unique<ReferenceFrameRenderer>();
+        case RendererBackend::Software:  return std::make_unique<SoftwareFrameRenderer>();
+        case RendererBackend::Null:      return std::make_unique<NullFrameRenderer>();
+        default:                         return nullptr;
+        }
+    }
+}
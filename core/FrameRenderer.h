@@ -0,0 +1,56 @@
+#pragma once
+
+#include "FrameTypes.h"
+
+#include <memory>
+
+namespace EdgeLight
+{
+    enum class RendererBackend
+    {
+        Gdi,        // GDI round-rect regions, one filled ring per glow step (Windows only)
+        Reference,  // FrameRasterizer's portable re-implementation of those rings; not GDI
+        Software,   // anti-aliased SDF rasterizer, SSE2/AVX2 row kernels
+        Direct2D,   // Direct2D geometry fill (Windows only)
+        Null,       // renders nothing: headless runs and overhead baselines
+    };
+
+    // Short names used on the command line and in bench output: "gdi",
+    // "reference", "software", "d2d" and "null".
+    const char* RendererBackendName(RendererBackend backend);
+    bool ParseRendererBackend(const char* name, RendererBackend& backend);
+
+    // One way of turning FrameParams into pixels. Every backend follows the
+    // same conventions, so the nine-slice tiles, the bench harness and the
+    // overlay do not care which one is in use:
+    //
+    //  - Targets may be smaller than params' size; they receive the
+    //    top-left part of the frame (the nine-slice corner build relies on
+    //    this).
+    //  - Dark pixels are 0 in masks and opaque black (the color key) in
+    //    BGRA targets.
+    //  - Render and RenderMask may be called from several threads at once.
+    //
+    // Both return false when the backend could not draw (e.g. a lost
+    // device); the target contents are unspecified then.
+    class IFrameRenderer
+    {
+    public:
+        virtual ~IFrameRenderer() = default;
+
+        virtual RendererBackend Backend() const = 0;
+
+        // Full-intensity mask, independent of params.opacity.
+        virtual bool RenderMask(const FrameParams& params, const MaskBuffer& target) = 0;
+
+        // Grey BGRA frame scaled by params.opacity.
+        virtual bool Render(const FrameParams& params, const BgraBuffer& target) = 0;
+
+        const char* Name() const { return RendererBackendName(Backend()); }
+    };
+
+    // The portable backends (Reference, Software, Null). Returns nullptr
+    // for backends that need a platform implementation, i.e. Gdi and
+    // Direct2D.
+    std::unique_ptr<IFrameRenderer> CreateFrameRenderer(RendererBackend backend);
+}
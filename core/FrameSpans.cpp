@@ -0,0 +1,155 @@
+#include "FrameSpans.h"
+
+#include "SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        // Half width of row py inside rr grown (or shrunk, for negative
+        // grow) by grow pixels. Offsetting a rounded rectangle gives another
+        // rounded rectangle, so this is exact. Returns false for rows that
+        // miss the shape.
+        bool OffsetHalfSpan(const SdfRoundRect& rr, float grow, float py, float& halfSpan)
+        {
+            const float hx = rr.halfWidth + grow;
+            const float hy = rr.halfHeight + grow;
+            const float r = std::max(rr.radius + grow, 0.0f);
+            if (hx <= 0.0f || hy <= 0.0f)
+                return false;
+
+            const float qy = std::fabs(py - rr.centerY) - (hy - r);
+            if (qy <= 0.0f)
+            {
+                halfSpan = hx;
+                return true;
+            }
+            if (qy >= r)
+                return false;
+
+            halfSpan = hx - r + std::sqrt(r * r - qy * qy);
+            return true;
+        }
+    }
+
+    void FrameSpans::Build(const FrameParams& params)
+    {
+        key = params;
+        built = true;
+        width = std::max(params.width, 0);
+        height = std::max(params.height, 0);
+        spans.clear();
+        rowStart.assign(static_cast<size_t>(height) + 1, 0);
+
+        const SdfFrameShape shape = SdfFrameRenderer::BuildShape(params);
+
+        // Anything farther than reach from the band renders as exactly 0.
+        const float reach = SdfFrameRenderer::LitReach(params);
+
+        for (int y = 0; y < height; y++)
+        {
+            rowStart[y] = static_cast<uint32_t>(spans.size());
+            const float py = y + 0.5f;
+
+            float outerHalf;
+            if (!OffsetHalfSpan(shape.outer, reach, py, outerHalf))
+                continue;
+
+            // Rounded outwards by a pixel; the kernels write exact zeros there.
+            const float cx = shape.outer.centerX;
+            int x0 = std::max(static_cast<int>(std::floor(cx - outerHalf - 0.5f)), 0);
+            int x1 = std::min(static_cast<int>(std::ceil(cx + outerHalf - 0.5f)) + 1, width);
+            if (x1 <= x0)
+                continue;
+
+            // The dark hole, rounded inwards.
+            float holeHalf;
+            if (OffsetHalfSpan(shape.inner, -reach, py, holeHalf))
+            {
+                const float hcx = shape.inner.centerX;
+                const int h0 = std::max(static_cast<int>(std::ceil(hcx - holeHalf - 0.5f)) + 1, x0);
+                const int h1 = std::min(static_cast<int>(std::floor(hcx + holeHalf - 0.5f)), x1);
+                if (h1 > h0)
+                {
+                    if (h0 > x0)
+                        spans.push_back({ x0, h0 });
+                    if (x1 > h1)
+                        spans.push_back({ h1, x1 });
+                    continue;
+                }
+            }
+
+            spans.push_back({ x0, x1 });
+        }
+        rowStart[height] = static_cast<uint32_t>(spans.size());
+    }
+
+    void FrameSpans::Clear()
+    {
+        built = false;
+        width = 0;
+        height = 0;
+        spans.clear();
+        rowStart.clear();
+    }
+
+    bool FrameSpans::Matches(const FrameParams& params) const
+    {
+        return built &&
+            key.width == params.width &&
+            key.height == params.height &&
+            key.frameThickness == params.frameThickness &&
+            key.cornerRadius == params.cornerRadius &&
+            key.inset == params.inset &&
+            key.blurSize == params.blurSize &&
+            key.glowRadius == params.glowRadius &&
+            (key.glowRadius == 0 || key.glowStrength == params.glowStrength);
+    }
+
+    size_t FrameSpans::PixelCount() const
+    {
+        size_t count = 0;
+        for (const Span& span : spans)
+            count += static_cast<size_t>(span.x1 - span.x0);
+        return count;
+    }
+
+    size_t FrameSpans::ByteSize() const
+    {
+        return rowStart.capacity() * sizeof(uint32_t) + spans.capacity() * sizeof(Span);
+    }
+
+    void FrameSpans::ToRects(std::vector<SpanRect>& rects) const
+    {
+        rects.clear();
+
+        auto sameRuns = [this](int a, int b)
+        {
+            const size_t count = rowStart[a + 1] - rowStart[a];
+            if (count != rowStart[b + 1] - rowStart[b])
+                return false;
+            for (size_t i = 0; i < count; i++)
+            {
+                const Span& sa = spans[rowStart[a] + i];
+                const Span& sb = spans[rowStart[b] + i];
+                if (sa.x0 != sb.x0 || sa.x1 != sb.x1)
+                    return false;
+            }
+            return true;
+        };
+
+        int bandTop = 0;
+        for (int y = 1; y <= height; y++)
+        {
+            if (y < height && sameRuns(bandTop, y))
+                continue;
+
+            for (const Span* s = RowBegin(bandTop); s != RowEnd(bandTop); ++s)
+                rects.push_back({ s->x0, bandTop, s->x1, y });
+            bandTop = y;
+        }
+    }
+}
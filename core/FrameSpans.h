@@ -0,0 +1,64 @@
+#pragma once
+
+#include "FrameTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace EdgeLight
+{
+    // Half-open run [x0, x1) on one scanline.
+    struct Span
+    {
+        int x0;
+        int x1;
+    };
+
+    // Rectangle in the same layout as a Win32 RECT, so a list of these can
+    // be copied straight into RGNDATA for ExtCreateRegion.
+    struct SpanRect
+    {
+        int left;
+        int top;
+        int right;
+        int bottom;
+    };
+
+    // Per-scanline runs that cover every pixel the frame or its glow can
+    // light. Top and bottom bands have one run per row, the sides two.
+    // Everything outside the runs is guaranteed dark, so painters only
+    // need to touch these pixels: work scales with the perimeter rather
+    // than the screen area.
+    class FrameSpans
+    {
+    public:
+        void Build(const FrameParams& params);
+        void Clear();
+
+        // True when the spans were built for the same geometry (opacity is
+        // not part of the geometry).
+        bool Matches(const FrameParams& params) const;
+
+        bool Empty() const { return spans.empty(); }
+        int Width() const { return width; }
+        int Height() const { return height; }
+        size_t SpanCount() const { return spans.size(); }
+        size_t PixelCount() const;
+        size_t ByteSize() const;
+
+        const Span* RowBegin(int y) const { return spans.data() + rowStart[y]; }
+        const Span* RowEnd(int y) const { return spans.data() + rowStart[y + 1]; }
+
+        // Region rectangles, y-x banded. Consecutive rows with identical
+        // runs are merged into one taller rectangle.
+        void ToRects(std::vector<SpanRect>& rects) const;
+
+    private:
+        FrameParams key;
+        bool built = false;
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> rowStart;   // height + 1 entries into spans
+        std::vector<Span> spans;
+    };
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // Everything needed to draw one frame. Mirrors the constants that used
+    // to live inside EdgeLightWindow::OnPaint.
+    struct FrameParams
+    {
+        int width = 0;
+        int height = 0;
+        int frameThickness = 80;
+        int cornerRadius = 100;
+        int inset = 20;             // gap between the work area edge and the frame
+        int blurSize = 2;           // glow falloff in pixels on each side of the frame (max 64)
+        int glowRadius = 0;         // blurred glow reach in pixels, 0 disables the glow pass
+        int glowStrength = 128;     // 0..255, peak of the blurred glow relative to the frame
+        int opacity = 255;          // 0..255, 0 renders an empty (transparent) frame
+    };
+
+    // Caller-owned 32bpp BGRA pixels, top-down, stride in bytes.
+    // SdfFrameRenderer writes opaque grey, dark = black, unless the buffer
+    // is premultiplied: then white with alpha = intensity, dark =
+    // transparent, the format UpdateLayeredWindow composites per pixel.
+    struct BgraBuffer
+    {
+        uint8_t* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+        bool premultiplied = false;
+    };
+
+    // Caller-owned 8bpp intensity mask (0 = dark, 255 = fully lit), top-down.
+    struct MaskBuffer
+    {
+        uint8_t* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+    };
+
+    // One display as the overlay sees it: an opaque id (an HMONITOR on
+    // Windows), its work area in virtual-screen pixels and its DPI.
+    struct MonitorDesc
+    {
+        uint64_t id = 0;
+        int left = 0;
+        int top = 0;
+        int right = 0;
+        int bottom = 0;
+        int dpi = 96;
+
+        int Width() const { return right - left; }
+        int Height() const { return bottom - top; }
+    };
+
+    // Smallest inner corner radius the frame is ever drawn with.
+    constexpr int MIN_INNER_RADIUS = 10;
+}
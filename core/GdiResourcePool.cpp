@@ -0,0 +1,116 @@
+#include "GdiResourcePool.h"
+
+#include <algorithm>
+
+namespace EdgeLight
+{
+    GdiResourcePool::GdiResourcePool(GdiAllocator& allocator) :
+        allocator(allocator)
+    {
+    }
+
+    GdiResourcePool::~GdiResourcePool()
+    {
+        Clear();
+    }
+
+    GdiHandle GdiResourcePool::Track(GdiHandle handle)
+    {
+        if (handle)
+        {
+            live++;
+            created++;
+            peak = std::max(peak, live);
+        }
+        return handle;
+    }
+
+    void GdiResourcePool::Release(GdiHandle handle)
+    {
+        if (!handle)
+            return;
+        allocator.Delete(handle);
+        live--;
+        deleted++;
+    }
+
+    GdiHandle GdiResourcePool::Brush(uint8_t intensity)
+    {
+        GdiHandle& brush = brushes[intensity];
+        if (brush)
+        {
+            brushHits++;
+            return brush;
+        }
+
+        brush = Track(allocator.CreateBrush(intensity));
+        brushCount += brush ? 1 : 0;
+        return brush;
+    }
+
+    GdiHandle GdiResourcePool::Region(const SurfaceKey& key, const FrameSpans& spans)
+    {
+        auto found = regionIndex.find(key);
+        if (found != regionIndex.end())
+        {
+            regionHits++;
+            regions.splice(regions.begin(), regions, found->second);
+            return found->second->handle;
+        }
+
+        // Evict first so the pool never holds more than MAX_REGIONS
+        if (regions.size() >= MAX_REGIONS)
+        {
+            regionIndex.erase(regions.back().key);
+            Release(regions.back().handle);
+            regions.pop_back();
+        }
+
+        const GdiHandle handle = Track(allocator.CreateRegion(spans));
+        if (!handle)
+            return 0;
+
+        regions.push_front({ key, handle });
+        regionIndex[key] = regions.begin();
+        return handle;
+    }
+
+    GdiHandle GdiResourcePool::Scratch()
+    {
+        if (!scratch)
+            scratch = Track(allocator.CreateEmptyRegion());
+        return scratch;
+    }
+
+    void GdiResourcePool::Clear()
+    {
+        for (GdiHandle& brush : brushes)
+        {
+            Release(brush);
+            brush = 0;
+        }
+        brushCount = 0;
+
+        for (const RegionEntry& entry : regions)
+            Release(entry.handle);
+        regions.clear();
+        regionIndex.clear();
+
+        Release(scratch);
+        scratch = 0;
+    }
+
+    GdiPoolStats GdiResourcePool::Stats() const
+    {
+        GdiPoolStats stats;
+        stats.brushes = brushCount;
+        stats.regions = regions.size() + (scratch ? 1 : 0);
+        stats.live = live;
+        stats.peak = peak;
+        stats.created = created;
+        stats.deleted = deleted;
+        stats.brushHits = brushHits;
+        stats.regionHits = regionHits;
+        return stats;
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "FrameSpans.h"
+#include "SurfaceCache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace EdgeLight
+{
+    // An HBRUSH or HRGN on Windows; any non-zero value elsewhere.
+    using GdiHandle = uintptr_t;
+
+    // Creates and deletes the GDI objects the pool hands out. The overlay
+    // implements it on top of GDI (win/GdiAllocator.h); tests use a mock.
+    class GdiAllocator
+    {
+    public:
+        virtual ~GdiAllocator() = default;
+
+        // Solid grey brush, RGB(intensity, intensity, intensity).
+        virtual GdiHandle CreateBrush(uint8_t intensity) = 0;
+
+        // Region covering every span pixel.
+        virtual GdiHandle CreateRegion(const FrameSpans& spans) = 0;
+
+        // Empty region, used as the destination of region arithmetic.
+        virtual GdiHandle CreateEmptyRegion() = 0;
+
+        virtual void Delete(GdiHandle handle) = 0;
+    };
+
+    struct GdiPoolStats
+    {
+        size_t brushes = 0;         // live
+        size_t regions = 0;         // live, the scratch region included
+        size_t live = 0;
+        size_t peak = 0;
+        uint64_t created = 0;
+        uint64_t deleted = 0;
+        uint64_t brushHits = 0;
+        uint64_t regionHits = 0;
+    };
+
+    // GDI objects for painting, created once and reused across paints
+    // instead of being created and deleted every WM_PAINT. Brushes are
+    // kept by intensity, created on first use. Frame regions are kept per
+    // surface geometry in a small LRU. One scratch region takes the result
+    // of CombineRgn so region arithmetic allocates nothing either.
+    //
+    // Not thread-safe; owned by the thread that paints.
+    class GdiResourcePool
+    {
+    public:
+        static constexpr size_t MAX_BRUSHES = 256;
+        static constexpr size_t MAX_REGIONS = 16;
+
+        explicit GdiResourcePool(GdiAllocator& allocator);
+        ~GdiResourcePool();
+
+        GdiResourcePool(const GdiResourcePool&) = delete;
+        GdiResourcePool& operator=(const GdiResourcePool&) = delete;
+
+        // 0 when the allocator fails.
+        GdiHandle Brush(uint8_t intensity);
+
+        // Region of spans, built for key's geometry on first use. Stays
+        // valid until MAX_REGIONS other geometries were used after it, or
+        // until Clear.
+        GdiHandle Region(const SurfaceKey& key, const FrameSpans& spans);
+
+        // The same empty region every call, for region arithmetic results.
+        GdiHandle Scratch();
+
+        // Deletes every pooled object.
+        void Clear();
+
+        GdiPoolStats Stats() const;
+
+    private:
+        struct RegionEntry
+        {
+            SurfaceKey key;
+            GdiHandle handle;
+        };
+
+        using RegionList = std::list<RegionEntry>;
+
+        GdiHandle Track(GdiHandle handle);
+        void Release(GdiHandle handle);
+
+        GdiAllocator& allocator;
+        GdiHandle brushes[MAX_BRUSHES] = {};
+        size_t brushCount = 0;
+        RegionList regions;     // most recently used first
+        std::unordered_map<SurfaceKey, RegionList::iterator, SurfaceKeyHash> regionIndex;
+        GdiHandle scratch = 0;
+        size_t live = 0;
+        size_t peak = 0;
+        uint64_t created = 0;
+        uint64_t deleted = 0;
+        uint64_t brushHits = 0;
+        uint64_t regionHits = 0;
+    };
+}
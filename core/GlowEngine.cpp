@@ -0,0 +1,208 @@
+#include "GlowEngine.h"
+
+#include "SdfKernelMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        // round(sum / divisor) via a 32.32 fixed point reciprocal, so the
+        // inner loops do not divide.
+        struct Divider
+        {
+            uint64_t inverse;
+
+            explicit Divider(uint32_t divisor)
+                : inverse(((uint64_t(1) << 32) + divisor / 2) / divisor)
+            {
+            }
+
+            uint16_t operator()(uint32_t sum) const
+            {
+                const uint64_t q = (uint64_t(sum) * inverse + (uint64_t(1) << 31)) >> 32;
+                return static_cast<uint16_t>(q > 0xFFFF ? 0xFFFF : q);
+            }
+        };
+
+        inline uint8_t To8(uint16_t v)
+        {
+            return static_cast<uint8_t>((uint32_t(v) * 255u + 32767u) / 65535u);
+        }
+    }
+
+    void GlowEngine::BoxRadii(int radius, int boxes[PASSES])
+    {
+        // Box widths whose repeated convolution has the variance of a
+        // Gaussian with sigma = radius / 3 (Kovesi, "Fast almost-Gaussian
+        // filtering").
+        const double sigma = std::max(radius, 0) / 3.0;
+        const double n = PASSES;
+        int lower = static_cast<int>(std::floor(std::sqrt(12.0 * sigma * sigma / n + 1.0)));
+        if (lower % 2 == 0)
+            lower--;
+        if (lower < 1)
+            lower = 1;
+        const int upper = lower + 2;
+
+        const double ideal = (12.0 * sigma * sigma - n * lower * lower - 4.0 * n * lower - 3.0 * n) / (-4.0 * lower - 4.0);
+        const int lowerCount = static_cast<int>(std::lround(ideal));
+
+        for (int i = 0; i < PASSES; i++)
+        {
+            const int width = i < lowerCount ? lower : upper;
+            boxes[i] = (width - 1) / 2;
+        }
+    }
+
+    int GlowEngine::Extent(int radius)
+    {
+        int boxes[PASSES];
+        BoxRadii(radius, boxes);
+        return boxes[0] + boxes[1] + boxes[2];
+    }
+
+    void GlowEngine::HorizontalPass(int width, int height, int r)
+    {
+        const Divider divide(2 * r + 1);
+        rowCopy.resize(width);
+
+        for (int y = 0; y < height; y++)
+        {
+            uint16_t* row = plane.data() + static_cast<size_t>(y) * width;
+            std::memcpy(rowCopy.data(), row, width * sizeof(uint16_t));
+            const uint16_t* in = rowCopy.data();
+
+            uint32_t sum = 0;
+            for (int i = 0; i <= r && i < width; i++)
+                sum += in[i];
+
+            for (int x = 0; x < width; x++)
+            {
+                row[x] = divide(sum);
+                if (x + r + 1 < width)
+                    sum += in[x + r + 1];
+                if (x - r >= 0)
+                    sum -= in[x - r];
+            }
+        }
+    }
+
+    void GlowEngine::VerticalPass(int width, int height, int r)
+    {
+        const Divider divide(2 * r + 1);
+        const int ringRows = r + 1;
+        ring.resize(static_cast<size_t>(ringRows) * width);
+        sums.assign(width, 0);
+
+        for (int y = 0; y <= r && y < height; y++)
+        {
+            const uint16_t* row = plane.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; x++)
+                sums[x] += row[x];
+        }
+
+        for (int y = 0; y < height; y++)
+        {
+            // Rows are blurred in place, so keep the originals that are
+            // still inside the window.
+            uint16_t* row = plane.data() + static_cast<size_t>(y) * width;
+            uint16_t* saved = ring.data() + static_cast<size_t>(y % ringRows) * width;
+            std::memcpy(saved, row, width * sizeof(uint16_t));
+
+            for (int x = 0; x < width; x++)
+                row[x] = divide(sums[x]);
+
+            if (y + r + 1 < height)
+            {
+                const uint16_t* entering = plane.data() + static_cast<size_t>(y + r + 1) * width;
+                for (int x = 0; x < width; x++)
+                    sums[x] += entering[x];
+            }
+            if (y - r >= 0)
+            {
+                const uint16_t* leaving = ring.data() + static_cast<size_t>((y - r) % ringRows) * width;
+                for (int x = 0; x < width; x++)
+                    sums[x] -= leaving[x];
+            }
+        }
+    }
+
+    void GlowEngine::BlurPlane(int width, int height, int radius)
+    {
+        int boxes[PASSES];
+        BoxRadii(radius, boxes);
+
+        for (int r : boxes)
+        {
+            if (r > 0)
+                HorizontalPass(width, height, r);
+        }
+        for (int r : boxes)
+        {
+            if (r > 0)
+                VerticalPass(width, height, r);
+        }
+    }
+
+    void GlowEngine::LoadPlane(const MaskBuffer& mask)
+    {
+        plane.resize(static_cast<size_t>(mask.width) * mask.height);
+        for (int y = 0; y < mask.height; y++)
+        {
+            const uint8_t* src = mask.pixels + static_cast<size_t>(y) * mask.stride;
+            uint16_t* dst = plane.data() + static_cast<size_t>(y) * mask.width;
+            for (int x = 0; x < mask.width; x++)
+                dst[x] = static_cast<uint16_t>(src[x] * 257);
+        }
+    }
+
+    void GlowEngine::Blur(const MaskBuffer& mask, int radius)
+    {
+        if (!mask.pixels || mask.width <= 0 || mask.height <= 0 || radius <= 0)
+            return;
+
+        LoadPlane(mask);
+        BlurPlane(mask.width, mask.height, radius);
+
+        for (int y = 0; y < mask.height; y++)
+        {
+            const uint16_t* src = plane.data() + static_cast<size_t>(y) * mask.width;
+            uint8_t* dst = mask.pixels + static_cast<size_t>(y) * mask.stride;
+            for (int x = 0; x < mask.width; x++)
+                dst[x] = To8(src[x]);
+        }
+    }
+
+    void GlowEngine::Apply(const MaskBuffer& mask, int radius, int strength)
+    {
+        if (!mask.pixels || mask.width <= 0 || mask.height <= 0 || radius <= 0 || strength <= 0)
+            return;
+
+        strength = std::min(strength, 255);
+        LoadPlane(mask);
+        BlurPlane(mask.width, mask.height, radius);
+
+        for (int y = 0; y < mask.height; y++)
+        {
+            const uint16_t* src = plane.data() + static_cast<size_t>(y) * mask.width;
+            uint8_t* dst = mask.pixels + static_cast<size_t>(y) * mask.stride;
+            for (int x = 0; x < mask.width; x++)
+            {
+                const uint8_t glow = Kernels::ScaleLevel(To8(src[x]), strength);
+                dst[x] = std::max(dst[x], glow);
+            }
+        }
+    }
+
+    size_t GlowEngine::ScratchBytes() const
+    {
+        return plane.capacity() * sizeof(uint16_t) +
+            rowCopy.capacity() * sizeof(uint16_t) +
+            ring.capacity() * sizeof(uint16_t) +
+            sums.capacity() * sizeof(uint32_t);
+    }
+}
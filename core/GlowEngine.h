@@ -0,0 +1,47 @@
+#pragma once
+
+#include "FrameTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace EdgeLight
+{
+    // Soft glow from a coverage mask. Three sliding-window box blurs
+    // approximate a Gaussian, and each pass costs a constant amount of work
+    // per pixel no matter how large the radius is.
+    //
+    // The engine keeps its scratch memory between calls, so reusing one
+    // instance per renderer avoids per-frame allocations.
+    class GlowEngine
+    {
+    public:
+        static constexpr int PASSES = 3;
+
+        // Half widths of the three box passes for a glow that fades out
+        // roughly radius pixels from the lit edge (radius ~ 3 sigma).
+        static void BoxRadii(int radius, int boxes[PASSES]);
+
+        // Farthest distance, along either axis, that a lit pixel can spread to.
+        static int Extent(int radius);
+
+        // mask = blur(mask), in place.
+        void Blur(const MaskBuffer& mask, int radius);
+
+        // mask = max(mask, blur(mask) * strength / 255), in place.
+        void Apply(const MaskBuffer& mask, int radius, int strength);
+
+        size_t ScratchBytes() const;
+
+    private:
+        void LoadPlane(const MaskBuffer& mask);
+        void BlurPlane(int width, int height, int radius);
+        void HorizontalPass(int width, int height, int r);
+        void VerticalPass(int width, int height, int r);
+
+        std::vector<uint16_t> plane;    // 16-bit working copy of the mask
+        std::vector<uint16_t> rowCopy;  // one row, for the horizontal passes
+        std::vector<uint16_t> ring;     // r + 1 original rows, for the vertical passes
+        std::vector<uint32_t> sums;     // running column sums
+    };
+}
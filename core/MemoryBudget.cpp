@@ -0,0 +1,151 @@
+#include "MemoryBudget.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace EdgeLight
+{
+    const char* MemoryCategoryName(MemoryCategory category)
+    {
+        switch (category)
+        {
+        case MemoryCategory::Surfaces: return "surfaces";
+        case MemoryCategory::Tiles: return "tiles";
+        case MemoryCategory::Layered: return "layered";
+        case MemoryCategory::Sampler: return "sampler";
+        case MemoryCategory::Count: break;
+        }
+        return "?";
+    }
+
+    MemoryBudget::MemoryBudget(const Clock& clock, size_t ceilingBytes, int64_t idleUs) :
+        clock(clock),
+        ceiling(ceilingBytes),
+        idle(idleUs),
+        touchedAt(clock.NowUs())
+    {
+    }
+
+    void MemoryBudget::Register(MemoryCategory category, MeasureFn measure, ShrinkFn shrink)
+    {
+        Insert({ category, std::move(measure), std::move(shrink), false });
+    }
+
+    void MemoryBudget::RegisterPinned(MemoryCategory category, MeasureFn measure, ShrinkFn shrink)
+    {
+        Insert({ category, std::move(measure), std::move(shrink), true });
+    }
+
+    void MemoryBudget::Insert(Holder holder)
+    {
+        // Stable insert keeps registration order within a category
+        auto at = std::upper_bound(holders.begin(), holders.end(), holder.category,
+                                   [](MemoryCategory c, const Holder& h) { return c < h.category; });
+        holders.insert(at, std::move(holder));
+    }
+
+    void MemoryBudget::SetCeiling(size_t ceilingBytes)
+    {
+        ceiling = ceilingBytes;
+    }
+
+    void MemoryBudget::SetIdleTimeout(int64_t idleUs)
+    {
+        idle = idleUs;
+    }
+
+    MemoryUsage MemoryBudget::Usage() const
+    {
+        MemoryUsage usage;
+        for (const Holder& holder : holders)
+        {
+            const size_t bytes = holder.measure();
+            usage.bytes[static_cast<int>(holder.category)] += bytes;
+            usage.total += bytes;
+        }
+        return usage;
+    }
+
+    size_t MemoryBudget::Enforce()
+    {
+        const size_t total = Usage().total;
+        if (total <= ceiling)
+            return 0;
+
+        stats.enforcements++;
+        return Release(total - ceiling, false);
+    }
+
+    void MemoryBudget::Touch()
+    {
+        touchedAt = clock.NowUs();
+        trimmed = false;
+    }
+
+    int64_t MemoryBudget::TimeUntilIdle() const
+    {
+        if (trimmed || idle < 0)
+            return -1;
+        return std::max<int64_t>(touchedAt + idle - clock.NowUs(), 0);
+    }
+
+    bool MemoryBudget::IdleDue()
+    {
+        if (TimeUntilIdle() != 0)
+            return false;
+
+        trimmed = true;
+        stats.idleTrims++;
+        Release(std::numeric_limits<size_t>::max(), true);
+        return true;
+    }
+
+    size_t MemoryBudget::Release(size_t excess, bool idle)
+    {
+        size_t released = 0;
+        for (const Holder& holder : holders)
+        {
+            if (released >= excess)
+                break;
+            if (!holder.shrink || (holder.pinned && !idle))
+                continue;
+
+            const size_t before = holder.measure();
+            if (before == 0)
+                continue;
+
+            const size_t wanted = excess - released;
+            holder.shrink(before > wanted ? before - wanted : 0);
+
+            const size_t after = holder.measure();
+            released += before > after ? before - after : 0;
+        }
+        stats.releasedBytes += released;
+        return released;
+    }
+
+    std::string MemoryBudget::Report() const
+    {
+        int counts[static_cast<int>(MemoryCategory::Count)] = {};
+        for (const Holder& holder : holders)
+            counts[static_cast<int>(holder.category)]++;
+
+        const MemoryUsage usage = Usage();
+        std::string report;
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-24s %10s %8s\n", "memory", "KB", "holders");
+        report += line;
+
+        for (int i = 0; i < static_cast<int>(MemoryCategory::Count); i++)
+        {
+            std::snprintf(line, sizeof(line), "%-24s %10.1f %8d\n", MemoryCategoryName(static_cast<MemoryCategory>(i)),
+                          usage.bytes[i] / 1024.0, counts[i]);
+            report += line;
+        }
+
+        std::snprintf(line, sizeof(line), "%-24s %10.1f of %.1f\n", "total", usage.total / 1024.0, ceiling / 1024.0);
+        report += line;
+        return report;
+    }
+}
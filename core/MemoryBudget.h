@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace EdgeLight
+{
+    // What a block of memory holds. Also the eviction order: earlier
+    // categories are cheaper to regenerate and go first.
+    enum class MemoryCategory
+    {
+        Surfaces,   // rendered frame surfaces in the surface cache, span tables included
+        Tiles,      // nine-slice tiles per DPI bucket
+        Layered,    // per-pixel alpha DIBs kept for incremental updates
+        Sampler,    // auto-brightness capture DIB; last, as a running sampler regrows it at once
+        Count
+    };
+
+    const char* MemoryCategoryName(MemoryCategory category);
+
+    struct MemoryUsage
+    {
+        size_t bytes[static_cast<int>(MemoryCategory::Count)] = {};
+        size_t total = 0;
+
+        size_t Of(MemoryCategory category) const { return bytes[static_cast<int>(category)]; }
+    };
+
+    struct MemoryBudgetStats
+    {
+        uint64_t enforcements = 0;  // Enforce calls that found usage over the ceiling
+        uint64_t idleTrims = 0;
+        uint64_t releasedBytes = 0; // by both
+    };
+
+    // Accounting and eviction policy for the large allocations the overlay
+    // keeps around. Holders register how to measure what they hold and, if
+    // it can be rebuilt, how to shrink it. Nothing is tracked per
+    // allocation: usage is measured when asked for, so holders keep
+    // allocating the way they always did.
+    //
+    // Enforce brings usage under the ceiling by shrinking regenerable,
+    // unpinned holders in category order. Separately, once nothing has changed for
+    // the idle timeout, IdleDue releases every regenerable holder; the
+    // owner then trims the working set. Like RenderScheduler this owns no
+    // timer: the owner arms its own from TimeUntilIdle.
+    //
+    // Not thread-safe; owned by the thread that paints.
+    class MemoryBudget
+    {
+    public:
+        static constexpr size_t DEFAULT_CEILING_BYTES = 64 * 1024 * 1024;
+        static constexpr int64_t DEFAULT_IDLE_US = 5 * 60 * 1000000LL;
+
+        // Bytes currently held.
+        using MeasureFn = std::function<size_t()>;
+
+        // Releases what can be rebuilt until at most keepBytes are held,
+        // least valuable first; 0 releases all of it. Holders that cannot
+        // free part of what they hold free all of it or nothing.
+        using ShrinkFn = std::function<void(size_t keepBytes)>;
+
+        // idleUs < 0 never trims for idleness.
+        MemoryBudget(const Clock& clock, size_t ceilingBytes = DEFAULT_CEILING_BYTES,
+                     int64_t idleUs = DEFAULT_IDLE_US);
+
+        // A holder without shrink is reported but never released. Holders
+        // must outlive the budget or stay measurable until it is gone.
+        void Register(MemoryCategory category, MeasureFn measure, ShrinkFn shrink = nullptr);
+
+        // A holder that only the idle trim releases, never Enforce: what is
+        // on screen now and would have to be rebuilt by the very next
+        // change. Its bytes still count against the ceiling, so the
+        // regenerable holders make room for it.
+        void RegisterPinned(MemoryCategory category, MeasureFn measure, ShrinkFn shrink);
+
+        void SetCeiling(size_t ceilingBytes);
+        size_t Ceiling() const { return ceiling; }
+        void SetIdleTimeout(int64_t idleUs);
+        int64_t IdleTimeout() const { return idle; }
+
+        MemoryUsage Usage() const;
+
+        // Shrinks regenerable holders, cheapest category first, until usage
+        // is at or under the ceiling or nothing regenerable is left.
+        // Returns the bytes released.
+        size_t Enforce();
+
+        // Something changed; the idle countdown restarts now.
+        void Touch();
+
+        // Microseconds until the idle trim is due: -1 when it already ran
+        // since the last Touch (or is disabled), 0 when it is due now.
+        int64_t TimeUntilIdle() const;
+
+        // When the idle trim is due, releases every regenerable holder and
+        // returns true; the owner trims the working set then.
+        bool IdleDue();
+
+        MemoryBudgetStats Stats() const { return stats; }
+
+        // Plain-text table: bytes per category and holder count, then the
+        // total against the ceiling.
+        std::string Report() const;
+
+    private:
+        struct Holder
+        {
+            MemoryCategory category;
+            MeasureFn measure;
+            ShrinkFn shrink;
+            bool pinned;    // released by the idle trim only
+        };
+
+        void Insert(Holder holder);
+
+        // Shrinks holders in eviction order until usage drops by excess;
+        // pinned ones only for the idle trim.
+        size_t Release(size_t excess, bool idle);
+
+        const Clock& clock;
+        size_t ceiling;
+        int64_t idle;
+        int64_t touchedAt;
+        bool trimmed = false;
+        std::vector<Holder> holders;    // in eviction order
+        MemoryBudgetStats stats;
+    };
+}
@@ -0,0 +1,69 @@
+#include "MonitorTopology.h"
+
+#include <algorithm>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        std::vector<MonitorDesc> SortedById(const std::vector<MonitorDesc>& monitors)
+        {
+            std::vector<MonitorDesc> sorted = monitors;
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const MonitorDesc& a, const MonitorDesc& b) { return a.id < b.id; });
+            return sorted;
+        }
+    }
+
+    TopologyDiff MonitorTopology::Diff(const std::vector<MonitorDesc>& before, const std::vector<MonitorDesc>& after)
+    {
+        // Merge walk over both snapshots sorted by id: O(n log n) for any
+        // number of displays.
+        const std::vector<MonitorDesc> oldSorted = SortedById(before);
+        const std::vector<MonitorDesc> newSorted = SortedById(after);
+
+        TopologyDiff diff;
+        size_t i = 0;
+        size_t j = 0;
+        while (i < oldSorted.size() || j < newSorted.size())
+        {
+            if (j == newSorted.size() || (i < oldSorted.size() && oldSorted[i].id < newSorted[j].id))
+            {
+                diff.removed.push_back(oldSorted[i++]);
+                continue;
+            }
+            if (i == oldSorted.size() || newSorted[j].id < oldSorted[i].id)
+            {
+                diff.added.push_back(newSorted[j++]);
+                continue;
+            }
+
+            const MonitorDesc& was = oldSorted[i++];
+            const MonitorDesc& now = newSorted[j++];
+            if (was.Width() != now.Width() || was.Height() != now.Height() || was.dpi != now.dpi)
+                diff.resized.push_back(now);
+            else if (was.left != now.left || was.top != now.top)
+                diff.moved.push_back(now);
+            else
+                diff.unchanged++;
+        }
+        return diff;
+    }
+
+    TopologyDiff MonitorTopology::Update(const std::vector<MonitorDesc>& current)
+    {
+        TopologyDiff diff = Diff(monitors, current);
+        monitors = current;
+        return diff;
+    }
+
+    const MonitorDesc* MonitorTopology::Find(uint64_t id) const
+    {
+        for (const MonitorDesc& monitor : monitors)
+        {
+            if (monitor.id == id)
+                return &monitor;
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "FrameTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace EdgeLight
+{
+    // What changed between two monitor snapshots. Monitors are matched by
+    // id; entries carry the new description (the old one for removed).
+    struct TopologyDiff
+    {
+        std::vector<MonitorDesc> added;
+        std::vector<MonitorDesc> removed;
+        std::vector<MonitorDesc> resized;   // work area size or DPI changed: needs a new surface
+        std::vector<MonitorDesc> moved;     // same size and DPI at a new position: only a reposition
+        size_t unchanged = 0;
+
+        bool Empty() const { return added.empty() && removed.empty() && resized.empty() && moved.empty(); }
+    };
+
+    // The last known set of monitors. Re-enumerate on every display change
+    // and feed the result to Update; only the monitors in the diff need any
+    // work. Any number of monitors is supported and the enumeration order
+    // does not matter.
+    class MonitorTopology
+    {
+    public:
+        static TopologyDiff Diff(const std::vector<MonitorDesc>& before, const std::vector<MonitorDesc>& after);
+
+        // Replaces the snapshot and returns what changed since the last one.
+        TopologyDiff Update(const std::vector<MonitorDesc>& current);
+
+        const std::vector<MonitorDesc>& Monitors() const { return monitors; }
+        const MonitorDesc* Find(uint64_t id) const;
+
+    private:
+        std::vector<MonitorDesc> monitors;
+    };
+}
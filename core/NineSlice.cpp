@@ -0,0 +1,344 @@
+#include "NineSlice.h"
+
+#include "FrameRenderer.h"
+#include "GlowEngine.h"
+#include "SdfFrameRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        bool SameShape(const FrameParams& a, const FrameParams& b)
+        {
+            return a.frameThickness == b.frameThickness &&
+                a.cornerRadius == b.cornerRadius &&
+                a.inset == b.inset &&
+                a.blurSize == b.blurSize &&
+                a.glowRadius == b.glowRadius &&
+                a.glowStrength == b.glowStrength;
+        }
+
+        uint8_t* MaskScratch(int width)
+        {
+            thread_local std::vector<uint8_t> scratch;
+            if (scratch.size() < static_cast<size_t>(width))
+                scratch.resize(width);
+            return scratch.data();
+        }
+    }
+
+    int NineSliceFrame::RequiredTileSize(const FrameParams& params)
+    {
+        // Past both corner arcs every column of the top band evaluates to
+        // the same distances, and past the reach of the dark hole's corner
+        // the interior is guaranteed black. The blurred glow then needs its
+        // extent again before columns stop depending on the corner.
+        const int innerRadius = std::max(MIN_INNER_RADIUS, params.cornerRadius - params.frameThickness);
+        const int reach = static_cast<int>(std::ceil(SdfFrameRenderer::LitReach(params)));
+        const int blur = params.glowRadius > 0 ? GlowEngine::Extent(params.glowRadius) : 0;
+
+        const int straight = std::max(params.inset + params.cornerRadius,
+                                      params.inset + params.frameThickness + innerRadius + reach);
+        return straight + 1 + blur;
+    }
+
+    void NineSliceFrame::Build(const FrameParams& params, SimdLevel level)
+    {
+        BuildWith(params, nullptr, level);
+    }
+
+    bool NineSliceFrame::Build(const FrameParams& params, IFrameRenderer& renderer)
+    {
+        return BuildWith(params, &renderer, DetectSimdLevel());
+    }
+
+    bool NineSliceFrame::BuildWith(const FrameParams& params, IFrameRenderer* renderer, SimdLevel level)
+    {
+        const auto renderMask = [&](const FrameParams& frame, const MaskBuffer& target)
+        {
+            if (renderer)
+                return renderer->RenderMask(frame, target);
+            SdfFrameRenderer::RenderMask(frame, target, level);
+            return true;
+        };
+
+        key = params;
+        built = true;
+
+        const int width = std::max(params.width, 0);
+        const int height = std::max(params.height, 0);
+        const int required = RequiredTileSize(params);
+
+        if (2 * required > width || 2 * required > height)
+        {
+            fullFrame = true;
+            tile = 0;
+            fullWidth = width;
+            fullHeight = height;
+            corner.assign(static_cast<size_t>(width) * height, 0);
+            topProfile.clear();
+            leftProfile.clear();
+            if (!renderMask(params, { corner.data(), width, height, width }))
+            {
+                Clear();
+                return false;
+            }
+            return true;
+        }
+
+        fullFrame = false;
+        tile = required;
+        fullWidth = 0;
+        fullHeight = 0;
+
+        // Render the top-left quadrant of a frame just big enough to hold
+        // the tile plus the blur's reach, so the glow sees the same
+        // neighbourhood it would in the full frame.
+        const int blur = params.glowRadius > 0 ? GlowEngine::Extent(params.glowRadius) : 0;
+        const int work = tile + blur + 1;
+        FrameParams quadrant = params;
+        quadrant.width = 2 * work;
+        quadrant.height = 2 * work;
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(work) * work);
+        if (!renderMask(quadrant, { pixels.data(), work, work, work }))
+        {
+            Clear();
+            return false;
+        }
+
+        corner.resize(static_cast<size_t>(tile) * tile);
+        topProfile.resize(tile);
+        leftProfile.resize(tile);
+        for (int y = 0; y < tile; y++)
+        {
+            std::memcpy(corner.data() + static_cast<size_t>(y) * tile, pixels.data() + static_cast<size_t>(y) * work, tile);
+            topProfile[y] = pixels[static_cast<size_t>(y) * work + tile];
+        }
+        std::memcpy(leftProfile.data(), pixels.data() + static_cast<size_t>(tile) * work, tile);
+        return true;
+    }
+
+    void NineSliceFrame::Clear()
+    {
+        built = false;
+        fullFrame = false;
+        tile = 0;
+        fullWidth = 0;
+        fullHeight = 0;
+        corner.clear();
+        topProfile.clear();
+        leftProfile.clear();
+    }
+
+    bool NineSliceFrame::Matches(const FrameParams& params) const
+    {
+        if (!built || !SameShape(key, params))
+            return false;
+
+        if (fullFrame)
+            return params.width == fullWidth && params.height == fullHeight;
+
+        return 2 * tile <= params.width && 2 * tile <= params.height;
+    }
+
+    size_t NineSliceFrame::ByteSize() const
+    {
+        return corner.capacity() + topProfile.capacity() + leftProfile.capacity();
+    }
+
+    bool NineSliceFrame::SourceSize(SlicePiece piece, int& width, int& height) const
+    {
+        if (!built)
+            return false;
+
+        if (fullFrame)
+        {
+            width = fullWidth;
+            height = fullHeight;
+            return piece == SlicePiece::TopLeft && width > 0 && height > 0;
+        }
+
+        switch (piece)
+        {
+        case SlicePiece::TopLeft:
+        case SlicePiece::TopRight:
+        case SlicePiece::BottomLeft:
+        case SlicePiece::BottomRight:
+            width = tile;
+            height = tile;
+            break;
+        case SlicePiece::Top:
+        case SlicePiece::Bottom:
+            width = 1;
+            height = tile;
+            break;
+        case SlicePiece::Left:
+        case SlicePiece::Right:
+            width = tile;
+            height = 1;
+            break;
+        default:
+            return false;
+        }
+        return tile > 0;
+    }
+
+    bool NineSliceFrame::Layout(SlicePiece piece, int width, int height, SliceLayout& layout) const
+    {
+        if (!SourceSize(piece, layout.sourceWidth, layout.sourceHeight))
+            return false;
+
+        const int c = tile;
+        switch (piece)
+        {
+        case SlicePiece::TopLeft:     layout.dest = fullFrame ? SpanRect{ 0, 0, fullWidth, fullHeight } : SpanRect{ 0, 0, c, c }; break;
+        case SlicePiece::TopRight:    layout.dest = { width - c, 0, width, c }; break;
+        case SlicePiece::BottomLeft:  layout.dest = { 0, height - c, c, height }; break;
+        case SlicePiece::BottomRight: layout.dest = { width - c, height - c, width, height }; break;
+        case SlicePiece::Top:         layout.dest = { c, 0, width - c, c }; break;
+        case SlicePiece::Bottom:      layout.dest = { c, height - c, width - c, height }; break;
+        case SlicePiece::Left:        layout.dest = { 0, c, c, height - c }; break;
+        case SlicePiece::Right:       layout.dest = { width - c, c, width, height - c }; break;
+        default:
+            return false;
+        }
+
+        return layout.dest.right > layout.dest.left && layout.dest.bottom > layout.dest.top;
+    }
+
+    uint8_t NineSliceFrame::SourceValue(SlicePiece piece, int x, int y) const
+    {
+        if (fullFrame)
+            return corner[static_cast<size_t>(y) * fullWidth + x];
+
+        const int last = tile - 1;
+        switch (piece)
+        {
+        case SlicePiece::TopLeft:     return corner[static_cast<size_t>(y) * tile + x];
+        case SlicePiece::TopRight:    return corner[static_cast<size_t>(y) * tile + (last - x)];
+        case SlicePiece::BottomLeft:  return corner[static_cast<size_t>(last - y) * tile + x];
+        case SlicePiece::BottomRight: return corner[static_cast<size_t>(last - y) * tile + (last - x)];
+        case SlicePiece::Top:         return topProfile[y];
+        case SlicePiece::Bottom:      return topProfile[last - y];
+        case SlicePiece::Left:        return leftProfile[x];
+        case SlicePiece::Right:       return leftProfile[last - x];
+        default:                      return 0;
+        }
+    }
+
+    void NineSliceFrame::SourceRow(SlicePiece piece, int y, int x0, int count, uint8_t* out) const
+    {
+        if (fullFrame)
+        {
+            std::memcpy(out, corner.data() + static_cast<size_t>(y) * fullWidth + x0, count);
+            return;
+        }
+
+        const int last = tile - 1;
+        const uint8_t* src = nullptr;
+        bool mirrored = false;
+        switch (piece)
+        {
+        case SlicePiece::TopLeft:     src = corner.data() + static_cast<size_t>(y) * tile; break;
+        case SlicePiece::TopRight:    src = corner.data() + static_cast<size_t>(y) * tile; mirrored = true; break;
+        case SlicePiece::BottomLeft:  src = corner.data() + static_cast<size_t>(last - y) * tile; break;
+        case SlicePiece::BottomRight: src = corner.data() + static_cast<size_t>(last - y) * tile; mirrored = true; break;
+        case SlicePiece::Left:        src = leftProfile.data(); break;
+        case SlicePiece::Right:       src = leftProfile.data(); mirrored = true; break;
+        default:
+            // Top and bottom cross-sections are stretched: one value per row.
+            std::memset(out, SourceValue(piece, 0, y), count);
+            return;
+        }
+
+        if (!mirrored)
+        {
+            std::memcpy(out, src + x0, count);
+            return;
+        }
+        for (int i = 0; i < count; i++)
+            out[i] = src[last - (x0 + i)];
+    }
+
+    void NineSliceFrame::RenderPiece(SlicePiece piece, const BgraBuffer& target, int level) const
+    {
+        int sourceWidth, sourceHeight;
+        if (!target.pixels || !SourceSize(piece, sourceWidth, sourceHeight))
+            return;
+
+        const SdfKernels& kernels = *GetSdfKernels(DetectSimdLevel());
+        uint8_t* row = MaskScratch(sourceWidth);
+        const int rows = std::min(sourceHeight, target.height);
+        const int cols = std::min(sourceWidth, target.width);
+
+        for (int y = 0; y < rows; y++)
+        {
+            SourceRow(piece, y, 0, cols, row);
+            kernels.expandRow(row, cols, level, reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride));
+        }
+    }
+
+    void NineSliceFrame::ComposeMask(const MaskBuffer& target) const
+    {
+        if (!target.pixels)
+            return;
+
+        for (int y = 0; y < target.height; y++)
+            std::memset(target.pixels + static_cast<size_t>(y) * target.stride, 0, target.width);
+
+        for (int p = 0; p < static_cast<int>(SlicePiece::Count); p++)
+        {
+            const SlicePiece piece = static_cast<SlicePiece>(p);
+            SliceLayout layout;
+            if (!Layout(piece, target.width, target.height, layout))
+                continue;
+
+            const SpanRect& d = layout.dest;
+            for (int y = std::max(d.top, 0); y < std::min(d.bottom, target.height); y++)
+            {
+                uint8_t* out = target.pixels + static_cast<size_t>(y) * target.stride;
+                const int sy = layout.sourceHeight == 1 ? 0 : y - d.top;
+                const int x0 = std::max(d.left, 0);
+                const int x1 = std::min(d.right, target.width);
+                if (x1 > x0)
+                    SourceRow(piece, sy, layout.sourceWidth == 1 ? 0 : x0 - d.left, x1 - x0, out + x0);
+            }
+        }
+    }
+
+    void NineSliceFrame::Compose(const BgraBuffer& target, int level) const
+    {
+        if (!target.pixels)
+            return;
+
+        const SdfKernels& kernels = *GetSdfKernels(DetectSimdLevel());
+        uint8_t* row = MaskScratch(target.width);
+
+        for (int p = 0; p < static_cast<int>(SlicePiece::Count); p++)
+        {
+            const SlicePiece piece = static_cast<SlicePiece>(p);
+            SliceLayout layout;
+            if (!Layout(piece, target.width, target.height, layout))
+                continue;
+
+            const int x0 = std::max(layout.dest.left, 0);
+            const int x1 = std::min(layout.dest.right, target.width);
+            if (x1 <= x0)
+                continue;
+
+            for (int y = std::max(layout.dest.top, 0); y < std::min(layout.dest.bottom, target.height); y++)
+            {
+                const int sy = layout.sourceHeight == 1 ? 0 : y - layout.dest.top;
+                SourceRow(piece, sy, layout.sourceWidth == 1 ? 0 : x0 - layout.dest.left, x1 - x0, row);
+
+                uint32_t* out = reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+                kernels.expandRow(row, x1 - x0, level, out + x0);
+            }
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "FrameTypes.h"
+#include "FrameSpans.h"
+#include "SdfKernels.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace EdgeLight
+{
+    class IFrameRenderer;
+
+    enum class SlicePiece
+    {
+        TopLeft,
+        TopRight,
+        BottomLeft,
+        BottomRight,
+        Top,
+        Bottom,
+        Left,
+        Right,
+        Count,
+    };
+
+    // Where a piece goes and how big its source image is. Edge pieces have
+    // a one pixel wide (top/bottom) or tall (left/right) source that is
+    // stretched over the destination.
+    struct SliceLayout
+    {
+        SpanRect dest;
+        int sourceWidth;
+        int sourceHeight;
+    };
+
+    // The frame as nine-slice pieces: one corner tile that is mirrored into
+    // the other three corners, plus one cross-section per edge orientation
+    // that is stretched along the straight runs. The interior is dark.
+    //
+    // Tiles only depend on the frame shape, not the work area size, so a
+    // resize or monitor switch reuses them as-is. Work areas too small to
+    // keep the corners apart fall back to a single full-frame tile.
+    class NineSliceFrame
+    {
+    public:
+        // Corner tile edge length needed for params, before the size check.
+        static int RequiredTileSize(const FrameParams& params);
+
+        void Build(const FrameParams& params, SimdLevel level = DetectSimdLevel());
+
+        // Same, with the tiles rasterized by renderer's backend. Returns
+        // false (and leaves the frame unbuilt) if the backend failed.
+        bool Build(const FrameParams& params, IFrameRenderer& renderer);
+        void Clear();
+
+        // True when the tiles can be composed at params' size without
+        // re-rasterizing.
+        bool Matches(const FrameParams& params) const;
+
+        bool IsFullFrame() const { return fullFrame; }
+        int TileSize() const { return tile; }
+        size_t ByteSize() const;
+
+        // Destination and source size of piece for a width x height frame.
+        // Returns false for pieces that are empty at that size.
+        bool Layout(SlicePiece piece, int width, int height, SliceLayout& layout) const;
+
+        // Writes piece's source image as grey BGRA scaled by level/255.
+        // target must be at least sourceWidth x sourceHeight.
+        void RenderPiece(SlicePiece piece, const BgraBuffer& target, int level) const;
+
+        // Full mask, interior included. Matches SdfFrameRenderer::RenderMask
+        // pixel for pixel.
+        void ComposeMask(const MaskBuffer& target) const;
+
+        // Writes every piece into target; the dark interior is left untouched.
+        void Compose(const BgraBuffer& target, int level) const;
+
+    private:
+        bool BuildWith(const FrameParams& params, IFrameRenderer* renderer, SimdLevel level);
+        bool SourceSize(SlicePiece piece, int& width, int& height) const;
+        uint8_t SourceValue(SlicePiece piece, int x, int y) const;
+
+        // count source values of row y starting at x0; stretched pieces
+        // repeat their single column.
+        void SourceRow(SlicePiece piece, int y, int x0, int count, uint8_t* out) const;
+
+        FrameParams key;
+        bool built = false;
+        bool fullFrame = false;
+        int tile = 0;
+        int fullWidth = 0;
+        int fullHeight = 0;
+        std::vector<uint8_t> corner;        // tile x tile, top-left corner (or the whole frame)
+        std::vector<uint8_t> topProfile;    // tile values, top edge intensity by row
+        std::vector<uint8_t> leftProfile;   // tile values, left edge intensity by column
+    };
+}
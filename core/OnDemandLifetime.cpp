@@ -0,0 +1,59 @@
+#include "OnDemandLifetime.h"
+
+#include <algorithm>
+
+namespace EdgeLight
+{
+    OnDemandLifetime::OnDemandLifetime(const Clock& clock, int64_t idleUs) :
+        clock(clock),
+        idle(idleUs)
+    {
+    }
+
+    void OnDemandLifetime::SetIdleTimeout(int64_t idleUs)
+    {
+        idle = idleUs;
+    }
+
+    bool OnDemandLifetime::Show()
+    {
+        visible = true;
+        if (exists)
+            return false;
+
+        exists = true;
+        creations++;
+        return true;
+    }
+
+    void OnDemandLifetime::Hide()
+    {
+        if (!visible)
+            return;
+        visible = false;
+        hiddenAt = clock.NowUs();
+    }
+
+    void OnDemandLifetime::Lost()
+    {
+        exists = false;
+        visible = false;
+    }
+
+    int64_t OnDemandLifetime::TimeUntilRelease() const
+    {
+        if (!exists || visible || idle < 0)
+            return -1;
+        return std::max<int64_t>(hiddenAt + idle - clock.NowUs(), 0);
+    }
+
+    bool OnDemandLifetime::ReleaseDue()
+    {
+        if (TimeUntilRelease() != 0)
+            return false;
+
+        exists = false;
+        releases++;
+        return true;
+    }
+}
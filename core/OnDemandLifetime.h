@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // Lifetime of a window that is only built the first time it is shown
+    // and torn down again once it has stayed hidden for a while, so a
+    // feature most users never open costs nothing at startup.
+    //
+    // Like RenderScheduler this owns no timer and no window: the owner
+    // creates the window when Show says so, arms its own timer from
+    // TimeUntilRelease and destroys the window when ReleaseDue says so.
+    class OnDemandLifetime
+    {
+    public:
+        static constexpr int64_t DEFAULT_IDLE_US = 60 * 1000000LL;
+
+        // idleUs < 0 keeps the window once created.
+        explicit OnDemandLifetime(const Clock& clock, int64_t idleUs = DEFAULT_IDLE_US);
+
+        void SetIdleTimeout(int64_t idleUs);
+        int64_t IdleTimeout() const { return idle; }
+
+        // Marks the window shown. Returns true when it does not exist yet
+        // and the caller has to create it first.
+        bool Show();
+
+        // Marks the window hidden; the idle countdown starts now.
+        void Hide();
+
+        // The window could not be created, or is gone for another reason.
+        void Lost();
+
+        bool Exists() const { return exists; }
+        bool Visible() const { return visible; }
+
+        // Microseconds until the hidden window is due for release: -1 when
+        // nothing is pending, 0 when it is due now.
+        int64_t TimeUntilRelease() const;
+
+        // True when the window has been hidden for the idle timeout; it
+        // then counts as gone and the caller destroys it.
+        bool ReleaseDue();
+
+        uint64_t Creations() const { return creations; }
+        uint64_t Releases() const { return releases; }
+
+    private:
+        const Clock& clock;
+        int64_t idle;
+        bool exists = false;
+        bool visible = false;
+        int64_t hiddenAt = 0;
+        uint64_t creations = 0;
+        uint64_t releases = 0;
+    };
+}
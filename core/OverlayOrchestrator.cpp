@@ -0,0 +1,72 @@
+#include "OverlayOrchestrator.h"
+
+#include "DpiScale.h"
+
+#include <unordered_map>
+
+namespace EdgeLight
+{
+    OverlayOrchestrator::OverlayOrchestrator(SurfaceCache& cache, WorkerPool& pool)
+        : cache(cache), pool(pool)
+    {
+    }
+
+    PrepareStats OverlayOrchestrator::Prepare(const std::vector<MonitorDesc>& monitors, const FrameParams& base,
+                                              const SurfaceRenderFn& render,
+                                              std::vector<std::shared_ptr<CachedSurface>>& surfaces,
+                                              uint32_t color)
+    {
+        PrepareStats stats;
+        stats.monitors = monitors.size();
+
+        // Distinct keys, and which one each monitor uses
+        keys.clear();
+        slots.clear();
+        std::unordered_map<SurfaceKey, int, SurfaceKeyHash> seen;
+        for (const MonitorDesc& monitor : monitors)
+        {
+            FrameParams params = ScaleFrameParams(base, monitor.dpi);
+            params.width = monitor.Width();
+            params.height = monitor.Height();
+            const SurfaceKey key = SurfaceKey::FromParams(params, DpiBucket(monitor.dpi), color);
+
+            auto found = seen.emplace(key, static_cast<int>(keys.size()));
+            if (found.second)
+                keys.push_back(key);
+            slots.push_back(found.first->second);
+        }
+        stats.uniqueSurfaces = keys.size();
+
+        unique.assign(keys.size(), nullptr);
+        missing.clear();
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            unique[i] = cache.Find(keys[i]);
+            if (!unique[i])
+                missing.push_back(static_cast<int>(i));
+        }
+
+        if (render)
+        {
+            pool.ParallelFor(static_cast<int>(missing.size()), [&](int i)
+            {
+                const int slot = missing[i];
+                unique[slot] = render(keys[slot]);
+            });
+
+            for (int slot : missing)
+            {
+                if (unique[slot])
+                {
+                    cache.Insert(keys[slot], unique[slot]);
+                    stats.rendered++;
+                }
+            }
+        }
+
+        surfaces.resize(monitors.size());
+        for (size_t i = 0; i < monitors.size(); i++)
+            surfaces[i] = unique[slots[i]];
+        return stats;
+    }
+}
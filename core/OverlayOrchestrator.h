@@ -0,0 +1,51 @@
+#pragma once
+
+#include "FrameTypes.h"
+#include "SurfaceCache.h"
+#include "WorkerPool.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace EdgeLight
+{
+    struct PrepareStats
+    {
+        size_t monitors = 0;
+        size_t uniqueSurfaces = 0;  // distinct keys among the monitors
+        size_t rendered = 0;        // cache misses rendered on the pool
+    };
+
+    // Finds the frame surface for every overlay of a multi-monitor setup.
+    // Monitors whose work area size and DPI bucket match share one surface,
+    // cached surfaces are reused, and only the missing ones are rendered, in
+    // parallel on the worker pool. With one surface per distinct geometry
+    // the cost of adding a monitor is one cache lookup unless its geometry
+    // is new.
+    //
+    // Prepare runs on the thread that owns the cache; only render is called
+    // from the pool.
+    class OverlayOrchestrator
+    {
+    public:
+        OverlayOrchestrator(SurfaceCache& cache, WorkerPool& pool);
+
+        // surfaces[i] is the surface for monitors[i], or nullptr when its
+        // render failed. base supplies everything but the size, in logical
+        // (96 DPI) pixels; it is scaled to each monitor's DPI. color goes
+        // into every key as is.
+        PrepareStats Prepare(const std::vector<MonitorDesc>& monitors, const FrameParams& base,
+                             const SurfaceRenderFn& render,
+                             std::vector<std::shared_ptr<CachedSurface>>& surfaces,
+                             uint32_t color = 0);
+
+    private:
+        SurfaceCache& cache;
+        WorkerPool& pool;
+        std::vector<SurfaceKey> keys;
+        std::vector<int> slots;
+        std::vector<std::shared_ptr<CachedSurface>> unique;
+        std::vector<int> missing;
+    };
+}
@@ -0,0 +1,72 @@
+#include "RenderScheduler.h"
+
+namespace EdgeLight
+{
+    RenderScheduler::RenderScheduler(const Clock& clock, int64_t intervalUs)
+        : clock(clock),
+        interval(intervalUs > 0 ? intervalUs : DEFAULT_INTERVAL_US),
+        lastRenderAt(INT64_MIN)
+    {
+    }
+
+    void RenderScheduler::SetInterval(int64_t intervalUs)
+    {
+        interval = intervalUs > 0 ? intervalUs : DEFAULT_INTERVAL_US;
+        if (dirty != DIRTY_NONE)
+            dueAt = NextBoundary(clock.NowUs());
+    }
+
+    int64_t RenderScheduler::NextBoundary(int64_t t) const
+    {
+        // First grid point strictly after t (floor division, t may be negative)
+        int64_t slot = t / interval;
+        if (t % interval < 0)
+            slot--;
+        int64_t next = (slot + 1) * interval;
+
+        // Never twice in the grid slot of the previous render, even when
+        // that render ran late.
+        if (lastRenderAt != INT64_MIN)
+        {
+            int64_t renderSlot = lastRenderAt / interval;
+            if (lastRenderAt % interval < 0)
+                renderSlot--;
+            const int64_t earliest = (renderSlot + 1) * interval;
+            if (next < earliest)
+                next = earliest;
+        }
+        return next;
+    }
+
+    void RenderScheduler::Invalidate(uint32_t flags)
+    {
+        if (flags == DIRTY_NONE)
+            return;
+
+        invalidations++;
+        if (dirty == DIRTY_NONE)
+            dueAt = NextBoundary(clock.NowUs());
+        dirty |= flags;
+    }
+
+    int64_t RenderScheduler::TimeUntilDue() const
+    {
+        if (dirty == DIRTY_NONE)
+            return -1;
+
+        const int64_t wait = dueAt - clock.NowUs();
+        return wait > 0 ? wait : 0;
+    }
+
+    uint32_t RenderScheduler::BeginFrame()
+    {
+        if (TimeUntilDue() != 0)
+            return DIRTY_NONE;
+
+        const uint32_t flags = dirty;
+        dirty = DIRTY_NONE;
+        lastRenderAt = clock.NowUs();
+        renders++;
+        return flags;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // What changed since the last render. Callers OR these together.
+    enum DirtyFlags : uint32_t
+    {
+        DIRTY_NONE = 0,
+        DIRTY_GEOMETRY = 1 << 0,    // size, thickness, color or visibility: repaint
+        DIRTY_BRIGHTNESS = 1 << 1,  // constant alpha only
+        DIRTY_PLACEMENT = 1 << 2,   // window moved to another work area
+    };
+
+    // Collects state changes and releases them at most once per display
+    // refresh interval. Renders land on the refresh grid (multiples of the
+    // interval on the clock), so any number of changes inside one interval
+    // become a single render at the end of it, and that render reads the
+    // latest state.
+    //
+    // The scheduler does not own a timer. The owner asks how long to wait,
+    // arms its own timer and calls BeginFrame when it fires.
+    class RenderScheduler
+    {
+    public:
+        static constexpr int64_t DEFAULT_INTERVAL_US = 16667;   // 60 Hz
+
+        explicit RenderScheduler(const Clock& clock, int64_t intervalUs = DEFAULT_INTERVAL_US);
+
+        void SetInterval(int64_t intervalUs);
+        int64_t Interval() const { return interval; }
+
+        void Invalidate(uint32_t flags);
+        bool IsDirty() const { return dirty != DIRTY_NONE; }
+
+        // Microseconds until the pending render is due: -1 when nothing is
+        // dirty, 0 when it is due now.
+        int64_t TimeUntilDue() const;
+
+        // When a render is due, returns the accumulated flags and clears
+        // them. Returns DIRTY_NONE (and changes nothing) otherwise.
+        uint32_t BeginFrame();
+
+        uint64_t Invalidations() const { return invalidations; }
+        uint64_t Renders() const { return renders; }
+
+    private:
+        int64_t NextBoundary(int64_t t) const;
+
+        const Clock& clock;
+        int64_t interval;
+        uint32_t dirty = DIRTY_NONE;
+        int64_t dueAt = 0;
+        int64_t lastRenderAt;
+        uint64_t invalidations = 0;
+        uint64_t renders = 0;
+    };
+}
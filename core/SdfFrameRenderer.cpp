@@ -0,0 +1,355 @@
+#include "SdfFrameRenderer.h"
+
+#include "FrameSpans.h"
+#include "GlowEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        // Stand-in for an empty rectangle: far enough away that it never
+        // wins the max() in the band distance.
+        constexpr float FAR_AWAY = -1.0e6f;
+
+        SdfRoundRect MakeSdfRect(int left, int top, int right, int bottom, int radius)
+        {
+            if (right <= left || bottom <= top)
+                return { FAR_AWAY, FAR_AWAY, 0.0f, 0.0f, 0.0f };
+
+            SdfRoundRect rr;
+            rr.centerX = (left + right) * 0.5f;
+            rr.centerY = (top + bottom) * 0.5f;
+            rr.halfWidth = (right - left) * 0.5f;
+            rr.halfHeight = (bottom - top) * 0.5f;
+            rr.radius = std::clamp(static_cast<float>(radius), 0.0f, std::min(rr.halfWidth, rr.halfHeight));
+            return rr;
+        }
+
+        const SdfKernels& KernelsFor(SimdLevel level)
+        {
+            const SdfKernels* kernels = GetSdfKernels(level);
+            return kernels ? *kernels : *GetSdfKernels(SimdLevel::Scalar);
+        }
+
+        // One intensity row per thread, reused across frames.
+        uint8_t* RowScratch(int width)
+        {
+            thread_local std::vector<uint8_t> scratch;
+            if (scratch.size() < static_cast<size_t>(width))
+                scratch.resize(width);
+            return scratch.data();
+        }
+
+        // Intensity plane for one glow rect or band, reused across frames.
+        MaskBuffer MaskScratch(int width, int height)
+        {
+            thread_local std::vector<uint8_t> scratch;
+            const size_t bytes = static_cast<size_t>(width) * height;
+            if (scratch.size() < bytes)
+                scratch.resize(bytes);
+            return { scratch.data(), width, height, width };
+        }
+
+        GlowEngine& ThreadGlowEngine()
+        {
+            thread_local GlowEngine engine;
+            return engine;
+        }
+
+        inline uint32_t* BgraRow(const BgraBuffer& target, int y)
+        {
+            return reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+        }
+
+        inline ExpandRowFn ExpandFor(const SdfKernels& kernels, const BgraBuffer& target)
+        {
+            return target.premultiplied ? kernels.expandPremultipliedRow : kernels.expandRow;
+        }
+
+        inline uint32_t DarkPixel(const BgraBuffer& target)
+        {
+            return target.premultiplied ? 0u : 0xFF000000u;
+        }
+
+        // Rows per band when a whole frame gets the blurred glow. The mask
+        // and the glow's 16-bit plane only ever cover one band plus the
+        // blur's reach above and below it, a few MB at 4K instead of
+        // three bytes per pixel of the frame; the reach is recomputed for
+        // each band, which costs a few percent.
+        constexpr int GLOW_BAND_ROWS = 256;
+
+        // Coverage of rect grown by GlowEngine::Extent along each axis
+        // (within the plane Render would blur), with the glow applied. The
+        // blur reaches that far, so the grown rect holds everything that
+        // feeds rect. The box passes pad with dark beyond it, which only
+        // disturbs its margin, never rect itself: rect's pixels match a
+        // blur of the whole plane. grown receives the rect the mask covers.
+        MaskBuffer GlowMask(const FrameParams& params, const SdfFrameShape& shape, const SdfKernels& kernels,
+                            const SpanRect& rect, int planeWidth, int planeHeight, SpanRect& grown)
+        {
+            const int extent = GlowEngine::Extent(params.glowRadius);
+            grown.left = std::max(rect.left - extent, 0);
+            grown.right = std::min(rect.right + extent, planeWidth);
+            grown.top = std::max(rect.top - extent, 0);
+            grown.bottom = std::min(rect.bottom + extent, planeHeight);
+
+            uint8_t* scratch = RowScratch(grown.right);
+            const MaskBuffer mask = MaskScratch(grown.right - grown.left, grown.bottom - grown.top);
+            for (int y = grown.top; y < grown.bottom; y++)
+            {
+                kernels.coverageRow(shape, y, grown.left, grown.right, scratch);
+                std::copy(scratch + grown.left, scratch + grown.right,
+                          mask.pixels + static_cast<size_t>(y - grown.top) * mask.stride);
+            }
+            ThreadGlowEngine().Apply(mask, params.glowRadius, params.glowStrength);
+            return mask;
+        }
+
+        // The blurred glow of rect, written to target at (rect.left - dx,
+        // rect.top - dy).
+        void RenderGlowRect(const FrameParams& params, const SdfFrameShape& shape, const SdfKernels& kernels,
+                            ExpandRowFn expand, const SpanRect& rect, int planeWidth, int planeHeight,
+                            const BgraBuffer& target, int dx, int dy)
+        {
+            const int opacity = std::clamp(params.opacity, 0, 255);
+            SpanRect grown;
+            const MaskBuffer mask = GlowMask(params, shape, kernels, rect, planeWidth, planeHeight, grown);
+            for (int y = rect.top; y < rect.bottom; y++)
+            {
+                expand(mask.pixels + static_cast<size_t>(y - grown.top) * mask.stride + (rect.left - grown.left),
+                       rect.right - rect.left, opacity, BgraRow(target, y - dy) + (rect.left - dx));
+            }
+        }
+    }
+
+    SdfFrameShape SdfFrameRenderer::BuildShape(const FrameParams& params)
+    {
+        const int inset = params.inset;
+        const int innerEdge = inset + params.frameThickness;
+        const int innerRadius = std::max(MIN_INNER_RADIUS, params.cornerRadius - params.frameThickness);
+        const int blurSize = std::clamp(params.blurSize, 0, 64);
+
+        SdfFrameShape shape;
+        shape.outer = MakeSdfRect(inset, inset, params.width - inset, params.height - inset, params.cornerRadius);
+        shape.inner = MakeSdfRect(innerEdge, innerEdge, params.width - innerEdge, params.height - innerEdge, innerRadius);
+
+        // Same falloff as the old 1px glow rings: ring i was lit at
+        // (blurSize - i + 1) / (blurSize + 3), now continuous in d.
+        shape.glowReach = static_cast<float>(blurSize + 1);
+        shape.glowScale = blurSize > 0 ? 1.0f / static_cast<float>(blurSize + 3) : 0.0f;
+        return shape;
+    }
+
+    float SdfFrameRenderer::LitReach(const FrameParams& params)
+    {
+        const SdfFrameShape shape = BuildShape(params);
+        float reach = shape.glowScale > 0.0f ? shape.glowReach : 0.5f;
+
+        // The box passes spread along both axes, so diagonally the blurred
+        // glow reaches sqrt(2) times its per-axis extent. They blur the
+        // falloff as well, so that extent comes on top of it.
+        if (params.glowRadius > 0 && params.glowStrength > 0)
+            reach += GlowEngine::Extent(params.glowRadius) * std::sqrt(2.0f);
+        return reach;
+    }
+
+    void SdfFrameRenderer::RenderMask(const FrameParams& params, const MaskBuffer& target, SimdLevel level)
+    {
+        if (!target.pixels || target.width <= 0 || target.height <= 0)
+            return;
+
+        const SdfFrameShape shape = BuildShape(params);
+        const SdfKernels& kernels = KernelsFor(level);
+
+        if (params.glowRadius > 0 && params.glowStrength > 0)
+        {
+            for (int top = 0; top < target.height; top += GLOW_BAND_ROWS)
+            {
+                const SpanRect band = { 0, top, target.width, std::min(top + GLOW_BAND_ROWS, target.height) };
+                SpanRect grown;
+                const MaskBuffer mask = GlowMask(params, shape, kernels, band, target.width, target.height, grown);
+                for (int y = band.top; y < band.bottom; y++)
+                {
+                    const uint8_t* row = mask.pixels + static_cast<size_t>(y - grown.top) * mask.stride;
+                    std::copy(row, row + target.width, target.pixels + static_cast<size_t>(y) * target.stride);
+                }
+            }
+            return;
+        }
+
+        for (int y = 0; y < target.height; y++)
+        {
+            kernels.coverageRow(shape, y, 0, target.width, target.pixels + static_cast<size_t>(y) * target.stride);
+        }
+    }
+
+    void SdfFrameRenderer::Render(const FrameParams& params, const BgraBuffer& target, SimdLevel level)
+    {
+        if (!target.pixels || target.width <= 0 || target.height <= 0)
+            return;
+
+        const int opacity = std::clamp(params.opacity, 0, 255);
+        if (opacity == 0)
+        {
+            for (int y = 0; y < target.height; y++)
+            {
+                uint32_t* row = BgraRow(target, y);
+                std::fill(row, row + target.width, DarkPixel(target));
+            }
+            return;
+        }
+
+        const SdfKernels& kernels = KernelsFor(level);
+        const ExpandRowFn expand = ExpandFor(kernels, target);
+        const SdfFrameShape shape = BuildShape(params);
+
+        if (params.glowRadius > 0 && params.glowStrength > 0)
+        {
+            for (int top = 0; top < target.height; top += GLOW_BAND_ROWS)
+            {
+                const SpanRect band = { 0, top, target.width, std::min(top + GLOW_BAND_ROWS, target.height) };
+                RenderGlowRect(params, shape, kernels, expand, band, target.width, target.height, target, 0, 0);
+            }
+            return;
+        }
+
+        uint8_t* scratch = RowScratch(target.width);
+
+        for (int y = 0; y < target.height; y++)
+        {
+            kernels.coverageRow(shape, y, 0, target.width, scratch);
+            expand(scratch, target.width, opacity, BgraRow(target, y));
+        }
+    }
+
+    void SdfFrameRenderer::RenderSpans(const FrameParams& params, const FrameSpans& spans, const BgraBuffer& target,
+                                       SimdLevel level)
+    {
+        if (!target.pixels || target.width < spans.Width() || target.height < spans.Height())
+            return;
+
+        const int opacity = std::clamp(params.opacity, 0, 255);
+        if (opacity == 0)
+        {
+            ClearSpans(spans, target);
+            return;
+        }
+
+        const SdfFrameShape shape = BuildShape(params);
+        const SdfKernels& kernels = KernelsFor(level);
+        const ExpandRowFn expand = ExpandFor(kernels, target);
+        uint8_t* scratch = RowScratch(spans.Width());
+
+        for (int y = 0; y < spans.Height(); y++)
+        {
+            uint32_t* row = BgraRow(target, y);
+            for (const Span* s = spans.RowBegin(y); s != spans.RowEnd(y); ++s)
+            {
+                kernels.coverageRow(shape, y, s->x0, s->x1, scratch);
+                expand(scratch + s->x0, s->x1 - s->x0, opacity, row + s->x0);
+            }
+        }
+    }
+
+    void SdfFrameRenderer::RenderRects(const FrameParams& params, const SpanRect* rects, size_t count,
+                                       const BgraBuffer& target, SimdLevel level)
+    {
+        if (!target.pixels)
+            return;
+
+        const int opacity = std::clamp(params.opacity, 0, 255);
+        const SdfFrameShape shape = BuildShape(params);
+        const SdfKernels& kernels = KernelsFor(level);
+        const ExpandRowFn expand = ExpandFor(kernels, target);
+        uint8_t* scratch = RowScratch(target.width);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const int x0 = std::max(rects[i].left, 0);
+            const int x1 = std::min(rects[i].right, target.width);
+            const int y0 = std::max(rects[i].top, 0);
+            const int y1 = std::min(rects[i].bottom, target.height);
+            if (x1 <= x0 || y1 <= y0)
+                continue;
+
+            if (opacity > 0 && params.glowRadius > 0)
+            {
+                RenderGlowRect(params, shape, kernels, expand, { x0, y0, x1, y1 }, target.width, target.height, target, 0, 0);
+                continue;
+            }
+
+            for (int y = y0; y < y1; y++)
+            {
+                uint32_t* row = BgraRow(target, y);
+                if (opacity == 0)
+                {
+                    std::fill(row + x0, row + x1, DarkPixel(target));
+                    continue;
+                }
+                kernels.coverageRow(shape, y, x0, x1, scratch);
+                expand(scratch + x0, x1 - x0, opacity, row + x0);
+            }
+        }
+    }
+
+    void SdfFrameRenderer::RenderRegion(const FrameParams& params, const SpanRect& region, const BgraBuffer& target,
+                                        SimdLevel level)
+    {
+        const int x0 = std::max(region.left, 0);
+        const int x1 = std::min(region.right, params.width);
+        const int y0 = std::max(region.top, 0);
+        const int y1 = std::min(region.bottom, params.height);
+        if (!target.pixels || x1 <= x0 || y1 <= y0 ||
+            target.width < region.right - region.left || target.height < region.bottom - region.top)
+        {
+            return;
+        }
+
+        const int opacity = std::clamp(params.opacity, 0, 255);
+        const SdfKernels& kernels = KernelsFor(level);
+        const ExpandRowFn expand = ExpandFor(kernels, target);
+        const int offset = x0 - region.left;
+
+        if (opacity == 0)
+        {
+            for (int y = y0; y < y1; y++)
+            {
+                uint32_t* row = BgraRow(target, y - region.top) + offset;
+                std::fill(row, row + (x1 - x0), DarkPixel(target));
+            }
+            return;
+        }
+
+        const SdfFrameShape shape = BuildShape(params);
+        if (params.glowRadius > 0)
+        {
+            RenderGlowRect(params, shape, kernels, expand, { x0, y0, x1, y1 }, params.width, params.height,
+                           target, region.left, region.top);
+            return;
+        }
+
+        uint8_t* scratch = RowScratch(params.width);
+        for (int y = y0; y < y1; y++)
+        {
+            kernels.coverageRow(shape, y, x0, x1, scratch);
+            expand(scratch + x0, x1 - x0, opacity, BgraRow(target, y - region.top) + offset);
+        }
+    }
+
+    void SdfFrameRenderer::ClearSpans(const FrameSpans& spans, const BgraBuffer& target)
+    {
+        if (!target.pixels || target.width < spans.Width() || target.height < spans.Height())
+            return;
+
+        for (int y = 0; y < spans.Height(); y++)
+        {
+            uint32_t* row = BgraRow(target, y);
+            for (const Span* s = spans.RowBegin(y); s != spans.RowEnd(y); ++s)
+                std::fill(row + s->x0, row + s->x1, DarkPixel(target));
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "FrameTypes.h"
+#include "SdfKernels.h"
+
+#include <cstddef>
+
+namespace EdgeLight
+{
+    class FrameSpans;
+    struct SpanRect;
+
+    // Anti-aliased frame renderer. Coverage is computed analytically from
+    // the signed distance to the outer and inner rounded rectangles, so a
+    // single pass produces smooth edges and the glow falloff together.
+    class SdfFrameRenderer
+    {
+    public:
+        static SdfFrameShape BuildShape(const FrameParams& params);
+
+        // Distance outside the frame band beyond which every pixel is dark,
+        // covering both the analytic falloff and the blurred glow.
+        static float LitReach(const FrameParams& params);
+
+        // Full-intensity mask, independent of params.opacity. Includes the
+        // blurred glow when params.glowRadius > 0.
+        static void RenderMask(const FrameParams& params, const MaskBuffer& target,
+                               SimdLevel level = DetectSimdLevel());
+
+        // Grey BGRA output scaled by params.opacity; dark pixels are black.
+        // A premultiplied target gets white with alpha instead, written
+        // straight into the caller's pixels (e.g. a DIB section) at its
+        // stride, so no intermediate buffer or copy is involved.
+        static void Render(const FrameParams& params, const BgraBuffer& target,
+                           SimdLevel level = DetectSimdLevel());
+
+        // Same output as Render, but only the pixels covered by spans are
+        // written. spans must have been built for params' geometry; pixels
+        // outside them are left untouched. The blurred glow needs whole
+        // neighbourhoods, so this path ignores params.glowRadius.
+        static void RenderSpans(const FrameParams& params, const FrameSpans& spans, const BgraBuffer& target,
+                                SimdLevel level = DetectSimdLevel());
+
+        // Same output as Render, but only inside rects (frame coordinates,
+        // clipped to target); everything else is left untouched. With the
+        // blurred glow each rect is rendered from a mask grown by the
+        // glow's extent, so the result still matches Render exactly.
+        static void RenderRects(const FrameParams& params, const SpanRect* rects, size_t count, const BgraBuffer& target,
+                                SimdLevel level = DetectSimdLevel());
+
+        // The pixels of region (frame coordinates) into target, whose top
+        // left is region's top left; one edge strip window's share of the
+        // frame. target must be at least region's size.
+        static void RenderRegion(const FrameParams& params, const SpanRect& region, const BgraBuffer& target,
+                                 SimdLevel level = DetectSimdLevel());
+
+        // Writes black (transparent when premultiplied) over every span
+        // pixel, undoing a previous RenderSpans.
+        static void ClearSpans(const FrameSpans& spans, const BgraBuffer& target);
+    };
+}
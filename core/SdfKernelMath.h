@@ -0,0 +1,37 @@
+#pragma once
+
+// Inline scalar helpers for the kernels and their callers. Kept out of
+// SdfKernels.h, which the AVX2 translation unit includes (see there).
+
+#include "SdfKernels.h"
+
+namespace EdgeLight
+{
+    namespace Kernels
+    {
+        // Shared scalar building blocks, also used for SIMD loop tails.
+        inline float RowTerm(const SdfRoundRect& rr, float py)
+        {
+            float qy = py - rr.centerY;
+            qy = qy < 0.0f ? -qy : qy;
+            return qy - (rr.halfHeight - rr.radius);
+        }
+
+        inline uint8_t ScaleLevel(uint8_t v, int level)
+        {
+            uint32_t t = uint32_t(v) * uint32_t(level) + 128u;
+            return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+        }
+
+        inline uint32_t WeightedLuma(uint32_t pixel)
+        {
+            return ((pixel >> 16) & 0xFF) * LUMA_RED + ((pixel >> 8) & 0xFF) * LUMA_GREEN + (pixel & 0xFF) * LUMA_BLUE;
+        }
+
+        inline uint8_t BlendLevel(uint8_t s, uint8_t d, int alpha)
+        {
+            uint32_t t = uint32_t(s) * uint32_t(alpha) + uint32_t(d) * uint32_t(255 - alpha) + 128u;
+            return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+        }
+    }
+}
@@ -0,0 +1,407 @@
+#include "SdfKernels.h"
+#include "SdfKernelMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if EDGELIGHT_X86
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace EdgeLight
+{
+    namespace
+    {
+        inline float SdRoundRect(const SdfRoundRect& rr, float qy, float py2, float px)
+        {
+            float qx = std::fabs(px - rr.centerX) - (rr.halfWidth - rr.radius);
+            float ox = qx > 0.0f ? qx : 0.0f;
+            float inside = qx > qy ? qx : qy;
+            inside = inside < 0.0f ? inside : 0.0f;
+            return std::sqrt(ox * ox + py2) + inside - rr.radius;
+        }
+
+        inline float Clamp01(float v)
+        {
+            v = v > 0.0f ? v : 0.0f;
+            return v < 1.0f ? v : 1.0f;
+        }
+
+#if EDGELIGHT_X86
+        // v * level / 255 with rounding for 16 intensities, exact for 8-bit
+        // inputs. Same result as ScaleLevel.
+        inline __m128i ScaleLevel16(__m128i m, __m128i level16)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i bias = _mm_set1_epi16(128);
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(m, zero), level16), bias);
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(m, zero), level16), bias);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            return _mm_packus_epi16(lo, hi);
+        }
+#endif
+
+#if EDGELIGHT_X86
+        bool CpuHasAvx2()
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+                return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        const SdfKernels SCALAR_KERNELS = { SimdLevel::Scalar, Kernels::CoverageRowScalar, Kernels::ExpandRowScalar, Kernels::BlendRowScalar,
+                                            Kernels::ExpandPremultipliedRowScalar, Kernels::ColorizeRowScalar,
+                                            Kernels::LumaRowScalar };
+#if EDGELIGHT_X86
+        const SdfKernels SSE2_KERNELS = { SimdLevel::Sse2, Kernels::CoverageRowSse2, Kernels::ExpandRowSse2, Kernels::BlendRowSse2,
+                                          Kernels::ExpandPremultipliedRowSse2, Kernels::ColorizeRowSse2,
+                                          Kernels::LumaRowSse2 };
+        const SdfKernels AVX2_KERNELS = { SimdLevel::Avx2, Kernels::CoverageRowAvx2, Kernels::ExpandRowSse2, Kernels::BlendRowSse2,
+                                          Kernels::ExpandPremultipliedRowSse2, Kernels::ColorizeRowAvx2,
+                                          Kernels::LumaRowAvx2 };
+#endif
+    }
+
+    SimdLevel DetectSimdLevel()
+    {
+#if EDGELIGHT_X86
+        static const SimdLevel level = CpuHasAvx2() ? SimdLevel::Avx2 : SimdLevel::Sse2;
+        return level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    const SdfKernels* GetSdfKernels(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar:
+            return &SCALAR_KERNELS;
+#if EDGELIGHT_X86
+        case SimdLevel::Sse2:
+            return &SSE2_KERNELS;
+        case SimdLevel::Avx2:
+            return DetectSimdLevel() == SimdLevel::Avx2 ? &AVX2_KERNELS : nullptr;
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    namespace Kernels
+    {
+        void CoverageRowScalar(const SdfFrameShape& shape, int y, int x0, int x1, uint8_t* out)
+        {
+            const float py = y + 0.5f;
+            const float oqy = RowTerm(shape.outer, py);
+            const float iqy = RowTerm(shape.inner, py);
+            const float oy = oqy > 0.0f ? oqy : 0.0f;
+            const float iy = iqy > 0.0f ? iqy : 0.0f;
+            const float oy2 = oy * oy;
+            const float iy2 = iy * iy;
+
+            for (int x = x0; x < x1; x++)
+            {
+                const float px = x + 0.5f;
+                const float dOuter = SdRoundRect(shape.outer, oqy, oy2, px);
+                const float dInner = SdRoundRect(shape.inner, iqy, iy2, px);
+                const float d = dOuter > -dInner ? dOuter : -dInner;
+
+                const float coverage = Clamp01(0.5f - d);
+                const float glow = Clamp01((shape.glowReach - d) * shape.glowScale);
+                const float v = coverage > glow ? coverage : glow;
+                out[x] = static_cast<uint8_t>(static_cast<int>(v * 255.0f + 0.5f));
+            }
+        }
+
+        void ExpandRowScalar(const uint8_t* mask, int count, int level, uint32_t* out)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                const uint32_t v = ScaleLevel(mask[i], level);
+                out[i] = 0xFF000000u | (v << 16) | (v << 8) | v;
+            }
+        }
+
+        void ExpandPremultipliedRowScalar(const uint8_t* mask, int count, int level, uint32_t* out)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                const uint32_t v = ScaleLevel(mask[i], level);
+                out[i] = (v << 24) | (v << 16) | (v << 8) | v;
+            }
+        }
+
+        void ColorizeRowScalar(uint32_t* pixels, int count, const uint32_t* lut, int shift)
+        {
+            for (int i = 0; i < count; i++)
+                pixels[i] = lut[(pixels[i] >> shift) & 0xFF];
+        }
+
+        uint64_t LumaRowScalar(const uint32_t* pixels, int count, int step)
+        {
+            uint64_t sum = 0;
+            for (int i = 0; i < count; i++)
+                sum += WeightedLuma(pixels[static_cast<size_t>(i) * step]);
+            return sum;
+        }
+
+        void BlendRowScalar(const uint32_t* src, int count, int alpha, uint32_t* dst)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                const uint32_t s = src[i];
+                const uint32_t d = dst[i];
+                uint32_t result = 0;
+                for (int shift = 0; shift < 32; shift += 8)
+                {
+                    const uint8_t c = BlendLevel(static_cast<uint8_t>(s >> shift), static_cast<uint8_t>(d >> shift), alpha);
+                    result |= uint32_t(c) << shift;
+                }
+                dst[i] = result;
+            }
+        }
+
+#if EDGELIGHT_X86
+        void CoverageRowSse2(const SdfFrameShape& shape, int y, int x0, int x1, uint8_t* out)
+        {
+            const float py = y + 0.5f;
+            const float oqy = RowTerm(shape.outer, py);
+            const float iqy = RowTerm(shape.inner, py);
+            const float oy = oqy > 0.0f ? oqy : 0.0f;
+            const float iy = iqy > 0.0f ? iqy : 0.0f;
+
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 half = _mm_set1_ps(0.5f);
+            const __m128 scale255 = _mm_set1_ps(255.0f);
+
+            const __m128 oCx = _mm_set1_ps(shape.outer.centerX);
+            const __m128 oKx = _mm_set1_ps(shape.outer.halfWidth - shape.outer.radius);
+            const __m128 oR = _mm_set1_ps(shape.outer.radius);
+            const __m128 oQy = _mm_set1_ps(oqy);
+            const __m128 oY2 = _mm_set1_ps(oy * oy);
+
+            const __m128 iCx = _mm_set1_ps(shape.inner.centerX);
+            const __m128 iKx = _mm_set1_ps(shape.inner.halfWidth - shape.inner.radius);
+            const __m128 iR = _mm_set1_ps(shape.inner.radius);
+            const __m128 iQy = _mm_set1_ps(iqy);
+            const __m128 iY2 = _mm_set1_ps(iy * iy);
+
+            const __m128 reach = _mm_set1_ps(shape.glowReach);
+            const __m128 glowScale = _mm_set1_ps(shape.glowScale);
+
+            __m128 px = _mm_setr_ps(x0 + 0.5f, x0 + 1.5f, x0 + 2.5f, x0 + 3.5f);
+            const __m128 step = _mm_set1_ps(4.0f);
+
+            int x = x0;
+            for (; x + 4 <= x1; x += 4)
+            {
+                __m128 qx = _mm_sub_ps(_mm_and_ps(_mm_sub_ps(px, oCx), absMask), oKx);
+                __m128 ox = _mm_max_ps(qx, zero);
+                __m128 inside = _mm_min_ps(_mm_max_ps(qx, oQy), zero);
+                __m128 dOuter = _mm_sub_ps(_mm_add_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ox, ox), oY2)), inside), oR);
+
+                qx = _mm_sub_ps(_mm_and_ps(_mm_sub_ps(px, iCx), absMask), iKx);
+                ox = _mm_max_ps(qx, zero);
+                inside = _mm_min_ps(_mm_max_ps(qx, iQy), zero);
+                __m128 dInner = _mm_sub_ps(_mm_add_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ox, ox), iY2)), inside), iR);
+
+                __m128 d = _mm_max_ps(dOuter, _mm_sub_ps(zero, dInner));
+                __m128 coverage = _mm_min_ps(_mm_max_ps(_mm_sub_ps(half, d), zero), one);
+                __m128 glow = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(reach, d), glowScale), zero), one);
+                __m128 v = _mm_max_ps(coverage, glow);
+
+                __m128i i32 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale255), half));
+                __m128i i16 = _mm_packs_epi32(i32, i32);
+                __m128i i8 = _mm_packus_epi16(i16, i16);
+                const int packed = _mm_cvtsi128_si32(i8);
+                std::memcpy(out + x, &packed, 4);
+
+                px = _mm_add_ps(px, step);
+            }
+
+            if (x < x1)
+                CoverageRowScalar(shape, y, x, x1, out);
+        }
+
+        void ExpandRowSse2(const uint8_t* mask, int count, int level, uint32_t* out)
+        {
+            const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+            const __m128i level16 = _mm_set1_epi16(static_cast<short>(level));
+
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i v = ScaleLevel16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i)), level16);
+
+                // v v v ff per pixel
+                __m128i vvLo = _mm_unpacklo_epi8(v, v);
+                __m128i vaLo = _mm_unpacklo_epi8(v, alpha);
+                __m128i vvHi = _mm_unpackhi_epi8(v, v);
+                __m128i vaHi = _mm_unpackhi_epi8(v, alpha);
+
+                __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+                _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(vvLo, vaLo));
+                _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(vvLo, vaLo));
+                _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(vvHi, vaHi));
+                _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(vvHi, vaHi));
+            }
+
+            if (i < count)
+                ExpandRowScalar(mask + i, count - i, level, out + i);
+        }
+
+        void ExpandPremultipliedRowSse2(const uint8_t* mask, int count, int level, uint32_t* out)
+        {
+            const __m128i level16 = _mm_set1_epi16(static_cast<short>(level));
+
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i v = ScaleLevel16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i)), level16);
+
+                // v v v v per pixel
+                __m128i vvLo = _mm_unpacklo_epi8(v, v);
+                __m128i vvHi = _mm_unpackhi_epi8(v, v);
+
+                __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+                _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(vvLo, vvLo));
+                _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(vvLo, vvLo));
+                _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(vvHi, vvHi));
+                _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(vvHi, vvHi));
+            }
+
+            if (i < count)
+                ExpandPremultipliedRowScalar(mask + i, count - i, level, out + i);
+        }
+
+        void BlendRowSse2(const uint32_t* src, int count, int alpha, uint32_t* dst)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i alpha16 = _mm_set1_epi16(static_cast<short>(alpha));
+            const __m128i inverse16 = _mm_set1_epi16(static_cast<short>(255 - alpha));
+            const __m128i bias = _mm_set1_epi16(128);
+
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+                // Both products fit an unsigned 16-bit lane (255 * 255 + 128).
+                __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), alpha16),
+                                           _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverse16));
+                __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), alpha16),
+                                           _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverse16));
+                lo = _mm_add_epi16(lo, bias);
+                hi = _mm_add_epi16(hi, bias);
+                lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+            }
+
+            if (i < count)
+                BlendRowScalar(src + i, count - i, alpha, dst + i);
+        }
+
+        // SSE2 has no gather, so mixed groups are looked up one by one. Most
+        // of a frame is dark or fully lit though, and groups of four of
+        // either are filled with one store.
+        void ColorizeRowSse2(uint32_t* pixels, int count, const uint32_t* lut, int shift)
+        {
+            const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+            const __m128i byteMask = _mm_set1_epi32(0xFF);
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i dark = _mm_set1_epi32(static_cast<int>(lut[0]));
+            const __m128i lit = _mm_set1_epi32(static_cast<int>(lut[255]));
+
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i* p = reinterpret_cast<__m128i*>(pixels + i);
+                const __m128i index = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p), shiftCount), byteMask);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(index, zero)) == 0xFFFF)
+                {
+                    _mm_storeu_si128(p, dark);
+                    continue;
+                }
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(index, byteMask)) == 0xFFFF)
+                {
+                    _mm_storeu_si128(p, lit);
+                    continue;
+                }
+
+                alignas(16) uint32_t lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), index);
+                _mm_storeu_si128(p, _mm_setr_epi32(static_cast<int>(lut[lanes[0]]), static_cast<int>(lut[lanes[1]]),
+                                                   static_cast<int>(lut[lanes[2]]), static_cast<int>(lut[lanes[3]])));
+            }
+
+            if (i < count)
+                ColorizeRowScalar(pixels + i, count - i, lut, shift);
+        }
+
+        // Bytes widened to 16 bits and multiplied by (blue, green, red, 0)
+        // in pairs, so each 32-bit lane gains at most 2 x 255 x (19 + 183)
+        // per group; flushing every LUMA_FLUSH_GROUPS groups keeps the lanes
+        // far from overflowing.
+        constexpr int LUMA_FLUSH_GROUPS = 4096;
+
+        uint64_t LumaRowSse2(const uint32_t* pixels, int count, int step)
+        {
+            const __m128i weights = _mm_setr_epi16(LUMA_BLUE, LUMA_GREEN, LUMA_RED, 0, LUMA_BLUE, LUMA_GREEN, LUMA_RED, 0);
+            const __m128i zero = _mm_setzero_si128();
+
+            uint64_t sum = 0;
+            int i = 0;
+            while (i + 4 <= count)
+            {
+                __m128i acc = zero;
+                const int end = std::min(count & ~3, i + 4 * LUMA_FLUSH_GROUPS);
+                for (; i < end; i += 4)
+                {
+                    const uint32_t* p = pixels + static_cast<size_t>(i) * step;
+                    const __m128i quad = step == 1
+                        ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+                        : _mm_setr_epi32(static_cast<int>(p[0]), static_cast<int>(p[step]),
+                                         static_cast<int>(p[2 * step]), static_cast<int>(p[3 * step]));
+                    acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(quad, zero), weights));
+                    acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(quad, zero), weights));
+                }
+
+                alignas(16) uint32_t lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+                sum += uint64_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+            }
+
+            if (i < count)
+                sum += LumaRowScalar(pixels + static_cast<size_t>(i) * step, count - i, step);
+            return sum;
+        }
+#endif
+    }
+}
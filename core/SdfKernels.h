@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define EDGELIGHT_X86 1
+#endif
+
+namespace EdgeLight
+{
+    enum class SimdLevel
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+    };
+
+    // Rounded rectangle in center / half-extent form, which is what the
+    // signed distance function wants. radius is already clamped to the
+    // half extents.
+    struct SdfRoundRect
+    {
+        float centerX;
+        float centerY;
+        float halfWidth;
+        float halfHeight;
+        float radius;
+    };
+
+    // Frame band = inside outer and outside inner. Glow is a linear
+    // falloff outside the band: max(0, (glowReach - d) * glowScale).
+    struct SdfFrameShape
+    {
+        SdfRoundRect outer;
+        SdfRoundRect inner;
+        float glowReach;
+        float glowScale;
+    };
+
+    // Writes the 0..255 intensity of pixels [x0, x1) of row y into out[x0..x1).
+    using SdfCoverageRowFn = void (*)(const SdfFrameShape& shape, int y, int x0, int x1, uint8_t* out);
+
+    // Expands an intensity row into grey BGRA pixels scaled by level/255.
+    // The premultiplied variant writes white with alpha = that grey, so
+    // dark pixels come out transparent.
+    using ExpandRowFn = void (*)(const uint8_t* mask, int count, int level, uint32_t* out);
+
+    // dst = (src * alpha + dst * (255 - alpha)) / 255 per channel, rounded.
+    // What the compositor does with a constant source alpha.
+    using BlendRowFn = void (*)(const uint32_t* src, int count, int alpha, uint32_t* dst);
+
+    // pixels[i] = lut[(pixels[i] >> shift) & 0xFF] in place: one table
+    // lookup per pixel, indexed by the byte at shift (0 = blue of a grey
+    // pixel, 24 = alpha of a premultiplied one).
+    using ColorizeRowFn = void (*)(uint32_t* pixels, int count, const uint32_t* lut, int shift);
+
+    // Sum of 256 x Rec. 709 luma over count pixels read step pixels apart
+    // (pixels[0], pixels[step], ...); alpha is ignored.
+    using LumaRowFn = uint64_t (*)(const uint32_t* pixels, int count, int step);
+
+    struct SdfKernels
+    {
+        SimdLevel level;
+        SdfCoverageRowFn coverageRow;
+        ExpandRowFn expandRow;
+        BlendRowFn blendRow;
+        ExpandRowFn expandPremultipliedRow;
+        ColorizeRowFn colorizeRow;
+        LumaRowFn lumaRow;
+    };
+
+    // Best level supported by both the build and the running CPU.
+    SimdLevel DetectSimdLevel();
+
+    // Kernel table for level, or nullptr when the level is not compiled in
+    // or not supported by this CPU.
+    const SdfKernels* GetSdfKernels(SimdLevel level);
+
+    namespace Kernels
+    {
+        void CoverageRowScalar(const SdfFrameShape& shape, int y, int x0, int x1, uint8_t* out);
+        void ExpandRowScalar(const uint8_t* mask, int count, int level, uint32_t* out);
+        void BlendRowScalar(const uint32_t* src, int count, int alpha, uint32_t* dst);
+        void ExpandPremultipliedRowScalar(const uint8_t* mask, int count, int level, uint32_t* out);
+        void ColorizeRowScalar(uint32_t* pixels, int count, const uint32_t* lut, int shift);
+        uint64_t LumaRowScalar(const uint32_t* pixels, int count, int step);
+#if EDGELIGHT_X86
+        void CoverageRowSse2(const SdfFrameShape& shape, int y, int x0, int x1, uint8_t* out);
+        void ExpandRowSse2(const uint8_t* mask, int count, int level, uint32_t* out);
+        void BlendRowSse2(const uint32_t* src, int count, int alpha, uint32_t* dst);
+        void ExpandPremultipliedRowSse2(const uint8_t* mask, int count, int level, uint32_t* out);
+        void ColorizeRowSse2(uint32_t* pixels, int count, const uint32_t* lut, int shift);
+        uint64_t LumaRowSse2(const uint32_t* pixels, int count, int step);
+        void CoverageRowAvx2(const SdfFrameShape& shape, int y, int x0, int x1, uint8_t* out);
+        void ColorizeRowAvx2(uint32_t* pixels, int count, const uint32_t* lut, int shift);
+        uint64_t LumaRowAvx2(const uint32_t* pixels, int count, int step);
+#endif
+
+        // Rec. 709 luma weights in 1/256ths; they add up to 256
+        constexpr uint32_t LUMA_RED = 54;
+        constexpr uint32_t LUMA_GREEN = 183;
+        constexpr uint32_t LUMA_BLUE = 19;
+    }
+}
@@ -0,0 +1,64 @@
+#include "StartupTimeline.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace EdgeLight
+{
+    StartupTimeline::StartupTimeline(const Clock& clock) :
+        clock(clock),
+        origin(clock.NowUs())
+    {
+        phases.reserve(16);
+    }
+
+    void StartupTimeline::Record(const char* name, int64_t startUs, int64_t endUs)
+    {
+        phases.push_back({ name, startUs - origin, std::max<int64_t>(endUs - startUs, 0) });
+    }
+
+    bool StartupTimeline::Milestone(const char* name)
+    {
+        if (Has(name))
+            return false;
+        Record(name, origin, clock.NowUs());
+        return true;
+    }
+
+    bool StartupTimeline::Has(const char* name) const
+    {
+        for (const StartupPhase& phase : phases)
+        {
+            if (std::strcmp(phase.name, name) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    int64_t StartupTimeline::ElapsedUs() const
+    {
+        return clock.NowUs() - origin;
+    }
+
+    std::string StartupTimeline::Report() const
+    {
+        std::string report;
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-24s %10s %10s\n", "startup phase", "start-ms", "ms");
+        report += line;
+
+        int64_t end = 0;
+        for (const StartupPhase& phase : phases)
+        {
+            std::snprintf(line, sizeof(line), "%-24s %10.2f %10.2f\n", phase.name,
+                          phase.startUs / 1000.0, phase.durationUs / 1000.0);
+            report += line;
+            end = std::max(end, phase.startUs + phase.durationUs);
+        }
+
+        std::snprintf(line, sizeof(line), "%-24s %10s %10.2f\n", "total", "", end / 1000.0);
+        report += line;
+        return report;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EdgeLight
+{
+    struct StartupPhase
+    {
+        const char* name;       // string literal
+        int64_t startUs;        // since the timeline started
+        int64_t durationUs;
+    };
+
+    // Where startup time goes: named phases on an injectable clock, kept
+    // in the order they finished, plus milestones like the first paint
+    // that count from the start. Phases may nest.
+    //
+    // Not thread-safe; startup runs on the UI thread.
+    class StartupTimeline
+    {
+    public:
+        // Starts now.
+        explicit StartupTimeline(const Clock& clock);
+
+        void Record(const char* name, int64_t startUs, int64_t endUs);
+
+        // Records name from the timeline start until now, the first time
+        // only. Returns whether it was recorded.
+        bool Milestone(const char* name);
+
+        bool Has(const char* name) const;
+        const std::vector<StartupPhase>& Phases() const { return phases; }
+
+        // Clock time the timeline started at, time since then, and the
+        // clock's current time.
+        int64_t StartUs() const { return origin; }
+        int64_t ElapsedUs() const;
+        int64_t NowUs() const { return clock.NowUs(); }
+
+        // Plain-text table, one phase per line with start and duration in
+        // milliseconds, then the end of the last phase as the total.
+        std::string Report() const;
+
+    private:
+        const Clock& clock;
+        int64_t origin;
+        std::vector<StartupPhase> phases;
+    };
+
+    // Records the rest of the enclosing scope as a phase.
+    class StartupPhaseScope
+    {
+    public:
+        StartupPhaseScope(StartupTimeline& timeline, const char* name) :
+            timeline(timeline),
+            name(name),
+            start(timeline.NowUs())
+        {
+        }
+
+        ~StartupPhaseScope()
+        {
+            timeline.Record(name, start, timeline.NowUs());
+        }
+
+        StartupPhaseScope(const StartupPhaseScope&) = delete;
+        StartupPhaseScope& operator=(const StartupPhaseScope&) = delete;
+
+    private:
+        StartupTimeline& timeline;
+        const char* name;
+        int64_t start;
+    };
+}
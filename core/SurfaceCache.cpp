@@ -0,0 +1,167 @@
+#include "SurfaceCache.h"
+
+namespace EdgeLight
+{
+    SurfaceKey SurfaceKey::FromParams(const FrameParams& params, int dpi, uint32_t color)
+    {
+        SurfaceKey key;
+        key.width = params.width;
+        key.height = params.height;
+        key.thickness = params.frameThickness;
+        key.radius = params.cornerRadius;
+        key.inset = params.inset;
+        key.blur = params.blurSize;
+        key.glowRadius = params.glowRadius;
+        key.glowStrength = params.glowRadius > 0 ? params.glowStrength : 0;
+        key.dpi = dpi;
+        key.color = color;
+        return key;
+    }
+
+    FrameParams SurfaceKey::ToParams() const
+    {
+        FrameParams params;
+        params.width = width;
+        params.height = height;
+        params.frameThickness = thickness;
+        params.cornerRadius = radius;
+        params.inset = inset;
+        params.blurSize = blur;
+        params.glowRadius = glowRadius;
+        if (glowRadius > 0)
+            params.glowStrength = glowStrength;
+        return params;
+    }
+
+    bool SurfaceKey::operator==(const SurfaceKey& other) const
+    {
+        return width == other.width &&
+            height == other.height &&
+            thickness == other.thickness &&
+            radius == other.radius &&
+            inset == other.inset &&
+            blur == other.blur &&
+            glowRadius == other.glowRadius &&
+            glowStrength == other.glowStrength &&
+            dpi == other.dpi &&
+            color == other.color;
+    }
+
+    size_t SurfaceKeyHash::operator()(const SurfaceKey& key) const
+    {
+        // FNV-1a over the fields
+        const int fields[] = {
+            key.width, key.height, key.thickness, key.radius, key.inset,
+            key.blur, key.glowRadius, key.glowStrength, key.dpi, static_cast<int>(key.color),
+        };
+
+        uint64_t hash = 14695981039346656037ull;
+        for (int field : fields)
+        {
+            hash ^= static_cast<uint32_t>(field);
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    SurfaceCache::SurfaceCache(size_t budgetBytes)
+        : budget(budgetBytes)
+    {
+    }
+
+    std::shared_ptr<CachedSurface> SurfaceCache::Find(const SurfaceKey& key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            misses++;
+            return nullptr;
+        }
+
+        hits++;
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->surface;
+    }
+
+    std::shared_ptr<CachedSurface> SurfaceCache::Acquire(const SurfaceKey& key, const SurfaceRenderFn& render)
+    {
+        if (std::shared_ptr<CachedSurface> cached = Find(key))
+            return cached;
+
+        std::shared_ptr<CachedSurface> surface = render ? render(key) : nullptr;
+        if (surface)
+            Insert(key, surface);
+        return surface;
+    }
+
+    void SurfaceCache::Insert(const SurfaceKey& key, const std::shared_ptr<CachedSurface>& surface)
+    {
+        if (!surface)
+            return;
+
+        auto existing = index.find(key);
+        if (existing != index.end())
+        {
+            bytes -= existing->second->bytes;
+            entries.erase(existing->second);
+            index.erase(existing);
+        }
+
+        const size_t size = surface->ByteSize();
+        if (size > budget)
+            return;
+
+        EvictTo(budget - size);
+        entries.push_front({ key, surface, size });
+        index[key] = entries.begin();
+        bytes += size;
+    }
+
+    void SurfaceCache::EvictTo(size_t limit)
+    {
+        while (bytes > limit && !entries.empty())
+        {
+            const Entry& victim = entries.back();
+            bytes -= victim.bytes;
+            index.erase(victim.key);
+            entries.pop_back();
+            evictions++;
+        }
+    }
+
+    void SurfaceCache::SetBudget(size_t budgetBytes)
+    {
+        budget = budgetBytes;
+        EvictTo(budget);
+    }
+
+    void SurfaceCache::Trim(size_t keepBytes)
+    {
+        EvictTo(keepBytes);
+    }
+
+    void SurfaceCache::Clear()
+    {
+        entries.clear();
+        index.clear();
+        bytes = 0;
+    }
+
+    void SurfaceCache::ResetStats()
+    {
+        hits = 0;
+        misses = 0;
+        evictions = 0;
+    }
+
+    SurfaceCacheStats SurfaceCache::Stats() const
+    {
+        SurfaceCacheStats stats;
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.evictions = evictions;
+        stats.bytes = bytes;
+        stats.entries = entries.size();
+        return stats;
+    }
+}
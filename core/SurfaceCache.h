@@ -0,0 +1,121 @@
+#pragma once
+
+#include "FrameTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace EdgeLight
+{
+    // Everything a rendered frame surface depends on. Opacity is not part of
+    // it: brightness is applied at present time.
+    struct SurfaceKey
+    {
+        int width = 0;
+        int height = 0;
+        int thickness = 0;
+        int radius = 0;
+        int inset = 0;
+        int blur = 0;
+        int glowRadius = 0;
+        int glowStrength = 0;
+        int dpi = 96;
+        uint32_t color = 0;     // ColorSettings::Key() of the colors baked in, 0 for grey
+
+        static SurfaceKey FromParams(const FrameParams& params, int dpi, uint32_t color = 0);
+
+        // Params that render this key's geometry, at full opacity.
+        FrameParams ToParams() const;
+
+        bool operator==(const SurfaceKey& other) const;
+        bool operator!=(const SurfaceKey& other) const { return !(*this == other); }
+    };
+
+    struct SurfaceKeyHash
+    {
+        size_t operator()(const SurfaceKey& key) const;
+    };
+
+    // Anything the cache can hold. ByteSize is charged against the budget
+    // and must not change while the surface is cached.
+    class CachedSurface
+    {
+    public:
+        virtual ~CachedSurface() = default;
+        virtual size_t ByteSize() const = 0;
+    };
+
+    // Renders the surface for a key on a cache miss. May return nullptr when
+    // rendering fails; nothing is cached then.
+    using SurfaceRenderFn = std::function<std::shared_ptr<CachedSurface>(const SurfaceKey& key)>;
+
+    struct SurfaceCacheStats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t bytes = 0;
+        size_t entries = 0;
+    };
+
+    // Least-recently-used cache of rendered frame surfaces, bounded by a
+    // byte budget. Surfaces are handed out as shared pointers, so the one
+    // currently on screen stays alive even if the cache evicts it.
+    //
+    // Not thread-safe; owned by the thread that paints.
+    class SurfaceCache
+    {
+    public:
+        explicit SurfaceCache(size_t budgetBytes);
+
+        // Cached surface for key, rendering and inserting it on a miss.
+        // A surface bigger than the whole budget is returned but not kept.
+        std::shared_ptr<CachedSurface> Acquire(const SurfaceKey& key, const SurfaceRenderFn& render);
+
+        // Cached surface for key or nullptr; counts as a hit or a miss.
+        std::shared_ptr<CachedSurface> Find(const SurfaceKey& key);
+
+        // Adds a surface rendered elsewhere (e.g. on a worker thread after a
+        // Find miss), replacing any entry for key. Same budget rules as
+        // Acquire.
+        void Insert(const SurfaceKey& key, const std::shared_ptr<CachedSurface>& surface);
+
+        bool Contains(const SurfaceKey& key) const { return index.count(key) != 0; }
+
+        // Shrinking the budget evicts least recently used entries right away.
+        void SetBudget(size_t budgetBytes);
+        size_t Budget() const { return budget; }
+
+        // Evicts least recently used entries until at most keepBytes are
+        // cached; the budget stays as it is.
+        void Trim(size_t keepBytes);
+
+        void Clear();
+        void ResetStats();
+        SurfaceCacheStats Stats() const;
+
+    private:
+        struct Entry
+        {
+            SurfaceKey key;
+            std::shared_ptr<CachedSurface> surface;
+            size_t bytes;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        void EvictTo(size_t limit);
+
+        size_t budget;
+        size_t bytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        EntryList entries;      // most recently used first
+        std::unordered_map<SurfaceKey, EntryList::iterator, SurfaceKeyHash> index;
+    };
+}
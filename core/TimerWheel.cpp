@@ -0,0 +1,289 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace EdgeLight
+{
+    namespace
+    {
+        int CountTrailingZeros(uint64_t mask)
+        {
+#if defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return static_cast<int>(index);
+#elif defined(_MSC_VER)
+            unsigned long index;
+            if (_BitScanForward(&index, static_cast<unsigned long>(mask)))
+                return static_cast<int>(index);
+            _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+            return static_cast<int>(index) + 32;
+#else
+            return __builtin_ctzll(mask);
+#endif
+        }
+
+        // Slots of a level are visited in order from the one after the
+        // current index, wrapping around to the current one last. Returns
+        // how many slots ahead the first occupied one is (1..SLOTS).
+        int FirstOccupiedAhead(uint64_t mask, int current)
+        {
+            const int start = (current + 1) & (TimerWheel::SLOTS - 1);
+            const uint64_t rotated = start == 0 ? mask : (mask >> start) | (mask << (TimerWheel::SLOTS - start));
+            return CountTrailingZeros(rotated) + 1;
+        }
+    }
+
+    TimerWheel::TimerWheel(const Clock& clock, int64_t tickUs) :
+        clock(clock),
+        tickUs(std::max<int64_t>(tickUs, 1))
+    {
+        currentTick = NowTick();
+        for (auto& level : heads)
+            std::fill(std::begin(level), std::end(level), -1);
+    }
+
+    int64_t TimerWheel::NowTick() const
+    {
+        return clock.NowUs() / tickUs;
+    }
+
+    TimerWheel::TimerId TimerWheel::Add(Callback callback)
+    {
+        Timer timer;
+        timer.callback = std::move(callback);
+        timers.push_back(std::move(timer));
+
+        // Firing never allocates once every timer has a place
+        firing.reserve(timers.size());
+        return static_cast<TimerId>(timers.size() - 1);
+    }
+
+    void TimerWheel::Arm(TimerId id, int64_t delayUs)
+    {
+        Timer& timer = timers[id];
+        if (timer.level >= 0)
+            Unlink(id);
+        else
+            armedCount++;
+        timer.firing = false;
+
+        const int64_t due = clock.NowUs() + std::max<int64_t>(delayUs, 0);
+        timer.dueTick = std::max((due + tickUs - 1) / tickUs, currentTick + 1);
+        Place(id);
+    }
+
+    void TimerWheel::Disarm(TimerId id)
+    {
+        Timer& timer = timers[id];
+        timer.firing = false;
+        if (timer.level < 0)
+            return;
+
+        Unlink(id);
+        armedCount--;
+    }
+
+    bool TimerWheel::Armed(TimerId id) const
+    {
+        return timers[id].level >= 0;
+    }
+
+    // A timer goes to the lowest level whose span covers its distance, in
+    // the slot its own deadline bits select there; that slot comes round
+    // (and is cascaded to the levels below) before the deadline. Deadlines
+    // past the top level's span are parked in its last slot.
+    void TimerWheel::Place(TimerId id)
+    {
+        Timer& timer = timers[id];
+        const int64_t delta = std::max<int64_t>(timer.dueTick - currentTick, 0);
+        const int64_t span = int64_t(1) << (LEVELS * SLOT_BITS);
+
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (int64_t(1) << ((level + 1) * SLOT_BITS)))
+            level++;
+
+        int64_t placeTick = std::max(timer.dueTick, currentTick);
+        if (delta >= span)
+            placeTick = currentTick + span - 1;
+
+        const int slot = static_cast<int>((placeTick >> (level * SLOT_BITS)) & (SLOTS - 1));
+        timer.level = level;
+        timer.slot = slot;
+        timer.prev = -1;
+        timer.next = heads[level][slot];
+        if (timer.next >= 0)
+            timers[timer.next].prev = id;
+        heads[level][slot] = id;
+        occupied[level] |= uint64_t(1) << slot;
+    }
+
+    void TimerWheel::Unlink(TimerId id)
+    {
+        Timer& timer = timers[id];
+        if (timer.prev >= 0)
+            timers[timer.prev].next = timer.next;
+        else
+            heads[timer.level][timer.slot] = timer.next;
+        if (timer.next >= 0)
+            timers[timer.next].prev = timer.prev;
+
+        if (heads[timer.level][timer.slot] < 0)
+            occupied[timer.level] &= ~(uint64_t(1) << timer.slot);
+        timer.level = -1;
+        timer.prev = -1;
+        timer.next = -1;
+    }
+
+    // The next tick at which some occupied slot is visited: fired on
+    // level 0, cascaded above it.
+    int64_t TimerWheel::NextVisitTick() const
+    {
+        int64_t next = -1;
+        for (int level = 0; level < LEVELS; level++)
+        {
+            if (!occupied[level])
+                continue;
+
+            const int shift = level * SLOT_BITS;
+            const int64_t block = currentTick >> shift;
+            const int ahead = FirstOccupiedAhead(occupied[level], static_cast<int>(block & (SLOTS - 1)));
+            const int64_t visit = (block + ahead) << shift;
+            if (next < 0 || visit < next)
+                next = visit;
+        }
+        return next;
+    }
+
+    // Slots of one level hold disjoint, increasing deadline ranges in
+    // visit order, so below the top only the first occupied slot can hold
+    // the earliest timer. Parked deadlines break that order at the top,
+    // which is scanned whole.
+    int64_t TimerWheel::EarliestDueTick() const
+    {
+        int64_t earliest = -1;
+        for (int level = 0; level < LEVELS; level++)
+        {
+            uint64_t mask = occupied[level];
+            if (!mask)
+                continue;
+
+            if (level < LEVELS - 1)
+            {
+                const int current = static_cast<int>((currentTick >> (level * SLOT_BITS)) & (SLOTS - 1));
+                mask = uint64_t(1) << ((current + FirstOccupiedAhead(mask, current)) & (SLOTS - 1));
+            }
+
+            while (mask)
+            {
+                const int slot = CountTrailingZeros(mask);
+                mask &= mask - 1;
+                for (TimerId id = heads[level][slot]; id >= 0; id = timers[id].next)
+                {
+                    if (earliest < 0 || timers[id].dueTick < earliest)
+                        earliest = timers[id].dueTick;
+                }
+            }
+        }
+        return earliest;
+    }
+
+    int64_t TimerWheel::TimeUntilNext() const
+    {
+        const int64_t due = EarliestDueTick();
+        if (due < 0)
+            return -1;
+        return std::max<int64_t>(due * tickUs - clock.NowUs(), 0);
+    }
+
+    uint32_t TimerWheel::WaitTimeoutMs() const
+    {
+        const int64_t wait = TimeUntilNext();
+        if (wait < 0)
+            return WAIT_FOREVER;
+        return static_cast<uint32_t>(std::min<int64_t>((wait + 999) / 1000, WAIT_FOREVER - 1));
+    }
+
+    void TimerWheel::Cascade(int level, int slot)
+    {
+        TimerId id = heads[level][slot];
+        heads[level][slot] = -1;
+        occupied[level] &= ~(uint64_t(1) << slot);
+        while (id >= 0)
+        {
+            const TimerId next = timers[id].next;
+            Place(id);
+            stats.cascaded++;
+            id = next;
+        }
+    }
+
+    // Everything in the current level-0 slot is due on this tick. The
+    // slot is emptied before any callback runs, so callbacks can arm and
+    // disarm freely; one disarmed or re-armed before its turn is skipped.
+    int TimerWheel::Fire(int slot)
+    {
+        firing.clear();
+        for (TimerId id = heads[0][slot]; id >= 0; id = timers[id].next)
+            firing.push_back(id);
+        heads[0][slot] = -1;
+        occupied[0] &= ~(uint64_t(1) << slot);
+
+        for (TimerId id : firing)
+        {
+            Timer& timer = timers[id];
+            timer.level = -1;
+            timer.prev = -1;
+            timer.next = -1;
+            timer.firing = true;
+            armedCount--;
+        }
+
+        int fired = 0;
+        for (size_t i = 0; i < firing.size(); i++)
+        {
+            Timer& timer = timers[firing[i]];
+            if (!timer.firing)
+                continue;
+
+            timer.firing = false;
+            fired++;
+            stats.fired++;
+            timer.callback();
+        }
+        return fired;
+    }
+
+    int TimerWheel::Advance()
+    {
+        const int64_t nowTick = NowTick();
+        int fired = 0;
+        while (currentTick < nowTick)
+        {
+            // Skip the empty ticks in one step
+            const int64_t next = armedCount > 0 ? NextVisitTick() : -1;
+            if (next < 0 || next > nowTick)
+            {
+                currentTick = nowTick;
+                break;
+            }
+
+            currentTick = next;
+            for (int level = LEVELS - 1; level >= 1; level--)
+            {
+                const int shift = level * SLOT_BITS;
+                if ((currentTick & ((int64_t(1) << shift) - 1)) == 0)
+                    Cascade(level, static_cast<int>((currentTick >> shift) & (SLOTS - 1)));
+            }
+            fired += Fire(static_cast<int>(currentTick & (SLOTS - 1)));
+        }
+
+        if (fired > 0)
+            stats.advances++;
+        return fired;
+    }
+}
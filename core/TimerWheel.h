@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace EdgeLight
+{
+    struct TimerWheelStats
+    {
+        uint64_t fired = 0;         // callbacks run
+        uint64_t cascaded = 0;      // timers moved down a level
+        uint64_t advances = 0;      // Advance calls that found something due
+    };
+
+    // Every deadline the app has (render throttling, fade steps, idle
+    // releases, sampling) in one hierarchical timing wheel, so the owner
+    // waits on exactly one OS timeout: TimeUntilNext, or no timeout at all
+    // when nothing is armed. Nothing ticks while idle; Advance jumps
+    // straight to the next slot that holds a timer.
+    //
+    // Four levels of 64 slots at DEFAULT_TICK_US cover about 4.6 hours;
+    // later deadlines wait in the top level and are placed again as it
+    // turns. Timers fire on the first tick at or after their deadline,
+    // never before it, in deadline order.
+    //
+    // Like RenderScheduler this owns no OS timer and no thread: the owner
+    // sleeps for TimeUntilNext and calls Advance when it wakes.
+    class TimerWheel
+    {
+    public:
+        using TimerId = int;
+        using Callback = std::function<void()>;
+
+        static constexpr int64_t DEFAULT_TICK_US = 1000;
+        static constexpr int LEVELS = 4;
+        static constexpr int SLOT_BITS = 6;
+        static constexpr int SLOTS = 1 << SLOT_BITS;
+
+        // Same value as INFINITE
+        static constexpr uint32_t WAIT_FOREVER = 0xFFFFFFFFu;
+
+        explicit TimerWheel(const Clock& clock, int64_t tickUs = DEFAULT_TICK_US);
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        // Registers a disarmed timer. Callbacks run from Advance and may
+        // arm or disarm any timer, their own included. Timers are never
+        // removed; register them once and arm them as often as needed.
+        TimerId Add(Callback callback);
+
+        // Arms id to fire delayUs from now, replacing any deadline it had.
+        // A delay <= 0 fires on the next tick.
+        void Arm(TimerId id, int64_t delayUs);
+
+        void Disarm(TimerId id);
+        bool Armed(TimerId id) const;
+
+        // Microseconds until the earliest armed timer is due: -1 when
+        // nothing is armed, 0 when Advance would fire something now.
+        int64_t TimeUntilNext() const;
+
+        // TimeUntilNext rounded up to whole milliseconds for an OS wait,
+        // WAIT_FOREVER when nothing is armed.
+        uint32_t WaitTimeoutMs() const;
+
+        // Fires every timer that is due, earliest first. Returns how many
+        // callbacks ran.
+        int Advance();
+
+        size_t ArmedCount() const { return armedCount; }
+        const TimerWheelStats& Stats() const { return stats; }
+
+    private:
+        struct Timer
+        {
+            Callback callback;
+            int64_t dueTick = 0;
+            int level = -1;         // -1 when not in a slot
+            int slot = 0;
+            int prev = -1;
+            int next = -1;
+            bool firing = false;    // collected by Advance, not yet run
+        };
+
+        int64_t NowTick() const;
+        void Place(TimerId id);
+        void Unlink(TimerId id);
+        int64_t NextVisitTick() const;
+        int64_t EarliestDueTick() const;
+        void Cascade(int level, int slot);
+        int Fire(int slot);
+
+        const Clock& clock;
+        int64_t tickUs;
+        int64_t currentTick;        // last tick processed
+        std::vector<Timer> timers;
+        std::vector<TimerId> firing;
+        int heads[LEVELS][SLOTS];
+        uint64_t occupied[LEVELS] = {};
+        size_t armedCount = 0;
+        TimerWheelStats stats;
+    };
+}
@@ -0,0 +1,272 @@
+#include "Tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+
+namespace EdgeLight
+{
+    // Single-writer ring. Each slot is guarded by its own sequence number
+    // (a seqlock): the writer zeroes it, fills the slot and publishes the
+    // event's index + 1; a reader keeps the slot only if it saw the same
+    // index + 1 before and after copying it.
+    struct Tracer::Ring
+    {
+        struct Slot
+        {
+            std::atomic<uint64_t> sequence{ 0 };
+            std::atomic<const char*> name{ nullptr };
+            std::atomic<int64_t> timestampNs{ 0 };
+            std::atomic<uint32_t> threadId{ 0 };
+            std::atomic<uint8_t> phase{ 0 };
+        };
+
+        Slot slots[RING_CAPACITY];
+        std::atomic<uint64_t> head{ 0 };        // events ever written
+        std::atomic<uint64_t> tail{ 0 };        // first event Clear kept
+        std::atomic<uint32_t> threadId{ 0 };    // current owner
+        std::atomic<const char*> threadName{ nullptr };
+        std::atomic<bool> owned{ true };
+        Ring* next = nullptr;
+    };
+
+    namespace
+    {
+        constexpr uint64_t RING_MASK = Tracer::RING_CAPACITY - 1;
+        static_assert((Tracer::RING_CAPACITY & RING_MASK) == 0, "ring capacity must be a power of two");
+
+        int64_t NowNs()
+        {
+            using namespace std::chrono;
+            return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Hands the ring back when its thread exits so a later thread can
+        // reuse it instead of growing the list.
+        struct RingLease
+        {
+            std::atomic<bool>* owned = nullptr;
+            void* ring = nullptr;
+
+            ~RingLease()
+            {
+                if (owned)
+                    owned->store(false, std::memory_order_release);
+                owned = nullptr;
+                ring = nullptr;
+            }
+        };
+
+        thread_local RingLease lease;
+
+        void AppendEscaped(std::string& out, const char* text)
+        {
+            for (const char* c = text ? text : ""; *c; c++)
+            {
+                const unsigned char ch = static_cast<unsigned char>(*c);
+                if (ch == '"' || ch == '\\')
+                {
+                    out += '\\';
+                    out += *c;
+                }
+                else if (ch < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+                    out += escaped;
+                }
+                else
+                {
+                    out += *c;
+                }
+            }
+        }
+    }
+
+    std::atomic<bool> Tracer::enabled{ false };
+
+    Tracer& Tracer::Instance()
+    {
+        // Never destroyed: rings stay valid for threads still running at exit
+        static Tracer* instance = new Tracer();
+        return *instance;
+    }
+
+    Tracer::Ring* Tracer::ClaimRing()
+    {
+        Ring* ring = nullptr;
+        for (Ring* r = rings.load(std::memory_order_acquire); r && !ring; r = r->next)
+        {
+            bool free = false;
+            if (!r->owned.load(std::memory_order_relaxed))
+                ring = r->owned.compare_exchange_strong(free, true, std::memory_order_acquire) ? r : nullptr;
+        }
+
+        if (!ring)
+        {
+            ring = new Ring();
+            Ring* first = rings.load(std::memory_order_relaxed);
+            do
+            {
+                ring->next = first;
+            } while (!rings.compare_exchange_weak(first, ring, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Older events in a reused ring keep the previous thread's id
+        ring->threadId.store(nextThreadId.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+        ring->threadName.store(nullptr, std::memory_order_relaxed);
+        lease.owned = &ring->owned;
+        lease.ring = ring;
+        return ring;
+    }
+
+    Tracer::Ring* Tracer::CurrentRing()
+    {
+        return lease.ring ? static_cast<Ring*>(lease.ring) : ClaimRing();
+    }
+
+    void Tracer::Record(const char* name, TracePhase phase)
+    {
+        Ring* ring = CurrentRing();
+        const uint64_t index = ring->head.load(std::memory_order_relaxed);
+        Ring::Slot& slot = ring->slots[index & RING_MASK];
+
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.timestampNs.store(NowNs(), std::memory_order_relaxed);
+        slot.threadId.store(ring->threadId.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        slot.phase.store(static_cast<uint8_t>(phase), std::memory_order_relaxed);
+        slot.sequence.store(index + 1, std::memory_order_release);
+        ring->head.store(index + 1, std::memory_order_release);
+    }
+
+    void Tracer::SetThreadName(const char* name)
+    {
+        CurrentRing()->threadName.store(name, std::memory_order_relaxed);
+    }
+
+    std::vector<TraceEvent> Tracer::Snapshot() const
+    {
+        std::vector<TraceEvent> events;
+        for (Ring* ring = rings.load(std::memory_order_acquire); ring; ring = ring->next)
+        {
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            const uint64_t first = std::max(tail, head > RING_CAPACITY ? head - RING_CAPACITY : 0);
+
+            for (uint64_t index = first; index < head; index++)
+            {
+                const Ring::Slot& slot = ring->slots[index & RING_MASK];
+                if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+                    continue;
+
+                TraceEvent event;
+                event.name = slot.name.load(std::memory_order_relaxed);
+                event.timestampNs = slot.timestampNs.load(std::memory_order_relaxed);
+                event.threadId = slot.threadId.load(std::memory_order_relaxed);
+                event.phase = static_cast<TracePhase>(slot.phase.load(std::memory_order_relaxed));
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                // Overwritten while copying
+                if (slot.sequence.load(std::memory_order_relaxed) != index + 1)
+                    continue;
+                events.push_back(event);
+            }
+        }
+        return events;
+    }
+
+    std::vector<TraceThread> Tracer::Threads() const
+    {
+        std::vector<TraceThread> threads;
+        for (Ring* ring = rings.load(std::memory_order_acquire); ring; ring = ring->next)
+        {
+            TraceThread thread;
+            thread.threadId = ring->threadId.load(std::memory_order_relaxed);
+            thread.name = ring->threadName.load(std::memory_order_relaxed);
+            threads.push_back(thread);
+        }
+        return threads;
+    }
+
+    TraceStats Tracer::Stats() const
+    {
+        TraceStats stats;
+        for (Ring* ring = rings.load(std::memory_order_acquire); ring; ring = ring->next)
+        {
+            const uint64_t head = ring->head.load(std::memory_order_relaxed);
+            const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            stats.threads++;
+            stats.recorded += head;
+            if (head - tail > RING_CAPACITY)
+                stats.dropped += head - tail - RING_CAPACITY;
+        }
+        return stats;
+    }
+
+    void Tracer::Clear()
+    {
+        for (Ring* ring = rings.load(std::memory_order_acquire); ring; ring = ring->next)
+            ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    std::string ToChromeTraceJson(const std::vector<TraceEvent>& events, const std::vector<TraceThread>& threads)
+    {
+        std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        char buffer[96];
+        const auto separate = [&]
+        {
+            if (!first)
+                out += ",\n";
+            first = false;
+        };
+
+        for (const TraceThread& thread : threads)
+        {
+            if (!thread.name)
+                continue;
+            separate();
+            std::snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"",
+                          thread.threadId);
+            out += buffer;
+            AppendEscaped(out, thread.name);
+            out += "\"}}";
+        }
+
+        // Timestamps relative to the oldest event, in microseconds
+        int64_t origin = 0;
+        for (size_t i = 0; i < events.size(); i++)
+            origin = i == 0 ? events[i].timestampNs : std::min(origin, events[i].timestampNs);
+
+        std::unordered_map<uint32_t, int> depth;
+        for (const TraceEvent& event : events)
+        {
+            if (event.phase == TracePhase::End)
+            {
+                int& open = depth[event.threadId];
+                if (open == 0)
+                    continue;
+                open--;
+            }
+            else if (event.phase == TracePhase::Begin)
+            {
+                depth[event.threadId]++;
+            }
+
+            const char phase = event.phase == TracePhase::Begin ? 'B' : event.phase == TracePhase::End ? 'E' : 'i';
+            separate();
+            out += "{\"name\":\"";
+            AppendEscaped(out, event.name);
+            std::snprintf(buffer, sizeof(buffer), "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u%s}",
+                          phase, (event.timestampNs - origin) / 1000.0, event.threadId,
+                          event.phase == TracePhase::Instant ? ",\"s\":\"t\"" : "");
+            out += buffer;
+        }
+
+        out += "\n]}\n";
+        return out;
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EdgeLight
+{
+    enum class TracePhase : uint8_t
+    {
+        Begin,
+        End,
+        Instant,
+    };
+
+    // One recorded event. name must be a string with static storage
+    // duration (a literal); only the pointer is stored.
+    struct TraceEvent
+    {
+        const char* name = nullptr;
+        int64_t timestampNs = 0;    // steady clock
+        uint32_t threadId = 0;      // small sequential id, not the OS id
+        TracePhase phase = TracePhase::Instant;
+    };
+
+    struct TraceThread
+    {
+        uint32_t threadId = 0;
+        const char* name = nullptr;
+    };
+
+    struct TraceStats
+    {
+        size_t threads = 0;
+        uint64_t recorded = 0;      // events ever written
+        uint64_t dropped = 0;       // overwritten since the last Clear
+    };
+
+    // Always-on hot-path instrumentation. Every thread writes to its own
+    // fixed-size ring, so recording takes no lock and never allocates after
+    // the thread's first event; once a ring is full the oldest events are
+    // overwritten. Snapshot can run at any time, concurrently with writers,
+    // and skips slots that are being overwritten while it reads them.
+    //
+    // When disabled, a TraceScope costs one relaxed atomic load.
+    class Tracer
+    {
+    public:
+        static constexpr size_t RING_CAPACITY = 4096;  // events per thread, a power of two
+
+        static Tracer& Instance();
+
+        static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+        void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+        void Record(const char* name, TracePhase phase);
+
+        // Labels the calling thread in exported traces (static string).
+        void SetThreadName(const char* name);
+
+        // Every event still in the rings, oldest first per thread.
+        std::vector<TraceEvent> Snapshot() const;
+        std::vector<TraceThread> Threads() const;
+        TraceStats Stats() const;
+
+        // Empties every ring. Events recorded concurrently may survive.
+        void Clear();
+
+    private:
+        struct Ring;
+
+        Tracer() = default;
+        Ring* CurrentRing();
+        Ring* ClaimRing();
+
+        static std::atomic<bool> enabled;
+        std::atomic<Ring*> rings{ nullptr };    // push-only list, rings are reused, never freed
+        std::atomic<uint32_t> nextThreadId{ 1 };
+    };
+
+    // Begin/End pair around a scope.
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char* name) :
+            name(Tracer::IsEnabled() ? name : nullptr)
+        {
+            if (this->name)
+                Tracer::Instance().Record(this->name, TracePhase::Begin);
+        }
+
+        ~TraceScope()
+        {
+            if (name)
+                Tracer::Instance().Record(name, TracePhase::End);
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        const char* name;
+    };
+
+    // Chrome trace-event JSON (chrome://tracing, Perfetto). End events
+    // whose Begin was already overwritten are left out.
+    std::string ToChromeTraceJson(const std::vector<TraceEvent>& events, const std::vector<TraceThread>& threads);
+}
+
+#define EDGELIGHT_TRACE_CONCAT_(a, b) a##b
+#define EDGELIGHT_TRACE_CONCAT(a, b) EDGELIGHT_TRACE_CONCAT_(a, b)
+
+// Traces the rest of the enclosing scope under name (a string literal).
+#define EDGELIGHT_TRACE_SCOPE(name) ::EdgeLight::TraceScope EDGELIGHT_TRACE_CONCAT(traceScope_, __LINE__)(name)
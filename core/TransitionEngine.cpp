@@ -0,0 +1,87 @@
+#include "TransitionEngine.h"
+
+namespace EdgeLight
+{
+    float Ease(Easing easing, float t)
+    {
+        t = t > 0.0f ? t : 0.0f;
+        t = t < 1.0f ? t : 1.0f;
+
+        switch (easing)
+        {
+        case Easing::EaseIn:
+            return t * t * t;
+        case Easing::EaseOut:
+        {
+            const float u = 1.0f - t;
+            return 1.0f - u * u * u;
+        }
+        case Easing::EaseInOut:
+        {
+            if (t < 0.5f)
+                return 4.0f * t * t * t;
+            const float u = 2.0f - 2.0f * t;
+            return 1.0f - 0.5f * u * u * u;
+        }
+        case Easing::Linear:
+        default:
+            return t;
+        }
+    }
+
+    TransitionState Lerp(const TransitionState& from, const TransitionState& to, float t)
+    {
+        TransitionState state;
+        state.opacity = from.opacity + (to.opacity - from.opacity) * t;
+        state.thickness = from.thickness + (to.thickness - from.thickness) * t;
+        state.offsetX = from.offsetX + (to.offsetX - from.offsetX) * t;
+        state.offsetY = from.offsetY + (to.offsetY - from.offsetY) * t;
+        return state;
+    }
+
+    TransitionEngine::TransitionEngine(const Clock& clock)
+        : clock(clock)
+    {
+    }
+
+    void TransitionEngine::Reset(const TransitionState& state)
+    {
+        from = state;
+        to = state;
+        running = false;
+    }
+
+    void TransitionEngine::Start(const TransitionState& target, int64_t duration, Easing curve)
+    {
+        const int64_t now = clock.NowUs();
+        from = running ? Value(now) : to;
+        to = target;
+        startUs = now;
+        durationUs = duration;
+        easing = curve;
+        running = duration > 0;
+        if (!running)
+            from = to;
+    }
+
+    TransitionState TransitionEngine::Value(int64_t now) const
+    {
+        if (!running || now - startUs >= durationUs)
+            return to;
+
+        const float t = static_cast<float>(now - startUs) / static_cast<float>(durationUs);
+        return Lerp(from, to, Ease(easing, t));
+    }
+
+    TransitionState TransitionEngine::Sample()
+    {
+        samples++;
+        const int64_t now = clock.NowUs();
+        if (running && now - startUs >= durationUs)
+        {
+            running = false;
+            from = to;
+        }
+        return Value(now);
+    }
+}
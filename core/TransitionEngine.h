@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+
+namespace EdgeLight
+{
+    enum class Easing
+    {
+        Linear,
+        EaseIn,         // cubic
+        EaseOut,        // cubic
+        EaseInOut,      // cubic, symmetric
+    };
+
+    // Maps progress t in [0, 1] to eased progress; t is clamped, and the
+    // end points map to exactly 0 and 1.
+    float Ease(Easing easing, float t);
+
+    // Everything a transition can animate. Opacity is a 0..1 factor on top
+    // of the user's brightness; thickness and offsets are in pixels.
+    struct TransitionState
+    {
+        float opacity = 1.0f;
+        float thickness = 0.0f;
+        float offsetX = 0.0f;
+        float offsetY = 0.0f;
+    };
+
+    TransitionState Lerp(const TransitionState& from, const TransitionState& to, float t);
+
+    // Interpolates a TransitionState over a fixed duration on the given
+    // clock. The engine never schedules anything itself: the owner samples
+    // it from a timer while IsRunning() and stops the timer as soon as it
+    // turns false.
+    class TransitionEngine
+    {
+    public:
+        static constexpr int64_t DEFAULT_DURATION_US = 200000;
+
+        explicit TransitionEngine(const Clock& clock);
+
+        // Jumps to state with no animation.
+        void Reset(const TransitionState& state);
+
+        // Animates from the current value, so retargeting mid-way does not
+        // jump. A zero duration jumps straight to target.
+        void Start(const TransitionState& target, int64_t durationUs = DEFAULT_DURATION_US,
+                   Easing easing = Easing::EaseInOut);
+
+        // Value now. Finishes the transition once its duration has elapsed,
+        // returning exactly the target.
+        TransitionState Sample();
+
+        bool IsRunning() const { return running; }
+        const TransitionState& Target() const { return to; }
+        uint64_t Samples() const { return samples; }
+
+    private:
+        TransitionState Value(int64_t now) const;
+
+        const Clock& clock;
+        TransitionState from;
+        TransitionState to;
+        int64_t startUs = 0;
+        int64_t durationUs = 0;
+        Easing easing = Easing::Linear;
+        bool running = false;
+        uint64_t samples = 0;
+    };
+}
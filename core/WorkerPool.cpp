@@ -0,0 +1,92 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+namespace EdgeLight
+{
+    WorkerPool::WorkerPool(int threads)
+    {
+        if (threads <= 0)
+        {
+            const unsigned hardware = std::thread::hardware_concurrency();
+            threads = hardware > 0 ? static_cast<int>(hardware) : 1;
+        }
+        concurrency = threads;
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    void WorkerPool::RunTasks()
+    {
+        for (int i = next.fetch_add(1); i < jobCount; i = next.fetch_add(1))
+            (*job)(i);
+    }
+
+    // seen is the generation current when the worker was started, so it
+    // waits for the next job rather than picking up a finished one
+    void WorkerPool::WorkerLoop(uint64_t seen)
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+
+            RunTasks();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--active == 0)
+                done.notify_one();
+        }
+    }
+
+    void WorkerPool::ParallelFor(int count, const std::function<void(int)>& fn)
+    {
+        if (count <= 0)
+            return;
+
+        std::lock_guard<std::mutex> call(callMutex);
+        if (concurrency <= 1 || count == 1)
+        {
+            for (int i = 0; i < count; i++)
+                fn(i);
+            return;
+        }
+
+        // No job is running while callMutex is held, so generation is
+        // stable and new workers can join here
+        const size_t wanted = static_cast<size_t>(std::min(count, concurrency) - 1);
+        while (workers.size() < wanted)
+            workers.emplace_back(&WorkerPool::WorkerLoop, this, generation);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            jobCount = count;
+            next.store(0);
+            active = static_cast<int>(workers.size());
+            generation++;
+        }
+        wake.notify_all();
+
+        RunTasks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return active == 0; });
+        job = nullptr;
+        jobCount = 0;
+    }
+}
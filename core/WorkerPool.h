@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EdgeLight
+{
+    // Worker threads for fork-join work. The calling thread takes part in
+    // every ParallelFor, so a pool of one runs everything inline without
+    // any threads. Threads are only started once there is parallel work,
+    // and only as many as it can use, so a pool that never sees more than
+    // one task at a time costs no threads at all.
+    class WorkerPool
+    {
+    public:
+        // threads counts the caller; 0 uses the hardware concurrency.
+        explicit WorkerPool(int threads = 0);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Most calls that run at once, the caller included.
+        int Concurrency() const { return concurrency; }
+
+        // Worker threads started so far.
+        int StartedWorkers() const { return static_cast<int>(workers.size()); }
+
+        // Runs fn(i) for every i in [0, count) and returns when all calls
+        // are done. Calls run concurrently in no particular order, so fn
+        // must be safe to call from several threads at once.
+        void ParallelFor(int count, const std::function<void(int)>& fn);
+
+    private:
+        void WorkerLoop(uint64_t seen);
+        void RunTasks();
+
+        int concurrency;
+
+        std::vector<std::thread> workers;
+        std::mutex callMutex;           // one ParallelFor at a time
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(int)>* job = nullptr;
+        int jobCount = 0;
+        std::atomic<int> next{ 0 };
+        int active = 0;                 // workers still inside the current job
+        uint64_t generation = 0;
+        bool stopping = false;
+    };
+}
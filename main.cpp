@@ -7,13 +7,48 @@
 #include <shellapi.h>
 #include <dwmapi.h>
 #include <commctrl.h>
+#include <shellscalingapi.h>
+#include <strsafe.h>
 
 #pragma comment(lib, "dwmapi")
 #pragma comment(lib, "gdi32")
 #pragma comment(lib, "msimg32")
 #pragma comment(lib, "comctl32")
+#pragma comment(lib, "shcore")
 
 #include "resource.h"
+#include "core/AutoBrightness.h"
+#include "core/ColorLut.h"
+#include "core/DpiScale.h"
+#include "core/EdgeStripLayout.h"
+#include "core/FrameDelta.h"
+#include "core/FrameRenderer.h"
+#include "core/FrameSpans.h"
+#include "core/GdiResourcePool.h"
+#include "core/MemoryBudget.h"
+#include "core/MonitorTopology.h"
+#include "core/NineSlice.h"
+#include "core/OnDemandLifetime.h"
+#include "core/OverlayOrchestrator.h"
+#include "core/RenderScheduler.h"
+#include "core/SdfFrameRenderer.h"
+#include "core/StartupTimeline.h"
+#include "core/SurfaceCache.h"
+#include "core/TimerWheel.h"
+#include "core/Tracer.h"
+#include "core/TransitionEngine.h"
+#include "core/WorkerPool.h"
+#include "win/D2DFrameRenderer.h"
+#include "win/GdiAllocator.h"
+#include "win/GdiFrameRenderer.h"
+#include "win/LayeredSurface.h"
+#include "win/ScreenSampler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <vector>
 
 // Menu IDs
 #define IDM_EXIT 103
@@ -23,6 +58,9 @@
 #define IDM_SWITCH_MONITOR 107
 #define IDM_HELP 108
 #define IDM_TOGGLE_CONTROLS 109
+#define IDM_ALL_MONITORS 110
+#define IDM_SAVE_TRACE 111
+#define IDM_AUTO_BRIGHTNESS 112
 
 // Control IDs
 #define IDC_THICKNESS_SLIDER 1001
@@ -30,20 +68,231 @@
 #define IDC_TOGGLE_BTN 1003
 #define IDC_MONITOR_BTN 1004
 #define IDC_CLOSE_BTN 1005
+#define IDC_TEMPERATURE_SLIDER 1006
+
+// Everything painted for one frame geometry: the lit spans, used to clear
+// stale pixels when the geometry changes, and the nine-slice pieces as
+// ready-to-blit DIB sections. Rendered once at full intensity and kept in
+// the surface cache.
+class FrameSurface : public EdgeLight::CachedSurface
+{
+public:
+    static constexpr int PIECES = static_cast<int>(EdgeLight::SlicePiece::Count);
+
+    EdgeLight::FrameSpans spans;
+    EdgeLight::SurfaceKey key;      // geometry, for pooled regions
+
+    FrameSurface() :
+        width(0),
+        height(0)
+    {
+        ZeroMemory(bitmaps, sizeof(bitmaps));
+        ZeroMemory(layouts, sizeof(layouts));
+        ZeroMemory(visible, sizeof(visible));
+    }
+
+    ~FrameSurface()
+    {
+        for (HBITMAP bitmap : bitmaps)
+        {
+            if (bitmap)
+                DeleteObject(bitmap);
+        }
+    }
+
+    FrameSurface(const FrameSurface&) = delete;
+    FrameSurface& operator=(const FrameSurface&) = delete;
+
+    // params are device pixels; tiles come from the DPI geometry cache.
+    // The grey tiles are colored while they are copied into the pieces, so
+    // a color change reuses them and only re-runs the table lookups.
+    bool Render(const EdgeLight::FrameParams& params, std::shared_ptr<const EdgeLight::NineSliceFrame> tiles,
+                const EdgeLight::ColorLut* lut)
+    {
+        width = params.width;
+        height = params.height;
+        spans.Build(params);
+        slices = std::move(tiles);
+
+        for (int i = 0; i < PIECES; i++)
+        {
+            const EdgeLight::SlicePiece piece = static_cast<EdgeLight::SlicePiece>(i);
+            visible[i] = slices->Layout(piece, width, height, layouts[i]);
+            if (!visible[i])
+                continue;
+
+            BITMAPINFO bmi = {};
+            bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bmi.bmiHeader.biWidth = layouts[i].sourceWidth;
+            bmi.bmiHeader.biHeight = -layouts[i].sourceHeight; // top-down
+            bmi.bmiHeader.biPlanes = 1;
+            bmi.bmiHeader.biBitCount = 32;
+            bmi.bmiHeader.biCompression = BI_RGB;
+
+            void* bits = nullptr;
+            bitmaps[i] = CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+            if (!bitmaps[i])
+                return false;
+
+            EdgeLight::BgraBuffer target;
+            target.pixels = static_cast<uint8_t*>(bits);
+            target.width = layouts[i].sourceWidth;
+            target.height = layouts[i].sourceHeight;
+            target.stride = layouts[i].sourceWidth * 4;
+            slices->RenderPiece(piece, target, 255);
+            if (lut)
+                EdgeLight::ApplyColorLut(*lut, target);
+        }
+        return true;
+    }
+
+    // Draws the frame straight into the window: corners are copied, edge
+    // cross-sections are stretched along the sides
+    void Present(HDC hdc) const
+    {
+        HDC memDC = CreateCompatibleDC(hdc);
+        HGDIOBJ oldBitmap = nullptr;
+        SetStretchBltMode(hdc, COLORONCOLOR);
+
+        for (int i = 0; i < PIECES; i++)
+        {
+            if (!visible[i])
+                continue;
+
+            HGDIOBJ previous = SelectObject(memDC, bitmaps[i]);
+            if (!oldBitmap)
+                oldBitmap = previous;
+
+            const EdgeLight::SliceLayout& layout = layouts[i];
+            const EdgeLight::SpanRect& d = layout.dest;
+            StretchBlt(hdc, d.left, d.top, d.right - d.left, d.bottom - d.top,
+                       memDC, 0, 0, layout.sourceWidth, layout.sourceHeight, SRCCOPY);
+        }
+
+        if (oldBitmap)
+            SelectObject(memDC, oldBitmap);
+        DeleteDC(memDC);
+    }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+    size_t ByteSize() const override
+    {
+        // Tiles are shared through the geometry cache and not charged here
+        size_t bytes = sizeof(*this) + spans.ByteSize();
+        for (int i = 0; i < PIECES; i++)
+        {
+            if (visible[i])
+                bytes += static_cast<size_t>(layouts[i].sourceWidth) * layouts[i].sourceHeight * 4;
+        }
+        return bytes;
+    }
+
+private:
+    std::shared_ptr<const EdgeLight::NineSliceFrame> slices;
+    HBITMAP bitmaps[PIECES];
+    EdgeLight::SliceLayout layouts[PIECES];
+    bool visible[PIECES];
+    int width;
+    int height;
+};
+
+// Edge-strip mode: one piece of an overlay's frame in its own window
+struct StripWindow
+{
+    HWND hwnd = nullptr;
+    std::shared_ptr<EdgeLight::LayeredSurface> surface;
+};
+
+// One layered window covering one monitor's work area
+struct Overlay
+{
+    HWND hwnd = nullptr;
+    HMONITOR monitor = nullptr;
+    std::shared_ptr<FrameSurface> surface;      // prepared for the next paint
+    std::shared_ptr<FrameSurface> litSurface;   // what is on screen now, null when dark
+    int paintedWidth = 0;
+    int paintedHeight = 0;
+
+    // Per-pixel alpha mode: the window's pixels and the device params and
+    // colors they were last rendered with
+    std::shared_ptr<EdgeLight::LayeredSurface> layered;
+    EdgeLight::FrameParams layeredParams;
+    uint32_t layeredColor = 0;
+
+    // Edge-strip mode: windows owned by hwnd showing the frame's pieces;
+    // hwnd itself is never presented and stays invisible
+    std::vector<StripWindow> strips;
+};
+
+// Everything the command line can change, parsed once in wWinMain
+struct LaunchOptions
+{
+    EdgeLight::RendererBackend renderer = EdgeLight::RendererBackend::Software;
+    bool perPixelAlpha = false;
+    EdgeLight::EdgeStripMode strips = EdgeLight::EdgeStripMode::Single;
+    int64_t panelIdleUs = EdgeLight::OnDemandLifetime::DEFAULT_IDLE_US;
+    size_t memoryCeilingBytes = EdgeLight::MemoryBudget::DEFAULT_CEILING_BYTES;
+    EdgeLight::ColorSettings colors;
+    bool autoBrightness = false;
+    bool tracing = true;
+};
+
+// Work left for when a fade finishes
+enum class FadeAction
+{
+    None,
+    TurnOff,
+    SwitchMonitor,
+};
 
 class EdgeLightWindow
 {
 private:
-    HWND hwnd;
+    HWND hwnd;                      // primary overlay; owns the tray icon, hotkeys and timers
     HWND controlHwnd;
     NOTIFYICONDATA nid;
     bool isLightOn;
     int currentOpacity;
     int currentMonitorIndex;
     int frameThickness;
-    HMONITOR monitors[8];
-    int monitorCount;
-    bool controlsVisible;
+    EdgeLight::ColorSettings color;
+    EdgeLight::ColorLut colorLut;   // for color, in the format of the current mode
+    std::vector<HMONITOR> monitors;
+    EdgeLight::MonitorTopology topology;
+    bool allMonitors;
+    bool perPixelAlpha;             // UpdateLayeredWindow with premultiplied pixels instead of the black color key
+    EdgeLight::EdgeStripMode stripMode; // per-pixel alpha only: one window per overlay, or edge strips
+    std::vector<Overlay> overlays;  // overlays[0] is hwnd
+    EdgeLight::SurfaceCache surfaceCache;
+    EdgeLight::Win32GdiAllocator gdiAllocator;
+    EdgeLight::GdiResourcePool gdiPool;     // brushes and frame regions reused across paints
+    std::unique_ptr<EdgeLight::IFrameRenderer> renderer;   // rasterizes the nine-slice tiles
+    EdgeLight::DpiGeometryCache geometryCache;
+    EdgeLight::WorkerPool renderPool;       // no threads until several surfaces render at once
+    EdgeLight::OverlayOrchestrator orchestrator;
+    EdgeLight::SteadyClock clock;
+    EdgeLight::TimerWheel timers;   // every deadline; RunMessageLoop waits for the earliest one
+    int modalDepth;                 // menus and message boxes running their own message loop
+    bool modalTimerArmed;           // TIMER_WHEEL stands in for RunMessageLoop's wait
+    EdgeLight::RenderScheduler scheduler;
+    EdgeLight::TimerWheel::TimerId renderTimer;
+    EdgeLight::TransitionEngine fade;
+    float fadeOpacity;          // 0..1 on top of currentOpacity
+    FadeAction fadeAction;      // what to do once the running fade ends
+    FadeAction queuedFadeAction; // asked for while fadeAction was pending; runs right after it
+    EdgeLight::TimerWheel::TimerId fadeTimer;
+    EdgeLight::StartupTimeline startup;     // phase timings from construction to the first paint
+    EdgeLight::OnDemandLifetime controlPanel; // controlHwnd exists only once shown, until it idles out
+    EdgeLight::TimerWheel::TimerId controlsTimer;
+    bool controlClassRegistered;
+    EdgeLight::MemoryBudget memory;         // caches and DIBs by category, released when over the ceiling or idle
+    EdgeLight::TimerWheel::TimerId memoryTimer;
+    EdgeLight::AutoBrightness autoBrightness;   // opacity from the screen under the frame, when enabled
+    EdgeLight::ScreenSampler screenSampler;
+    EdgeLight::TimerWheel::TimerId autoBrightnessTimer;
+    bool captureExcluded;   // every overlay and strip window is kept out of screen captures
     
     static constexpr int OPACITY_STEP = 38;
     static constexpr int MIN_OPACITY = 51;
@@ -51,12 +300,21 @@ private:
     static constexpr int MIN_THICKNESS = 20;
     static constexpr int MAX_THICKNESS = 150;
     static constexpr int DEFAULT_THICKNESS = 80;
+    static constexpr int MIN_TEMPERATURE = 2700;
+    static constexpr int MAX_TEMPERATURE = 9000;
     static constexpr int CORNER_RADIUS = 100;
-    static constexpr int BLUR_SIZE = 10;
+    static constexpr int FRAME_INSET = 20;
+    static constexpr int GLOW_RINGS = 2; // Very subtle blur radius
+    static constexpr int GLOW_RADIUS = 10;      // soft blurred halo around the band
+    static constexpr int GLOW_STRENGTH = 96;
     static constexpr int HOTKEY_TOGGLE = 1;
     static constexpr int HOTKEY_BRIGHTNESS_UP = 2;
     static constexpr int HOTKEY_BRIGHTNESS_DOWN = 3;
     static constexpr int HOTKEY_TOGGLE_CONTROLS = 4;
+    static constexpr size_t SURFACE_CACHE_BUDGET = 4 * 1024 * 1024;
+    static constexpr UINT_PTR TIMER_WHEEL = 1;
+    static constexpr int LUMINANCE_STEP = 4;    // every 4th pixel of every 4th row
+    static constexpr int64_t FADE_DURATION_US = 200000;
 
 public:
     EdgeLightWindow() : 
@@ -65,12 +323,34 @@ public:
         isLightOn(true),
         currentOpacity(255),
         currentMonitorIndex(0),
-        monitorCount(0),
         frameThickness(DEFAULT_THICKNESS),
-        controlsVisible(true)
+        allMonitors(false),
+        perPixelAlpha(false),
+        stripMode(EdgeLight::EdgeStripMode::Single),
+        surfaceCache(SURFACE_CACHE_BUDGET),
+        gdiPool(gdiAllocator),
+        orchestrator(surfaceCache, renderPool),
+        timers(clock),
+        modalDepth(0),
+        modalTimerArmed(false),
+        scheduler(clock),
+        fade(clock),
+        fadeOpacity(1.0f),
+        fadeAction(FadeAction::None),
+        queuedFadeAction(FadeAction::None),
+        startup(clock),
+        controlPanel(clock),
+        controlClassRegistered(false),
+        memory(clock),
+        autoBrightness(clock, AutoBrightnessRange()),
+        captureExcluded(false)
     {
         ZeroMemory(&nid, sizeof(nid));
-        ZeroMemory(monitors, sizeof(monitors));
+        renderTimer = timers.Add([this] { PumpScheduler(); });
+        fadeTimer = timers.Add([this] { OnFadeTimer(); });
+        controlsTimer = timers.Add([this] { OnControlsTimer(); });
+        memoryTimer = timers.Add([this] { OnMemoryTimer(); });
+        autoBrightnessTimer = timers.Add([this] { OnAutoBrightnessTimer(); });
     }
 
     ~EdgeLightWindow()
@@ -78,26 +358,75 @@ public:
         Shell_NotifyIcon(NIM_DELETE, &nid);
     }
 
-    HRESULT Initialize()
+    // Edge strips need per-pixel alpha, so asking for them turns it on.
+    // The control panel is not created here; the first ToggleControls
+    // builds it, and options.panelIdleUs after it is hidden it is
+    // destroyed again.
+    HRESULT Initialize(const LaunchOptions& options)
     {
-        InitCommonControls();
-        EnumerateMonitors();
-        if (CreateOverlayWindow() != S_OK)
-            return E_FAIL;
-        
-        CreateControlWindow();
-        SetupTrayIcon();
-        RegisterHotKeys();
+        EDGELIGHT_TRACE_SCOPE("Startup");
+        stripMode = options.strips;
+        perPixelAlpha = options.perPixelAlpha || options.strips != EdgeLight::EdgeStripMode::Single;
+        color = options.colors;
+        colorLut = EdgeLight::ColorLut::Build(color, perPixelAlpha);
+        controlPanel.SetIdleTimeout(options.panelIdleUs);
+        memory.SetCeiling(options.memoryCeilingBytes);
+        RegisterMemoryHolders();
+
+        // Fall back to the software rasterizer if the requested backend
+        // cannot start (e.g. no Direct2D)
+        {
+            EdgeLight::StartupPhaseScope phase(startup, "renderer");
+            renderer = CreateRenderer(options.renderer);
+            if (!renderer)
+                renderer = EdgeLight::CreateFrameRenderer(EdgeLight::RendererBackend::Software);
+            geometryCache.SetRenderer(renderer.get());
+        }
+
+        {
+            EdgeLight::StartupPhaseScope phase(startup, "monitor enumeration");
+            EnumerateMonitors();
+            topology.Update(DescribeMonitors());
+        }
+
+        {
+            EdgeLight::StartupPhaseScope phase(startup, "window creation");
+            if (CreateOverlayWindow() != S_OK)
+                return E_FAIL;
+        }
+
+        {
+            EdgeLight::StartupPhaseScope phase(startup, "tray icon");
+            SetupTrayIcon();
+        }
+
+        {
+            EdgeLight::StartupPhaseScope phase(startup, "hotkeys");
+            RegisterHotKeys();
+        }
+
+        SetAutoBrightness(options.autoBrightness);
         return S_OK;
     }
 
+    // One wait for input and for the timer wheel's earliest deadline, so
+    // the process wakes only for messages or for work that is due; with
+    // no timer armed it sleeps until the next message
     void RunMessageLoop()
     {
         MSG msg;
-        while (GetMessage(&msg, nullptr, 0, 0))
+        for (;;)
         {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+            while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+            {
+                if (msg.message == WM_QUIT)
+                    return;
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+            }
+
+            timers.Advance();
+            MsgWaitForMultipleObjectsEx(0, nullptr, timers.WaitTimeoutMs(), QS_ALLINPUT, MWMO_INPUTAVAILABLE);
         }
     }
 
@@ -105,32 +434,142 @@ private:
     static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC, LPRECT, LPARAM dwData)
     {
         auto* pThis = reinterpret_cast<EdgeLightWindow*>(dwData);
-        if (pThis->monitorCount < 8)
-        {
-            pThis->monitors[pThis->monitorCount++] = hMonitor;
-        }
+        pThis->monitors.push_back(hMonitor);
         return TRUE;
     }
 
+    int MonitorCount() const
+    {
+        return static_cast<int>(monitors.size());
+    }
+
+    // Stays on the current monitor across re-enumeration if it still
+    // exists, otherwise falls back to the primary one
     void EnumerateMonitors()
     {
-        monitorCount = 0;
+        EDGELIGHT_TRACE_SCOPE("EnumerateMonitors");
+        const HMONITOR previous = monitors.empty() ? nullptr : monitors[currentMonitorIndex];
+        monitors.clear();
         EnumDisplayMonitors(nullptr, nullptr, MonitorEnumProc, reinterpret_cast<LPARAM>(this));
         
         POINT pt = {0, 0};
         HMONITOR primaryMonitor = MonitorFromPoint(pt, MONITOR_DEFAULTTOPRIMARY);
-        for (int i = 0; i < monitorCount; i++)
+        currentMonitorIndex = 0;
+        for (HMONITOR wanted : { previous, primaryMonitor })
         {
-            if (monitors[i] == primaryMonitor)
+            auto found = std::find(monitors.begin(), monitors.end(), wanted);
+            if (wanted && found != monitors.end())
             {
-                currentMonitorIndex = i;
+                currentMonitorIndex = static_cast<int>(found - monitors.begin());
                 break;
             }
         }
     }
 
+    std::vector<EdgeLight::MonitorDesc> DescribeMonitors() const
+    {
+        std::vector<EdgeLight::MonitorDesc> descs;
+        descs.reserve(monitors.size());
+        for (HMONITOR monitor : monitors)
+        {
+            MONITORINFO mi = { sizeof(mi) };
+            GetMonitorInfo(monitor, &mi);
+            EdgeLight::MonitorDesc desc;
+            desc.id = reinterpret_cast<uintptr_t>(monitor);
+            desc.left = mi.rcWork.left;
+            desc.top = mi.rcWork.top;
+            desc.right = mi.rcWork.right;
+            desc.bottom = mi.rcWork.bottom;
+            desc.dpi = MonitorDpi(monitor);
+            descs.push_back(desc);
+        }
+        return descs;
+    }
+
+    // Re-enumerates after a display change (hot-plug, dock/undock,
+    // resolution or taskbar change) and only touches the overlays whose
+    // monitor was added, removed, resized or moved. Unchanged overlays keep
+    // their surfaces and are not repainted.
+    void OnDisplayChange()
+    {
+        EDGELIGHT_TRACE_SCOPE("OnDisplayChange");
+        EnumerateMonitors();
+        if (monitors.empty())
+            return;
+
+        const EdgeLight::TopologyDiff diff = topology.Update(DescribeMonitors());
+        if (diff.Empty())
+            return;
+
+        // Overlays whose monitor went away close; the primary one moves to
+        // the current monitor instead, replacing any overlay already there
+        for (size_t i = overlays.size(); i-- > 1;)
+        {
+            if (!topology.Find(reinterpret_cast<uintptr_t>(overlays[i].monitor)))
+            {
+                DestroyWindow(overlays[i].hwnd);
+                overlays.erase(overlays.begin() + i);
+            }
+        }
+        if (!topology.Find(reinterpret_cast<uintptr_t>(overlays[0].monitor)))
+        {
+            overlays[0].monitor = monitors[currentMonitorIndex];
+            for (size_t i = overlays.size(); i-- > 1;)
+            {
+                if (overlays[i].monitor == overlays[0].monitor)
+                {
+                    DestroyWindow(overlays[i].hwnd);
+                    overlays.erase(overlays.begin() + i);
+                }
+            }
+            PlaceOverlay(overlays[0]);
+        }
+
+        for (const std::vector<EdgeLight::MonitorDesc>* changed : { &diff.resized, &diff.moved })
+        {
+            for (const EdgeLight::MonitorDesc& desc : *changed)
+            {
+                for (Overlay& overlay : overlays)
+                {
+                    if (reinterpret_cast<uintptr_t>(overlay.monitor) == desc.id)
+                        PlaceOverlay(overlay);
+                }
+            }
+        }
+
+        const size_t first = overlays.size();
+        if (allMonitors)
+        {
+            for (const EdgeLight::MonitorDesc& desc : diff.added)
+                CreateOverlay(reinterpret_cast<HMONITOR>(static_cast<uintptr_t>(desc.id)));
+        }
+
+        // Only new geometries are rendered; everything else hits the cache
+        scheduler.SetInterval(RefreshIntervalUs(monitors[currentMonitorIndex]));
+        ApplyBrightness();
+        PrepareSurfaces();
+        for (size_t i = first; i < overlays.size(); i++)
+            ShowOverlay(overlays[i].hwnd, SW_SHOWNOACTIVATE);
+        RepositionControlWindow();
+    }
+
+    // Fits overlay to its monitor's current work area
+    void PlaceOverlay(const Overlay& overlay, UINT flags = SWP_NOACTIVATE)
+    {
+        MONITORINFO mi = { sizeof(mi) };
+        GetMonitorInfo(overlay.monitor, &mi);
+        RECT workArea = mi.rcWork;
+
+        SetWindowPos(overlay.hwnd, HWND_TOPMOST,
+            workArea.left, workArea.top,
+            workArea.right - workArea.left,
+            workArea.bottom - workArea.top,
+            flags);
+    }
+
     HRESULT CreateOverlayWindow()
     {
+        EDGELIGHT_TRACE_SCOPE("CreateOverlayWindow");
         WNDCLASSEX wcex = { sizeof(WNDCLASSEX) };
         wcex.style = CS_HREDRAW | CS_VREDRAW;
         wcex.lpfnWndProc = EdgeLightWindow::WndProc;
@@ -142,12 +581,52 @@ private:
 
         RegisterClassEx(&wcex);
 
+        if (UsesStrips())
+        {
+            WNDCLASSEX strip = { sizeof(WNDCLASSEX) };
+            strip.lpfnWndProc = DefWindowProc;
+            strip.hInstance = GetModuleHandle(nullptr);
+            strip.lpszClassName = L"EdgeLightStripClass";
+            RegisterClassEx(&strip);
+        }
+
+        hwnd = CreateOverlay(monitors[currentMonitorIndex]);
+        if (!hwnd)
+            return E_FAIL;
+
+        scheduler.SetInterval(RefreshIntervalUs(monitors[currentMonitorIndex]));
+        ApplyBrightness();
+        PrepareSurfaces();
+        ShowOverlay(hwnd, SW_SHOW);
+        UpdateWindow(hwnd);
+
+        return S_OK;
+    }
+
+    bool UsesStrips() const
+    {
+        return stripMode != EdgeLight::EdgeStripMode::Single;
+    }
+
+    // In edge-strip mode the overlay window only owns the strips, the
+    // hotkeys and the timers; the strips show the frame, so it stays hidden
+    void ShowOverlay(HWND overlayHwnd, int command)
+    {
+        if (!UsesStrips())
+            ShowWindow(overlayHwnd, command);
+    }
+
+    // Creates a hidden overlay covering monitor's work area and adds it to
+    // overlays. In edge-strip mode it is a plain window that is never
+    // shown, so no work-area-sized layered surface exists at all.
+    HWND CreateOverlay(HMONITOR monitor)
+    {
         MONITORINFO mi = { sizeof(mi) };
-        GetMonitorInfo(monitors[currentMonitorIndex], &mi);
+        GetMonitorInfo(monitor, &mi);
         RECT workArea = mi.rcWork;
 
-        hwnd = CreateWindowEx(
-            WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_TOPMOST | WS_EX_TOOLWINDOW,
+        HWND overlayHwnd = CreateWindowEx(
+            (UsesStrips() ? 0 : WS_EX_LAYERED) | WS_EX_TRANSPARENT | WS_EX_TOPMOST | WS_EX_TOOLWINDOW,
             L"EdgeLightWindowClass",
             L"Windows Edge Light",
             WS_POPUP,
@@ -160,37 +639,93 @@ private:
             this
         );
 
-        if (!hwnd)
-            return E_FAIL;
+        if (overlayHwnd)
+        {
+            Overlay overlay;
+            overlay.hwnd = overlayHwnd;
+            overlay.monitor = monitor;
+            overlays.push_back(overlay);
+            if (autoBrightness.Enabled())
+                ExcludeFromCapture(overlayHwnd, true);
+        }
+        return overlayHwnd;
+    }
 
-        SetLayeredWindowAttributes(hwnd, RGB(0, 0, 0), 0, LWA_COLORKEY);
-        ShowWindow(hwnd, SW_SHOW);
-        UpdateWindow(hwnd);
+    Overlay* FindOverlay(HWND overlayHwnd)
+    {
+        for (Overlay& overlay : overlays)
+        {
+            if (overlay.hwnd == overlayHwnd)
+                return &overlay;
+        }
+        return nullptr;
+    }
 
-        return S_OK;
+    // Light every monitor at once, or just the current one
+    void SetAllMonitors(bool enable)
+    {
+        if (enable == allMonitors || (enable && MonitorCount() <= 1))
+            return;
+
+        allMonitors = enable;
+        if (enable)
+        {
+            const size_t first = overlays.size();
+            for (int i = 0; i < MonitorCount(); i++)
+            {
+                if (i != currentMonitorIndex)
+                    CreateOverlay(monitors[i]);
+            }
+
+            // Render every new overlay's surface in one parallel pass before
+            // showing them
+            ApplyBrightness();
+            PrepareSurfaces();
+            for (size_t i = first; i < overlays.size(); i++)
+                ShowOverlay(overlays[i].hwnd, SW_SHOWNOACTIVATE);
+        }
+        else
+        {
+            for (size_t i = 1; i < overlays.size(); i++)
+                DestroyWindow(overlays[i].hwnd);
+            overlays.resize(1);
+        }
     }
 
+    // Only called when the panel is first shown, or shown again after it
+    // was released; the common controls and the window class are set up
+    // the first time only
     HRESULT CreateControlWindow()
     {
-        WNDCLASSEX wcex = { sizeof(WNDCLASSEX) };
-        wcex.style = CS_HREDRAW | CS_VREDRAW;
-        wcex.lpfnWndProc = EdgeLightWindow::ControlWndProc;
-        wcex.hInstance = GetModuleHandle(nullptr);
-        wcex.hbrBackground = (HBRUSH)(COLOR_BTNFACE + 1);
-        wcex.hCursor = LoadCursor(nullptr, IDC_ARROW);
-        wcex.lpszClassName = L"EdgeLightControlClass";
+        EDGELIGHT_TRACE_SCOPE("CreateControlWindow");
+        if (!controlClassRegistered)
+        {
+            InitCommonControls();
 
-        RegisterClassEx(&wcex);
+            WNDCLASSEX wcex = { sizeof(WNDCLASSEX) };
+            wcex.style = CS_HREDRAW | CS_VREDRAW;
+            wcex.lpfnWndProc = EdgeLightWindow::ControlWndProc;
+            wcex.hInstance = GetModuleHandle(nullptr);
+            wcex.hbrBackground = (HBRUSH)(COLOR_BTNFACE + 1);
+            wcex.hCursor = LoadCursor(nullptr, IDC_ARROW);
+            wcex.lpszClassName = L"EdgeLightControlClass";
+
+            RegisterClassEx(&wcex);
+            controlClassRegistered = true;
+        }
 
         MONITORINFO mi = { sizeof(mi) };
         GetMonitorInfo(monitors[currentMonitorIndex], &mi);
         RECT workArea = mi.rcWork;
 
         int controlWidth = 320;
-        int controlHeight = 140;
+        int controlHeight = 175;
         int controlX = workArea.left + (workArea.right - workArea.left - controlWidth) / 2;
         int controlY = workArea.bottom - controlHeight - 80;
 
+        // The panel's layout is in fixed pixels, so let the system scale it
+        // instead of laying it out per DPI
+        DPI_AWARENESS_CONTEXT previousContext = SetThreadDpiAwarenessContext(DPI_AWARENESS_CONTEXT_UNAWARE_GDISCALED);
         controlHwnd = CreateWindowEx(
             WS_EX_TOPMOST | WS_EX_TOOLWINDOW | WS_EX_LAYERED,
             L"EdgeLightControlClass",
@@ -203,224 +738,886 @@ private:
             GetModuleHandle(nullptr),
             this
         );
+        if (controlHwnd)
+            CreateControlWidgets();
+        SetThreadDpiAwarenessContext(previousContext);
+
+        if (!controlHwnd)
+            return E_FAIL;
+
+        SetLayeredWindowAttributes(controlHwnd, 0, 230, LWA_ALPHA);
+        RepositionControlWindow(); // the position above was taken as logical pixels
+        
+        ShowWindow(controlHwnd, controlPanel.Visible() ? SW_SHOW : SW_HIDE);
+        return S_OK;
+    }
+
+    void DestroyControlWindow()
+    {
+        EDGELIGHT_TRACE_SCOPE("DestroyControlWindow");
+        if (controlHwnd)
+            DestroyWindow(controlHwnd);
+        controlHwnd = nullptr;
+    }
+
+    void CreateControlWidgets()
+    {
+        HINSTANCE hInst = GetModuleHandle(nullptr);
+        HWND hwndParent = controlHwnd;
+        
+        // Thickness slider
+        CreateWindow(L"STATIC", L"Frame Thickness:", WS_CHILD | WS_VISIBLE,
+            10, 10, 120, 20, hwndParent, nullptr, hInst, nullptr);
+        
+        HWND thicknessSlider = CreateWindow(TRACKBAR_CLASS, L"",
+            WS_CHILD | WS_VISIBLE | TBS_HORZ | TBS_AUTOTICKS,
+            130, 10, 150, 25, hwndParent, (HMENU)IDC_THICKNESS_SLIDER, hInst, nullptr);
+        
+        SendMessage(thicknessSlider, TBM_SETRANGE, TRUE, MAKELONG(MIN_THICKNESS, MAX_THICKNESS));
+        SendMessage(thicknessSlider, TBM_SETPOS, TRUE, frameThickness);
+        SendMessage(thicknessSlider, TBM_SETTICFREQ, 10, 0);
+        
+        // Brightness slider
+        CreateWindow(L"STATIC", L"Brightness:", WS_CHILD | WS_VISIBLE,
+            10, 45, 120, 20, hwndParent, nullptr, hInst, nullptr);
+        
+        HWND brightnessSlider = CreateWindow(TRACKBAR_CLASS, L"",
+            WS_CHILD | WS_VISIBLE | TBS_HORZ | TBS_AUTOTICKS,
+            130, 45, 150, 25, hwndParent, (HMENU)IDC_BRIGHTNESS_SLIDER, hInst, nullptr);
+        
+        SendMessage(brightnessSlider, TBM_SETRANGE, TRUE, MAKELONG(MIN_OPACITY, MAX_OPACITY));
+        SendMessage(brightnessSlider, TBM_SETPOS, TRUE, currentOpacity);
+        
+        // Color temperature slider, warm to cool
+        CreateWindow(L"STATIC", L"Temperature:", WS_CHILD | WS_VISIBLE,
+            10, 80, 120, 20, hwndParent, nullptr, hInst, nullptr);
+        
+        HWND temperatureSlider = CreateWindow(TRACKBAR_CLASS, L"",
+            WS_CHILD | WS_VISIBLE | TBS_HORZ | TBS_AUTOTICKS,
+            130, 80, 150, 25, hwndParent, (HMENU)IDC_TEMPERATURE_SLIDER, hInst, nullptr);
+        
+        SendMessage(temperatureSlider, TBM_SETRANGE, TRUE, MAKELONG(MIN_TEMPERATURE, MAX_TEMPERATURE));
+        SendMessage(temperatureSlider, TBM_SETPOS, TRUE, std::clamp(color.kelvin, MIN_TEMPERATURE, MAX_TEMPERATURE));
+        SendMessage(temperatureSlider, TBM_SETTICFREQ, 500, 0);
+        SendMessage(temperatureSlider, TBM_SETLINESIZE, 0, 100);
+        SendMessage(temperatureSlider, TBM_SETPAGESIZE, 0, 500);
+        
+        // Buttons
+        CreateWindow(L"BUTTON", L"Toggle", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+            10, 120, 70, 30, hwndParent, (HMENU)IDC_TOGGLE_BTN, hInst, nullptr);
+        
+        if (MonitorCount() > 1)
+        {
+            CreateWindow(L"BUTTON", L"Monitor", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+                90, 120, 70, 30, hwndParent, (HMENU)IDC_MONITOR_BTN, hInst, nullptr);
+        }
+        
+        CreateWindow(L"BUTTON", L"Close", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+            MonitorCount() > 1 ? 170 : 90, 120, 70, 30, hwndParent, (HMENU)IDC_CLOSE_BTN, hInst, nullptr);
+    }
+
+    void SetupTrayIcon()
+    {
+        nid.cbSize = sizeof(NOTIFYICONDATA);
+        nid.hWnd = hwnd;
+        nid.uID = 1;
+        nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
+        nid.uCallbackMessage = WM_USER + 1;
+        nid.hIcon = LoadIcon(GetModuleHandle(nullptr), MAKEINTRESOURCE(IDI_TRAYICON));
+        wcscpy_s(nid.szTip, L"Windows Edge Light - Right-click for options");
+        
+        Shell_NotifyIcon(NIM_ADD, &nid);
+    }
+
+    void RegisterHotKeys()
+    {
+        RegisterHotKey(hwnd, HOTKEY_TOGGLE, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, 'L');
+        RegisterHotKey(hwnd, HOTKEY_BRIGHTNESS_UP, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, VK_UP);
+        RegisterHotKey(hwnd, HOTKEY_BRIGHTNESS_DOWN, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, VK_DOWN);
+        RegisterHotKey(hwnd, HOTKEY_TOGGLE_CONTROLS, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, 'C');
+    }
+
+    // Shape in logical (96 DPI) pixels, size in device pixels; scaled per
+    // monitor when the surface is drawn
+    EdgeLight::FrameParams CurrentFrameParams(int width, int height) const
+    {
+        EdgeLight::FrameParams params;
+        params.width = width;
+        params.height = height;
+        params.frameThickness = frameThickness;
+        params.cornerRadius = CORNER_RADIUS;
+        params.inset = FRAME_INSET;
+        params.blurSize = GLOW_RINGS;
+        params.glowRadius = GLOW_RADIUS;
+        params.glowStrength = GLOW_STRENGTH;
+        return params;
+    }
+
+    static std::unique_ptr<EdgeLight::IFrameRenderer> CreateRenderer(EdgeLight::RendererBackend backend)
+    {
+        if (backend == EdgeLight::RendererBackend::Gdi)
+            return EdgeLight::CreateGdiFrameRenderer();
+        if (backend == EdgeLight::RendererBackend::Direct2D)
+            return EdgeLight::CreateD2DFrameRenderer();
+        return EdgeLight::CreateFrameRenderer(backend);
+    }
+
+    static int MonitorDpi(HMONITOR monitor)
+    {
+        UINT dpiX = EdgeLight::BASE_DPI, dpiY = EdgeLight::BASE_DPI;
+        if (FAILED(GetDpiForMonitor(monitor, MDT_EFFECTIVE_DPI, &dpiX, &dpiY)))
+            return EdgeLight::BASE_DPI;
+        return static_cast<int>(dpiY);
+    }
+
+    // Called from the render pool: must not touch window state. Keys are
+    // in device pixels and carry the DPI bucket; colorLut is only read,
+    // and always matches the color in the key.
+    std::shared_ptr<EdgeLight::CachedSurface> RenderSurface(const EdgeLight::SurfaceKey& key)
+    {
+        EDGELIGHT_TRACE_SCOPE("RenderSurface");
+        const EdgeLight::FrameParams params = key.ToParams();
+        std::shared_ptr<const EdgeLight::NineSliceFrame> tiles = geometryCache.Acquire(params, key.dpi);
+        auto rendered = std::make_shared<FrameSurface>();
+        rendered->key = key;
+        const EdgeLight::ColorLut* lut = key.color != 0 ? &colorLut : nullptr;
+        if (!tiles || !rendered->Render(params, std::move(tiles), lut))
+            return nullptr;
+        return rendered;
+    }
+
+    EdgeLight::SurfaceRenderFn SurfaceRenderer()
+    {
+        return [this](const EdgeLight::SurfaceKey& key) { return RenderSurface(key); };
+    }
+
+    // params are logical; the surface is drawn for dpi
+    std::shared_ptr<FrameSurface> AcquireSurface(const EdgeLight::FrameParams& params, int dpi)
+    {
+        EdgeLight::FrameParams device = EdgeLight::ScaleFrameParams(params, dpi);
+        const EdgeLight::SurfaceKey key = EdgeLight::SurfaceKey::FromParams(device, EdgeLight::DpiBucket(dpi), color.Key());
+        return std::static_pointer_cast<FrameSurface>(surfaceCache.Acquire(key, SurfaceRenderer()));
+    }
+
+    // Finds every overlay's surface for the current state. Overlays with the
+    // same work area size and DPI bucket share one surface, and missing surfaces are
+    // rendered in parallel on the pool.
+    void PrepareSurfaces()
+    {
+        if (perPixelAlpha)
+        {
+            for (Overlay& overlay : overlays)
+                UpdateLayeredOverlay(overlay);
+            return;
+        }
+
+        if (!isLightOn)
+            return;
+        EDGELIGHT_TRACE_SCOPE("PrepareSurfaces");
+
+        std::vector<EdgeLight::MonitorDesc> descs;
+        descs.reserve(overlays.size());
+        for (const Overlay& overlay : overlays)
+        {
+            RECT rc;
+            GetClientRect(overlay.hwnd, &rc);
+            EdgeLight::MonitorDesc desc;
+            desc.id = reinterpret_cast<uintptr_t>(overlay.monitor);
+            desc.right = rc.right - rc.left;
+            desc.bottom = rc.bottom - rc.top;
+            desc.dpi = MonitorDpi(overlay.monitor);
+            descs.push_back(desc);
+        }
+
+        std::vector<std::shared_ptr<EdgeLight::CachedSurface>> surfaces;
+        orchestrator.Prepare(descs, CurrentFrameParams(0, 0), SurfaceRenderer(), surfaces, color.Key());
+        for (size_t i = 0; i < overlays.size(); i++)
+            overlays[i].surface = std::static_pointer_cast<FrameSurface>(surfaces[i]);
+    }
+
+    // Per-pixel alpha mode: the frame is rasterized as premultiplied BGRA
+    // straight into the overlay's DIB section and handed to
+    // UpdateLayeredWindow, so the glow fades into the desktop instead of
+    // being cut off at the color key. A thickness change re-rasterizes only
+    // the moved inner edge in place; everything else is left as it was.
+    // Colors are applied with the premultiplied table, which reads alpha,
+    // so a color change recolors the pixels in place without a render.
+    void UpdateLayeredOverlay(Overlay& overlay)
+    {
+        EDGELIGHT_TRACE_SCOPE("UpdateLayeredOverlay");
+        RECT rc;
+        GetClientRect(overlay.hwnd, &rc);
+        const int width = rc.right - rc.left;
+        const int height = rc.bottom - rc.top;
+
+        // The monitor's DPI rather than the window's: in edge-strip mode
+        // the overlay is never shown
+        EdgeLight::FrameParams params = EdgeLight::ScaleFrameParams(CurrentFrameParams(width, height),
+                                                                    MonitorDpi(overlay.monitor));
+        if (!isLightOn)
+            params.opacity = 0;
+
+        if (UsesStrips())
+        {
+            UpdateStrips(overlay, params);
+            return;
+        }
+
+        if (!overlay.layered)
+            overlay.layered = std::make_shared<EdgeLight::LayeredSurface>();
+        const bool reused = overlay.layered->Width() == width && overlay.layered->Height() == height;
+        if (!overlay.layered->Resize(width, height))
+            return;
+
+        std::vector<EdgeLight::SpanRect> rects;
+        const EdgeLight::BgraBuffer pixels = overlay.layered->Pixels();
+        const uint32_t colorKey = color.Key();
+        if (reused && EdgeLight::FrameDelta::Compute(overlay.layeredParams, params, rects))
+        {
+            if (rects.empty() && overlay.layeredColor == colorKey)
+                return;
+            EdgeLight::SdfFrameRenderer::RenderRects(params, rects.data(), rects.size(), pixels);
+            if (overlay.layeredColor != colorKey)
+                EdgeLight::ApplyColorLut(colorLut, pixels);
+            else if (colorKey != 0)
+                EdgeLight::ApplyColorLut(colorLut, rects.data(), rects.size(), pixels);
+        }
+        else
+        {
+            EdgeLight::SdfFrameRenderer::Render(params, pixels);
+            if (colorKey != 0)
+                EdgeLight::ApplyColorLut(colorLut, pixels);
+        }
+        overlay.layeredParams = params;
+        overlay.layeredColor = colorKey;
+
+        EDGELIGHT_TRACE_SCOPE("UpdateLayeredOverlay.Present");
+        overlay.layered->Present(overlay.hwnd, CurrentAlpha());
+        NoteFirstPaint();
+    }
+
+    // Edge-strip mode: the frame is split into windows that only cover
+    // what it and its glow can light, so the compositor blends those
+    // instead of a work-area-sized, mostly transparent surface. Strips are
+    // small, so each update re-renders them whole.
+    void UpdateStrips(Overlay& overlay, const EdgeLight::FrameParams& params)
+    {
+        const EdgeLight::EdgeStripLayout layout = EdgeLight::EdgeStripLayout::Solve(params, stripMode);
+        while (overlay.strips.size() > static_cast<size_t>(layout.count))
+        {
+            DestroyWindow(overlay.strips.back().hwnd);
+            overlay.strips.pop_back();
+        }
+        while (overlay.strips.size() < static_cast<size_t>(layout.count))
+        {
+            StripWindow strip;
+            strip.hwnd = CreateWindowEx(
+                WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_TOPMOST | WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE,
+                L"EdgeLightStripClass",
+                L"Windows Edge Light",
+                WS_POPUP,
+                0, 0, 0, 0,
+                overlay.hwnd,   // owned, so destroyed with the overlay
+                nullptr,
+                GetModuleHandle(nullptr),
+                nullptr
+            );
+            if (!strip.hwnd)
+                break;
+            if (autoBrightness.Enabled())
+                ExcludeFromCapture(strip.hwnd, true);
+            strip.surface = std::make_shared<EdgeLight::LayeredSurface>();
+            overlay.strips.push_back(strip);
+        }
+
+        RECT area;
+        GetWindowRect(overlay.hwnd, &area);
+        const BYTE alpha = CurrentAlpha();
+        for (size_t i = 0; i < overlay.strips.size(); i++)
+        {
+            const EdgeLight::SpanRect& piece = layout.pieces[i];
+            const StripWindow& strip = overlay.strips[i];
+            if (!strip.surface->Resize(piece.right - piece.left, piece.bottom - piece.top))
+                continue;
+
+            const EdgeLight::BgraBuffer pixels = strip.surface->Pixels();
+            EdgeLight::SdfFrameRenderer::RenderRegion(params, piece, pixels);
+            if (color.Key() != 0)
+                EdgeLight::ApplyColorLut(colorLut, pixels);
+            strip.surface->PresentAt(strip.hwnd, area.left + piece.left, area.top + piece.top, alpha);
+            if (!IsWindowVisible(strip.hwnd))
+                ShowWindow(strip.hwnd, SW_SHOWNOACTIVATE);
+        }
+        NoteFirstPaint();
+    }
+
+    void OnPaint(HWND overlayHwnd)
+    {
+        EDGELIGHT_TRACE_SCOPE("OnPaint");
+        PAINTSTRUCT ps;
+        HDC hdc = BeginPaint(overlayHwnd, &ps);
+        Overlay* overlay = FindOverlay(overlayHwnd);
+
+        // Layered windows updated with UpdateLayeredWindow have nothing to paint
+        if (!overlay || perPixelAlpha)
+        {
+            EndPaint(overlayHwnd, &ps);
+            return;
+        }
+        
+        RECT rc;
+        GetClientRect(overlayHwnd, &rc);
+        int width = rc.right - rc.left;
+        int height = rc.bottom - rc.top;
+        HBRUSH blackBrush = reinterpret_cast<HBRUSH>(gdiPool.Brush(0));
+        if (!blackBrush)
+            blackBrush = (HBRUSH)GetStockObject(BLACK_BRUSH);
+        
+        // A resized window has no previous contents; start from the color key once
+        if (width != overlay->paintedWidth || height != overlay->paintedHeight)
+        {
+            FillRect(hdc, &rc, blackBrush);
+            overlay->paintedWidth = width;
+            overlay->paintedHeight = height;
+            overlay->litSurface.reset();
+        }
+        
+        std::shared_ptr<FrameSurface> surface;
+        if (isLightOn && width > 0 && height > 0)
+        {
+            // Normally prepared ahead by PrepareSurfaces; a paint that beats
+            // it (e.g. right after a resize) fetches its own
+            surface = overlay->surface;
+            if (!surface || surface->Width() != width || surface->Height() != height)
+            {
+                EDGELIGHT_TRACE_SCOPE("OnPaint.AcquireSurface");
+                surface = AcquireSurface(CurrentFrameParams(width, height), static_cast<int>(GetDpiForWindow(overlayHwnd)));
+                overlay->surface = surface;
+            }
+        }
+
+        // Blank out what the previous geometry lit but the new one won't
+        // cover. Both regions come from the pool and the difference goes
+        // into its scratch region, so this creates no GDI objects once the
+        // geometries have been seen.
+        if (overlay->litSurface && overlay->litSurface != surface)
+        {
+            HRGN staleRegion = nullptr;
+            {
+                EDGELIGHT_TRACE_SCOPE("OnPaint.CreateRegions");
+                const FrameSurface& lit = *overlay->litSurface;
+                staleRegion = reinterpret_cast<HRGN>(gdiPool.Region(lit.key, lit.spans));
+                HRGN scratch = reinterpret_cast<HRGN>(gdiPool.Scratch());
+                if (surface && staleRegion && scratch)
+                {
+                    HRGN nextRegion = reinterpret_cast<HRGN>(gdiPool.Region(surface->key, surface->spans));
+                    CombineRgn(scratch, staleRegion, nextRegion, RGN_DIFF);
+                    staleRegion = scratch;
+                }
+            }
+            if (staleRegion)
+            {
+                EDGELIGHT_TRACE_SCOPE("OnPaint.FillRgn");
+                FillRgn(hdc, staleRegion, blackBrush);
+            }
+        }
+
+        if (surface)
+        {
+            EDGELIGHT_TRACE_SCOPE("OnPaint.Present");
+            surface->Present(hdc);
+        }
+        overlay->litSurface = surface;
+        
+        EndPaint(overlayHwnd, &ps);
+        NoteFirstPaint();
+    }
+
+    // Closes the startup timeline at the first frame on screen and sends
+    // its report to the debugger; SaveTrace shows it too
+    void NoteFirstPaint()
+    {
+        if (startup.Milestone("first paint"))
+            OutputDebugStringA(startup.Report().c_str());
+    }
+
+    // Refresh period of the display showing the overlay, for pacing renders
+    static int64_t RefreshIntervalUs(HMONITOR monitor)
+    {
+        MONITORINFOEX mi = {};
+        mi.cbSize = sizeof(mi);
+        DEVMODE mode = {};
+        mode.dmSize = sizeof(mode);
+
+        if (monitor && GetMonitorInfo(monitor, &mi) &&
+            EnumDisplaySettings(mi.szDevice, ENUM_CURRENT_SETTINGS, &mode) &&
+            mode.dmDisplayFrequency > 1)
+        {
+            return 1000000 / mode.dmDisplayFrequency;
+        }
+        return EdgeLight::RenderScheduler::DEFAULT_INTERVAL_US;
+    }
+
+    // State changes only mark what is dirty; the scheduler releases them at
+    // most once per refresh interval, so slider drags and held hotkeys
+    // render the latest state instead of queueing a repaint per event
+    void ScheduleRender(uint32_t flags)
+    {
+        scheduler.Invalidate(flags);
+        PumpScheduler();
+        memory.Touch();
+        PumpMemory();
+    }
+
+    void ArmTimer(EdgeLight::TimerWheel::TimerId id, int64_t delayUs)
+    {
+        timers.Arm(id, delayUs);
+        SyncModalTimer();
+    }
+
+    void DisarmTimer(EdgeLight::TimerWheel::TimerId id)
+    {
+        timers.Disarm(id);
+        SyncModalTimer();
+    }
+
+    // Menus and message boxes pump messages in their own loop, which never
+    // reaches RunMessageLoop's wait. While one runs, TIMER_WHEEL is set
+    // for the earliest deadline so fades and renders still happen.
+    void SyncModalTimer()
+    {
+        const uint32_t waitMs = modalDepth > 0 ? timers.WaitTimeoutMs() : EdgeLight::TimerWheel::WAIT_FOREVER;
+        if (waitMs == EdgeLight::TimerWheel::WAIT_FOREVER)
+        {
+            if (modalTimerArmed)
+                KillTimer(hwnd, TIMER_WHEEL);
+            modalTimerArmed = false;
+            return;
+        }
+
+        SetTimer(hwnd, TIMER_WHEEL, std::clamp<UINT>(waitMs, USER_TIMER_MINIMUM, USER_TIMER_MAXIMUM), nullptr);
+        modalTimerArmed = true;
+    }
+
+    void BeginModal()
+    {
+        modalDepth++;
+        SyncModalTimer();
+    }
+
+    void EndModal()
+    {
+        modalDepth--;
+        SyncModalTimer();
+    }
+
+    void PumpScheduler()
+    {
+        const int64_t wait = scheduler.TimeUntilDue();
+        if (wait < 0)
+        {
+            DisarmTimer(renderTimer);
+            return;
+        }
+
+        if (wait == 0)
+        {
+            RenderScheduled();
+            return;
+        }
+
+        if (!timers.Armed(renderTimer))
+            ArmTimer(renderTimer, wait);
+    }
+
+    void RenderScheduled()
+    {
+        const uint32_t dirty = scheduler.BeginFrame();
+        if (dirty & EdgeLight::DIRTY_BRIGHTNESS)
+            ApplyBrightness();
+        if (dirty & EdgeLight::DIRTY_GEOMETRY)
+        {
+            PrepareSurfaces();
+            if (!perPixelAlpha)
+            {
+                for (const Overlay& overlay : overlays)
+                    InvalidateGeometryChange(overlay);
+            }
+            memory.Enforce();
+        }
+    }
 
-        if (!controlHwnd)
-            return E_FAIL;
+    // Everything large that is kept between renders. The surfaces on
+    // screen are held by their overlays as well, so releasing the caches
+    // only drops what is not showing. The per-pixel DIBs can go entirely,
+    // as the compositor keeps its own copy and the next update renders in
+    // full; but while the light is on that next update is the next slider
+    // notch, so the ceiling only takes them while the light is off and the
+    // idle trim takes them either way.
+    void RegisterMemoryHolders()
+    {
+        memory.Register(EdgeLight::MemoryCategory::Surfaces,
+                        [this] { return surfaceCache.Stats().bytes; },
+                        [this](size_t keep) { surfaceCache.Trim(keep); });
+        memory.Register(EdgeLight::MemoryCategory::Tiles,
+                        [this] { return geometryCache.Stats().bytes; },
+                        [this](size_t keep)
+                        {
+                            if (keep < geometryCache.Stats().bytes)
+                                geometryCache.Clear();
+                        });
+        memory.Register(EdgeLight::MemoryCategory::Layered,
+                        [this] { return isLightOn ? 0 : LayeredBytes(); },
+                        [this](size_t keep) { ReleaseLayered(keep); });
+        memory.RegisterPinned(EdgeLight::MemoryCategory::Layered,
+                              [this] { return isLightOn ? LayeredBytes() : 0; },
+                              [this](size_t keep) { ReleaseLayered(keep); });
 
-        SetLayeredWindowAttributes(controlHwnd, 0, 230, LWA_ALPHA);
-        
-        // Create controls
-        CreateControlWidgets();
-        
-        ShowWindow(controlHwnd, controlsVisible ? SW_SHOW : SW_HIDE);
-        return S_OK;
+        // The auto-brightness capture DIB grows back on the next capture
+        memory.Register(EdgeLight::MemoryCategory::Sampler,
+                        [this] { return screenSampler.Bytes(); },
+                        [this](size_t keep)
+                        {
+                            if (keep < screenSampler.Bytes())
+                                screenSampler.Release();
+                        });
     }
 
-    void CreateControlWidgets()
+    static size_t SurfaceBytes(const std::shared_ptr<EdgeLight::LayeredSurface>& surface)
     {
-        HINSTANCE hInst = GetModuleHandle(nullptr);
-        HWND hwndParent = controlHwnd;
-        
-        // Thickness slider
-        CreateWindow(L"STATIC", L"Frame Thickness:", WS_CHILD | WS_VISIBLE,
-            10, 10, 120, 20, hwndParent, nullptr, hInst, nullptr);
-        
-        HWND thicknessSlider = CreateWindow(TRACKBAR_CLASS, L"",
-            WS_CHILD | WS_VISIBLE | TBS_HORZ | TBS_AUTOTICKS,
-            130, 10, 150, 25, hwndParent, (HMENU)IDC_THICKNESS_SLIDER, hInst, nullptr);
-        
-        SendMessage(thicknessSlider, TBM_SETRANGE, TRUE, MAKELONG(MIN_THICKNESS, MAX_THICKNESS));
-        SendMessage(thicknessSlider, TBM_SETPOS, TRUE, frameThickness);
-        SendMessage(thicknessSlider, TBM_SETTICFREQ, 10, 0);
-        
-        // Brightness slider
-        CreateWindow(L"STATIC", L"Brightness:", WS_CHILD | WS_VISIBLE,
-            10, 45, 120, 20, hwndParent, nullptr, hInst, nullptr);
-        
-        HWND brightnessSlider = CreateWindow(TRACKBAR_CLASS, L"",
-            WS_CHILD | WS_VISIBLE | TBS_HORZ | TBS_AUTOTICKS,
-            130, 45, 150, 25, hwndParent, (HMENU)IDC_BRIGHTNESS_SLIDER, hInst, nullptr);
-        
-        SendMessage(brightnessSlider, TBM_SETRANGE, TRUE, MAKELONG(MIN_OPACITY, MAX_OPACITY));
-        SendMessage(brightnessSlider, TBM_SETPOS, TRUE, currentOpacity);
-        
-        // Buttons
-        CreateWindow(L"BUTTON", L"Toggle", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-            10, 85, 70, 30, hwndParent, (HMENU)IDC_TOGGLE_BTN, hInst, nullptr);
-        
-        if (monitorCount > 1)
+        return surface ? static_cast<size_t>(surface->Width()) * surface->Height() * 4 : 0;
+    }
+
+    size_t LayeredBytes() const
+    {
+        size_t bytes = 0;
+        for (const Overlay& overlay : overlays)
         {
-            CreateWindow(L"BUTTON", L"Monitor", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-                90, 85, 70, 30, hwndParent, (HMENU)IDC_MONITOR_BTN, hInst, nullptr);
+            bytes += SurfaceBytes(overlay.layered);
+            for (const StripWindow& strip : overlay.strips)
+                bytes += SurfaceBytes(strip.surface);
         }
-        
-        CreateWindow(L"BUTTON", L"Close", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-            monitorCount > 1 ? 170 : 90, 85, 70, 30, hwndParent, (HMENU)IDC_CLOSE_BTN, hInst, nullptr);
+        return bytes;
     }
 
-    void SetupTrayIcon()
+    // Secondary overlays first; strips are dropped per overlay, as they
+    // are only re-rendered together
+    void ReleaseLayered(size_t keep)
     {
-        nid.cbSize = sizeof(NOTIFYICONDATA);
-        nid.hWnd = hwnd;
-        nid.uID = 1;
-        nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
-        nid.uCallbackMessage = WM_USER + 1;
-        nid.hIcon = LoadIcon(GetModuleHandle(nullptr), MAKEINTRESOURCE(IDI_TRAYICON));
-        wcscpy_s(nid.szTip, L"Windows Edge Light - Right-click for options");
-        
-        Shell_NotifyIcon(NIM_ADD, &nid);
+        for (size_t i = overlays.size(); i-- > 0 && LayeredBytes() > keep;)
+        {
+            Overlay& overlay = overlays[i];
+            overlay.layered.reset();
+            for (StripWindow& strip : overlay.strips)
+                strip.surface = std::make_shared<EdgeLight::LayeredSurface>();
+        }
     }
 
-    void RegisterHotKeys()
+    // Arms memoryTimer for the idle trim. Re-arming is cheap, so every
+    // change simply moves the deadline.
+    void PumpMemory()
     {
-        RegisterHotKey(hwnd, HOTKEY_TOGGLE, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, 'L');
-        RegisterHotKey(hwnd, HOTKEY_BRIGHTNESS_UP, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, VK_UP);
-        RegisterHotKey(hwnd, HOTKEY_BRIGHTNESS_DOWN, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, VK_DOWN);
-        RegisterHotKey(hwnd, HOTKEY_TOGGLE_CONTROLS, MOD_CONTROL | MOD_SHIFT | MOD_NOREPEAT, 'C');
+        const int64_t wait = memory.TimeUntilIdle();
+        if (wait < 0)
+            DisarmTimer(memoryTimer);
+        else
+            ArmTimer(memoryTimer, wait);
     }
 
-    void OnPaint()
+    // Nothing changed for the idle timeout: drop what can be rebuilt and
+    // hand the now unused pages back to the system
+    void OnMemoryTimer()
     {
-        PAINTSTRUCT ps;
-        HDC hdc = BeginPaint(hwnd, &ps);
-        
-        RECT rc;
-        GetClientRect(hwnd, &rc);
-        
-        // Fill with black (transparent color key)
-        HBRUSH blackBrush = (HBRUSH)GetStockObject(BLACK_BRUSH);
-        FillRect(hdc, &rc, blackBrush);
-        
-        if (isLightOn)
+        if (!memory.IdleDue())
+        {
+            PumpMemory();
+            return;
+        }
+
+        EDGELIGHT_TRACE_SCOPE("TrimWorkingSet");
+        HeapCompact(GetProcessHeap(), 0);
+        SetProcessWorkingSetSize(GetCurrentProcess(), static_cast<SIZE_T>(-1), static_cast<SIZE_T>(-1));
+    }
+
+    // A thickness change only moves the inner edge, so only a ring around
+    // the old and new edges differs; invalidating just that clips the
+    // present and the stale-region fill in OnPaint to it. The software
+    // tiles are bit-exact with the SDF the delta is derived from; the
+    // other backends are not guaranteed to be, so they repaint in full.
+    void InvalidateGeometryChange(const Overlay& overlay)
+    {
+        std::vector<EdgeLight::SpanRect> rects;
+        if (!overlay.litSurface || !overlay.surface ||
+            renderer->Backend() != EdgeLight::RendererBackend::Software ||
+            overlay.litSurface->key.dpi != overlay.surface->key.dpi ||
+            overlay.litSurface->key.color != overlay.surface->key.color ||
+            !EdgeLight::FrameDelta::Compute(overlay.litSurface->key.ToParams(), overlay.surface->key.ToParams(), rects))
+        {
+            InvalidateRect(overlay.hwnd, nullptr, FALSE);
+            return;
+        }
+
+        for (const EdgeLight::SpanRect& rect : rects)
+        {
+            const RECT dirtyRect = { rect.left, rect.top, rect.right, rect.bottom };
+            InvalidateRect(overlay.hwnd, &dirtyRect, FALSE);
+        }
+    }
+
+    // Fades only change the layered window's constant alpha over the cached
+    // surface, so each step is one cheap present and nothing is re-rendered
+    void StartFade(float target, FadeAction action)
+    {
+        EdgeLight::TransitionState state;
+        state.opacity = target;
+        fade.Start(state, FADE_DURATION_US, EdgeLight::Easing::EaseInOut);
+        fadeAction = action;
+
+        if (!timers.Armed(fadeTimer))
+            ArmTimer(fadeTimer, scheduler.Interval());
+    }
+
+    // One step per refresh interval while the fade runs; the timer is not
+    // re-armed once it is done
+    void OnFadeTimer()
+    {
+        fadeOpacity = fade.Sample().opacity;
+        ScheduleRender(EdgeLight::DIRTY_BRIGHTNESS);
+        if (fade.IsRunning())
+        {
+            ArmTimer(fadeTimer, scheduler.Interval());
+            return;
+        }
+
+        const FadeAction action = fadeAction;
+        const FadeAction queued = queuedFadeAction;
+        fadeAction = FadeAction::None;
+        queuedFadeAction = FadeAction::None;
+        if (action == FadeAction::TurnOff)
         {
-            int innerRadius = CORNER_RADIUS - frameThickness;
-            if (innerRadius < 10) innerRadius = 10;
-            
-            // Create main frame region
-            HRGN outerRegion = CreateRoundRectRgn(20, 20, rc.right - 20, rc.bottom - 20, 
-                                                   CORNER_RADIUS * 2, CORNER_RADIUS * 2);
-            HRGN innerRegion = CreateRoundRectRgn(20 + frameThickness, 20 + frameThickness,
-                                                   rc.right - 20 - frameThickness, 
-                                                   rc.bottom - 20 - frameThickness,
-                                                   innerRadius * 2, innerRadius * 2);
-            
-            HRGN frameRegion = CreateRectRgn(0, 0, 0, 0);
-            CombineRgn(frameRegion, outerRegion, innerRegion, RGN_DIFF);
-            
-            // Draw blur/glow layers on both inner and outer edges
-            int intensity = (255 * currentOpacity) / 255;
-            int blurSize = 2; // Very subtle blur radius
-            
-            // Outer blur (outside the frame)
-            for (int i = blurSize; i >= 1; i--)
+            isLightOn = false;
+            ScheduleRender(EdgeLight::DIRTY_GEOMETRY);
+            if (queued == FadeAction::SwitchMonitor)
+                MoveToNextMonitor();
+        }
+        else if (action == FadeAction::SwitchMonitor)
+        {
+            MoveToNextMonitor();
+            if (queued == FadeAction::TurnOff)
             {
-                int offset = i;
-                int blurIntensity = (intensity * (blurSize - i + 1)) / (blurSize + 3);
-                
-                HRGN blurOuter = CreateRoundRectRgn(
-                    20 - offset, 20 - offset,
-                    rc.right - 20 + offset, rc.bottom - 20 + offset,
-                    (CORNER_RADIUS + offset) * 2, (CORNER_RADIUS + offset) * 2);
-                    
-                HRGN blurInner = CreateRoundRectRgn(
-                    20 - offset + 1, 20 - offset + 1,
-                    rc.right - 20 + offset - 1, rc.bottom - 20 + offset - 1,
-                    (CORNER_RADIUS + offset - 1) * 2, (CORNER_RADIUS + offset - 1) * 2);
-                
-                HRGN blurRegion = CreateRectRgn(0, 0, 0, 0);
-                CombineRgn(blurRegion, blurOuter, blurInner, RGN_DIFF);
-                
-                HBRUSH blurBrush = CreateSolidBrush(RGB(blurIntensity, blurIntensity, blurIntensity));
-                FillRgn(hdc, blurRegion, blurBrush);
-                
-                DeleteObject(blurBrush);
-                DeleteObject(blurRegion);
-                DeleteObject(blurInner);
-                DeleteObject(blurOuter);
+                isLightOn = false;
+                ScheduleRender(EdgeLight::DIRTY_GEOMETRY);
             }
-            
-            // Draw main frame
-            HBRUSH mainBrush = CreateSolidBrush(RGB(intensity, intensity, intensity));
-            FillRgn(hdc, frameRegion, mainBrush);
-            
-            // Inner blur (inside the frame)
-            for (int i = 1; i <= blurSize; i++)
+            else
             {
-                int offset = i;
-                int blurIntensity = (intensity * (blurSize - i + 1)) / (blurSize + 3);
-                
-                int innerEdge = 20 + frameThickness;
-                int adjustedInnerRadius = innerRadius - offset;
-                if (adjustedInnerRadius < 10) adjustedInnerRadius = 10;
-                
-                HRGN blurOuter = CreateRoundRectRgn(
-                    innerEdge - offset, innerEdge - offset,
-                    rc.right - innerEdge + offset, rc.bottom - innerEdge + offset,
-                    (adjustedInnerRadius + offset) * 2, (adjustedInnerRadius + offset) * 2);
-                    
-                HRGN blurInner = CreateRoundRectRgn(
-                    innerEdge - offset + 1, innerEdge - offset + 1,
-                    rc.right - innerEdge + offset - 1, rc.bottom - innerEdge + offset - 1,
-                    (adjustedInnerRadius + offset - 1) * 2, (adjustedInnerRadius + offset - 1) * 2);
-                
-                HRGN blurRegion = CreateRectRgn(0, 0, 0, 0);
-                CombineRgn(blurRegion, blurOuter, blurInner, RGN_DIFF);
-                
-                HBRUSH blurBrush = CreateSolidBrush(RGB(blurIntensity, blurIntensity, blurIntensity));
-                FillRgn(hdc, blurRegion, blurBrush);
-                
-                DeleteObject(blurBrush);
-                DeleteObject(blurRegion);
-                DeleteObject(blurInner);
-                DeleteObject(blurOuter);
+                StartFade(1.0f, FadeAction::None);
             }
-            
-            // Cleanup
-            DeleteObject(mainBrush);
-            DeleteObject(frameRegion);
-            DeleteObject(innerRegion);
-            DeleteObject(outerRegion);
         }
-        
-        EndPaint(hwnd, &ps);
     }
 
     void ToggleLight()
     {
-        isLightOn = !isLightOn;
-        InvalidateRect(hwnd, nullptr, FALSE);
+        // Half way through a switch the light is going out anyway; a
+        // toggle only decides whether it comes back on the next monitor
+        if (fadeAction == FadeAction::SwitchMonitor)
+        {
+            queuedFadeAction = queuedFadeAction == FadeAction::TurnOff ? FadeAction::None : FadeAction::TurnOff;
+            return;
+        }
+
+        if (isLightOn && fadeAction != FadeAction::TurnOff)
+        {
+            StartFade(0.0f, FadeAction::TurnOff);
+            return;
+        }
+
+        // Changing our mind half way through fading out: a switch asked
+        // for meanwhile still happens, on the way back in
+        if (fadeAction == FadeAction::TurnOff && queuedFadeAction == FadeAction::SwitchMonitor)
+        {
+            queuedFadeAction = FadeAction::None;
+            StartFade(0.0f, FadeAction::SwitchMonitor);
+            return;
+        }
+
+        // Turning on, or changing our mind half way through fading out
+        queuedFadeAction = FadeAction::None;
+        if (!isLightOn)
+        {
+            isLightOn = true;
+            EdgeLight::TransitionState hidden;
+            hidden.opacity = 0.0f;
+            fade.Reset(hidden);
+            fadeOpacity = 0.0f;
+            ScheduleRender(EdgeLight::DIRTY_GEOMETRY | EdgeLight::DIRTY_BRIGHTNESS);
+            PumpAutoBrightness();
+        }
+        StartFade(1.0f, FadeAction::None);
     }
 
     void IncreaseBrightness()
     {
+        SetAutoBrightness(false);
         if (currentOpacity < MAX_OPACITY)
         {
             currentOpacity = min(MAX_OPACITY, currentOpacity + OPACITY_STEP);
-            InvalidateRect(hwnd, nullptr, FALSE);
+            ScheduleRender(EdgeLight::DIRTY_BRIGHTNESS);
             UpdateBrightnessSlider();
         }
     }
 
     void DecreaseBrightness()
     {
+        SetAutoBrightness(false);
         if (currentOpacity > MIN_OPACITY)
         {
             currentOpacity = max(MIN_OPACITY, currentOpacity - OPACITY_STEP);
-            InvalidateRect(hwnd, nullptr, FALSE);
+            ScheduleRender(EdgeLight::DIRTY_BRIGHTNESS);
             UpdateBrightnessSlider();
         }
     }
 
     void SetBrightness(int value)
     {
+        SetAutoBrightness(false);
         currentOpacity = max(MIN_OPACITY, min(MAX_OPACITY, value));
-        InvalidateRect(hwnd, nullptr, FALSE);
+        ScheduleRender(EdgeLight::DIRTY_BRIGHTNESS);
+    }
+
+    // Brightness is the layered window's constant alpha. The frame pixels
+    // stay at full intensity, so a change is one present by the compositor
+    // and nothing is re-rasterized or repainted.
+    void ApplyBrightness()
+    {
+        const BYTE alpha = CurrentAlpha();
+        for (const Overlay& overlay : overlays)
+        {
+            if (perPixelAlpha)
+            {
+                if (!UsesStrips())
+                    EdgeLight::LayeredSurface::SetAlpha(overlay.hwnd, alpha);
+                for (const StripWindow& strip : overlay.strips)
+                    EdgeLight::LayeredSurface::SetAlpha(strip.hwnd, alpha);
+            }
+            else
+                SetLayeredWindowAttributes(overlay.hwnd, RGB(0, 0, 0), alpha, LWA_COLORKEY | LWA_ALPHA);
+        }
+    }
+
+    // Auto brightness spans the same range as the manual steps: full
+    // opacity over black content down to the minimum over white
+    static EdgeLight::AutoBrightnessSettings AutoBrightnessRange()
+    {
+        EdgeLight::AutoBrightnessSettings settings;
+        settings.darkOpacity = MAX_OPACITY;
+        settings.brightOpacity = MIN_OPACITY;
+        return settings;
+    }
+
+    // Moving the brightness by hand (hotkeys, slider, tray) turns the
+    // automatic mode off again
+    void SetAutoBrightness(bool enabled)
+    {
+        if (enabled == autoBrightness.Enabled())
+            return;
+
+        autoBrightness.SetEnabled(enabled);
+        captureExcluded = enabled;
+        for (const Overlay& overlay : overlays)
+        {
+            ExcludeFromCapture(overlay.hwnd, enabled);
+            for (const StripWindow& strip : overlay.strips)
+                ExcludeFromCapture(strip.hwnd, enabled);
+        }
+        if (!enabled)
+            screenSampler.Release();
+        PumpAutoBrightness();
+    }
+
+    // Where this is not supported the light would show up in its own
+    // captures, so sampling moves to the content just inside it
+    void ExcludeFromCapture(HWND window, bool exclude)
+    {
+        if (!EdgeLight::ScreenSampler::ExcludeFromCapture(window, exclude) && exclude)
+            captureExcluded = false;
+    }
+
+    // Arms autoBrightnessTimer for the next capture while the light is
+    // on; autoBrightness caps the capture rate
+    void PumpAutoBrightness()
+    {
+        const int64_t wait = isLightOn ? autoBrightness.TimeUntilSample() : -1;
+        if (wait < 0)
+            DisarmTimer(autoBrightnessTimer);
+        else if (!timers.Armed(autoBrightnessTimer))
+            ArmTimer(autoBrightnessTimer, wait);
+    }
+
+    void OnAutoBrightnessTimer()
+    {
+        if (isLightOn && autoBrightness.TimeUntilSample() == 0 && autoBrightness.Feed(SampleScreen()))
+        {
+            currentOpacity = std::clamp(autoBrightness.Opacity(), MIN_OPACITY, MAX_OPACITY);
+            ScheduleRender(EdgeLight::DIRTY_BRIGHTNESS);
+            UpdateBrightnessSlider();
+        }
+        PumpAutoBrightness();
+    }
+
+    // Mean luma of the screen under every overlay's frame (see
+    // LuminanceBands), read from one capture per band that GDI has already
+    // decimated to every LUMINANCE_STEP-th pixel. -1 when nothing could be
+    // captured.
+    double SampleScreen()
+    {
+        EDGELIGHT_TRACE_SCOPE("SampleScreen");
+        EdgeLight::LuminanceSum sum;
+        for (const Overlay& overlay : overlays)
+        {
+            RECT area;
+            GetWindowRect(overlay.hwnd, &area);
+            const EdgeLight::FrameParams params = EdgeLight::ScaleFrameParams(
+                CurrentFrameParams(area.right - area.left, area.bottom - area.top),
+                MonitorDpi(overlay.monitor));
+
+            EdgeLight::SpanRect bands[4];
+            const int count = EdgeLight::LuminanceBands(params, captureExcluded, bands);
+            for (int i = 0; i < count; i++)
+            {
+                const EdgeLight::SpanRect& band = bands[i];
+                const int width = band.right - band.left;
+                const int height = band.bottom - band.top;
+                const EdgeLight::BgraBuffer pixels = screenSampler.Capture(area.left + band.left, area.top + band.top,
+                                                                           width, height, LUMINANCE_STEP);
+                sum.Add(EdgeLight::SampleLuminance(pixels, { 0, 0, pixels.width, pixels.height }, 1));
+            }
+        }
+        return sum.Mean();
+    }
+
+    BYTE CurrentAlpha() const
+    {
+        return static_cast<BYTE>(currentOpacity * fadeOpacity + 0.5f);
     }
 
     void SetFrameThickness(int value)
     {
         frameThickness = max(MIN_THICKNESS, min(MAX_THICKNESS, value));
-        InvalidateRect(hwnd, nullptr, FALSE);
+        ScheduleRender(EdgeLight::DIRTY_GEOMETRY);
+    }
+
+    // One table rebuild; the next render colors cached tiles (or the
+    // per-pixel DIB) with it instead of rasterizing the frame again
+    void SetColorTemperature(int kelvin)
+    {
+        EdgeLight::ColorSettings next = color;
+        next.kelvin = kelvin;
+        if (next == color)
+            return;
+
+        color = next;
+        colorLut = EdgeLight::ColorLut::Build(color, perPixelAlpha);
+        ScheduleRender(EdgeLight::DIRTY_GEOMETRY);
     }
 
     void UpdateBrightnessSlider()
@@ -437,30 +1634,90 @@ private:
 
     void ToggleControls()
     {
-        controlsVisible = !controlsVisible;
-        if (controlHwnd)
+        if (controlPanel.Visible())
+            HideControls();
+        else
+            ShowControls();
+    }
+
+    void ShowControls()
+    {
+        if (controlPanel.Show())
         {
-            ShowWindow(controlHwnd, controlsVisible ? SW_SHOW : SW_HIDE);
+            if (FAILED(CreateControlWindow()))
+            {
+                controlPanel.Lost();
+                DestroyControlWindow();
+            }
+        }
+        else if (controlHwnd)
+        {
+            ShowWindow(controlHwnd, SW_SHOW);
         }
+        PumpControlPanel();
+    }
+
+    void HideControls()
+    {
+        controlPanel.Hide();
+        if (controlHwnd)
+            ShowWindow(controlHwnd, SW_HIDE);
+        PumpControlPanel();
+    }
+
+    // Arms controlsTimer for when the hidden panel is due for release.
+    // Never destroys it directly: this runs from the panel's own Close
+    // button, so the window must outlive the message being handled.
+    void PumpControlPanel()
+    {
+        const int64_t wait = controlPanel.TimeUntilRelease();
+        if (wait < 0)
+            DisarmTimer(controlsTimer);
+        else
+            ArmTimer(controlsTimer, wait);
+    }
+
+    void OnControlsTimer()
+    {
+        if (controlPanel.ReleaseDue())
+            DestroyControlWindow();
+        else
+            PumpControlPanel();
     }
 
     void SwitchMonitor()
     {
-        if (monitorCount <= 1) return;
+        EDGELIGHT_TRACE_SCOPE("SwitchMonitor");
+        if (MonitorCount() <= 1 || allMonitors) return;
 
-        currentMonitorIndex = (currentMonitorIndex + 1) % monitorCount;
-        
-        MONITORINFO mi = { sizeof(mi) };
-        GetMonitorInfo(monitors[currentMonitorIndex], &mi);
-        RECT workArea = mi.rcWork;
+        // Never overwrite the running fade's action: a switch asked for
+        // while the light fades out happens once it is off, and one asked
+        // for mid switch is ignored
+        if (fadeAction != FadeAction::None)
+        {
+            if (fadeAction == FadeAction::TurnOff)
+                queuedFadeAction = FadeAction::SwitchMonitor;
+            return;
+        }
 
-        SetWindowPos(hwnd, HWND_TOPMOST,
-            workArea.left, workArea.top,
-            workArea.right - workArea.left,
-            workArea.bottom - workArea.top,
-            SWP_SHOWWINDOW);
+        // Fade out, move, fade back in on the next monitor
+        if (isLightOn)
+        {
+            StartFade(0.0f, FadeAction::SwitchMonitor);
+            return;
+        }
+        MoveToNextMonitor();
+    }
+
+    void MoveToNextMonitor()
+    {
+        EDGELIGHT_TRACE_SCOPE("MoveToNextMonitor");
+        currentMonitorIndex = (currentMonitorIndex + 1) % MonitorCount();
+        overlays[0].monitor = monitors[currentMonitorIndex];
+        PlaceOverlay(overlays[0], UsesStrips() ? SWP_NOACTIVATE : SWP_SHOWWINDOW);
 
-        InvalidateRect(hwnd, nullptr, FALSE);
+        scheduler.SetInterval(RefreshIntervalUs(monitors[currentMonitorIndex]));
+        ScheduleRender(EdgeLight::DIRTY_GEOMETRY | EdgeLight::DIRTY_PLACEMENT);
         RepositionControlWindow();
     }
 
@@ -479,7 +1736,8 @@ private:
         int controlX = mainRect.left + (mainRect.right - mainRect.left - controlWidth) / 2;
         int controlY = mainRect.bottom - controlHeight - 80;
 
-        SetWindowPos(controlHwnd, HWND_TOPMOST, controlX, controlY, 0, 0, SWP_NOSIZE | SWP_SHOWWINDOW);
+        SetWindowPos(controlHwnd, HWND_TOPMOST, controlX, controlY, 0, 0,
+                     SWP_NOSIZE | (controlPanel.Visible() ? SWP_SHOWWINDOW : 0));
     }
 
     void ShowTrayMenu()
@@ -494,22 +1752,67 @@ private:
         AppendMenu(hMenu, MF_STRING, IDM_TOGGLE_CONTROLS, L"Toggle Controls (Ctrl+Shift+C)");
         AppendMenu(hMenu, MF_STRING, IDM_BRIGHTNESS_UP, L"Brightness Up (Ctrl+Shift+\x2191)");
         AppendMenu(hMenu, MF_STRING, IDM_BRIGHTNESS_DOWN, L"Brightness Down (Ctrl+Shift+\x2193)");
+        AppendMenu(hMenu, MF_STRING | (autoBrightness.Enabled() ? MF_CHECKED : 0), IDM_AUTO_BRIGHTNESS, L"Auto Brightness");
         
-        if (monitorCount > 1)
+        if (MonitorCount() > 1)
         {
-            AppendMenu(hMenu, MF_STRING, IDM_SWITCH_MONITOR, L"Switch Monitor");
+            AppendMenu(hMenu, MF_STRING | (allMonitors ? MF_CHECKED : 0), IDM_ALL_MONITORS, L"All Monitors");
+            AppendMenu(hMenu, MF_STRING | (allMonitors ? MF_GRAYED : 0), IDM_SWITCH_MONITOR, L"Switch Monitor");
         }
         
         AppendMenu(hMenu, MF_SEPARATOR, 0, nullptr);
+        AppendMenu(hMenu, MF_STRING | (EdgeLight::Tracer::IsEnabled() ? 0 : MF_GRAYED), IDM_SAVE_TRACE, L"Save Performance Trace");
         AppendMenu(hMenu, MF_STRING, IDM_EXIT, L"Exit");
 
         SetForegroundWindow(hwnd);
+        BeginModal();
         TrackPopupMenu(hMenu, TPM_BOTTOMALIGN | TPM_LEFTALIGN, pt.x, pt.y, 0, hwnd, nullptr);
+        EndModal();
         DestroyMenu(hMenu);
     }
 
+    // Writes the trace rings as Chrome trace-event JSON next to the other
+    // temp files; open it in chrome://tracing or ui.perfetto.dev
+    void SaveTrace()
+    {
+        EdgeLight::Tracer& tracer = EdgeLight::Tracer::Instance();
+        const std::string json = EdgeLight::ToChromeTraceJson(tracer.Snapshot(), tracer.Threads());
+
+        wchar_t path[MAX_PATH];
+        const DWORD length = GetTempPath(MAX_PATH, path);
+        if (length == 0 || FAILED(StringCchCat(path, MAX_PATH, L"WindowsEdgeLight-trace.json")))
+            return;
+
+        bool saved = false;
+        HANDLE file = CreateFile(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            DWORD written = 0;
+            saved = WriteFile(file, json.data(), static_cast<DWORD>(json.size()), &written, nullptr) &&
+                written == json.size();
+            CloseHandle(file);
+        }
+
+        const EdgeLight::GdiProcessCounts gdi = EdgeLight::ProcessGdiCounts();
+        const EdgeLight::GdiPoolStats pool = gdiPool.Stats();
+        const std::string report = startup.Report() + "\n" + memory.Report();
+        wchar_t message[MAX_PATH + 2048];
+        StringCchPrintf(message, ARRAYSIZE(message),
+                        saved ? L"Trace saved to\n%s\n\nOpen it in chrome://tracing or ui.perfetto.dev."
+                                L"\n\nGDI objects: %u live, %u peak (pooled: %u brushes, %u regions)"
+                                L"\n\n%hs"
+                              : L"Could not write\n%s",
+                        path, gdi.live, gdi.peak,
+                        static_cast<unsigned>(pool.brushes), static_cast<unsigned>(pool.regions),
+                        report.c_str());
+        BeginModal();
+        MessageBox(hwnd, message, L"Windows Edge Light - Trace", MB_OK | (saved ? MB_ICONINFORMATION : MB_ICONWARNING));
+        EndModal();
+    }
+
     void ShowHelp()
     {
+        BeginModal();
         MessageBox(hwnd,
             L"Windows Edge Light - Keyboard Shortcuts\n\n"
             L"Toggle Light:  Ctrl + Shift + L\n"
@@ -520,11 +1823,13 @@ private:
             L"\x2022 Click-through overlay\n"
             L"\x2022 Adjustable frame thickness\n"
             L"\x2022 Blur/glow effect\n"
-            L"\x2022 Multi-monitor support\n\n"
+            L"\x2022 Multi-monitor support\n"
+            L"\x2022 Auto brightness from the screen content (tray menu)\n\n"
             L"Original concept by Scott Hanselman\n"
             L"Version 2.1 - Enhanced Edition",
             L"Windows Edge Light - Help",
             MB_OK | MB_ICONINFORMATION);
+        EndModal();
     }
 
     static LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
@@ -547,12 +1852,42 @@ private:
             switch (message)
             {
             case WM_PAINT:
-                pThis->OnPaint();
+                pThis->OnPaint(hwnd);
                 return 0;
 
             case WM_ERASEBKGND:
                 return 1;
 
+            case WM_DPICHANGED:
+                // Stay on the work area rather than taking the suggested
+                // rect; the frame is redrawn for the new DPI on the next tick
+                if (Overlay* overlay = pThis->FindOverlay(hwnd))
+                {
+                    pThis->PlaceOverlay(*overlay);
+                    pThis->ScheduleRender(EdgeLight::DIRTY_GEOMETRY);
+                }
+                return 0;
+
+            case WM_DISPLAYCHANGE:
+                // Every overlay gets this; the primary one handles it for all
+                if (hwnd == pThis->hwnd)
+                    pThis->OnDisplayChange();
+                return 0;
+
+            case WM_SETTINGCHANGE:
+                if (wParam == SPI_SETWORKAREA && hwnd == pThis->hwnd)
+                    pThis->OnDisplayChange();
+                break;
+
+            case WM_TIMER:
+                if (wParam == TIMER_WHEEL)
+                {
+                    pThis->timers.Advance();
+                    pThis->SyncModalTimer();
+                    return 0;
+                }
+                break;
+
             case WM_HOTKEY:
                 switch (wParam)
                 {
@@ -600,16 +1935,29 @@ private:
                 case IDM_BRIGHTNESS_DOWN:
                     pThis->DecreaseBrightness();
                     return 0;
+                case IDM_AUTO_BRIGHTNESS:
+                    pThis->SetAutoBrightness(!pThis->autoBrightness.Enabled());
+                    return 0;
                 case IDM_SWITCH_MONITOR:
                     pThis->SwitchMonitor();
                     return 0;
+                case IDM_ALL_MONITORS:
+                    pThis->SetAllMonitors(!pThis->allMonitors);
+                    return 0;
                 case IDM_HELP:
                     pThis->ShowHelp();
                     return 0;
+                case IDM_SAVE_TRACE:
+                    pThis->SaveTrace();
+                    return 0;
                 }
                 break;
 
             case WM_DESTROY:
+                // Secondary overlays come and go with the all-monitors mode
+                if (hwnd != pThis->hwnd)
+                    return 0;
+
                 UnregisterHotKey(hwnd, HOTKEY_TOGGLE);
                 UnregisterHotKey(hwnd, HOTKEY_BRIGHTNESS_UP);
                 UnregisterHotKey(hwnd, HOTKEY_BRIGHTNESS_DOWN);
@@ -656,6 +2004,10 @@ private:
                     {
                         pThis->SetBrightness(pos);
                     }
+                    else if (id == IDC_TEMPERATURE_SLIDER)
+                    {
+                        pThis->SetColorTemperature(pos);
+                    }
                 }
                 return 0;
             }
@@ -683,10 +2035,147 @@ private:
     }
 };
 
+// Value of a --name=value argument, or nullptr when arg is not that option
+static const wchar_t* OptionValue(const wchar_t* arg, const wchar_t* prefix)
+{
+    const size_t prefixLength = wcslen(prefix);
+    return wcsncmp(arg, prefix, prefixLength) == 0 ? arg + prefixLength : nullptr;
+}
+
+static bool ParseLong(const wchar_t* text, long& value)
+{
+    wchar_t* end = nullptr;
+    errno = 0;
+    value = wcstol(text, &end, 10);
+    return end != text && *end == L'\0' && errno != ERANGE;
+}
+
+// Reads the whole command line into options. Every argument that is not
+// understood is appended to problems and leaves its default in place:
+//
+//   --renderer=gdi|reference|software|d2d|null   backend; software otherwise
+//   --per-pixel-alpha        composite the glow with UpdateLayeredWindow
+//                            instead of the black color key
+//   --edge-strips=4|8        four edge strips or eight pieces with corners
+//                            instead of one work-area-sized window
+//   --panel-idle-seconds=N   destroy the hidden control panel after N
+//                            seconds (negative keeps it); a minute otherwise
+//   --memory-ceiling-mb=N    cap the caches and DIBs kept between renders;
+//                            64 MB otherwise
+//   --color-temperature=K    light color in kelvin
+//   --tint=N                 -100 magenta .. 100 green
+//   --auto-brightness        start with the light following the screen
+//   --no-trace               tracing is always on otherwise
+static LaunchOptions ParseLaunchOptions(std::wstring& problems)
+{
+    LaunchOptions options;
+
+    int argc = 0;
+    LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    if (!argv)
+        return options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const wchar_t* arg = argv[i];
+        const wchar_t* value = nullptr;
+        long number = 0;
+        bool valid = true;
+
+        if (wcscmp(arg, L"--per-pixel-alpha") == 0)
+        {
+            options.perPixelAlpha = true;
+        }
+        else if (wcscmp(arg, L"--auto-brightness") == 0)
+        {
+            options.autoBrightness = true;
+        }
+        else if (wcscmp(arg, L"--no-trace") == 0)
+        {
+            options.tracing = false;
+        }
+        else if ((value = OptionValue(arg, L"--renderer=")) != nullptr)
+        {
+            char name[32] = {};
+            valid = WideCharToMultiByte(CP_UTF8, 0, value, -1, name, sizeof(name), nullptr, nullptr) > 0 &&
+                    EdgeLight::ParseRendererBackend(name, options.renderer);
+        }
+        else if ((value = OptionValue(arg, L"--edge-strips=")) != nullptr)
+        {
+            if (wcscmp(value, L"4") == 0)
+                options.strips = EdgeLight::EdgeStripMode::FourStrips;
+            else if (wcscmp(value, L"8") == 0)
+                options.strips = EdgeLight::EdgeStripMode::EightPieces;
+            else
+                valid = false;
+        }
+        else if ((value = OptionValue(arg, L"--panel-idle-seconds=")) != nullptr)
+        {
+            valid = ParseLong(value, number);
+            if (valid)
+                options.panelIdleUs = number < 0 ? -1 : static_cast<int64_t>(number) * 1000000;
+        }
+        else if ((value = OptionValue(arg, L"--memory-ceiling-mb=")) != nullptr)
+        {
+            valid = ParseLong(value, number) && number >= 0;
+            if (valid)
+                options.memoryCeilingBytes = static_cast<size_t>(number) * 1024 * 1024;
+        }
+        else if ((value = OptionValue(arg, L"--color-temperature=")) != nullptr)
+        {
+            valid = ParseLong(value, number);
+            if (valid)
+                options.colors.kelvin = static_cast<int>(number);
+        }
+        else if ((value = OptionValue(arg, L"--tint=")) != nullptr)
+        {
+            valid = ParseLong(value, number);
+            if (valid)
+                options.colors.tint = static_cast<int>(number);
+        }
+        else
+        {
+            problems += L"Unknown option: ";
+            problems += arg;
+            problems += L"\n";
+            continue;
+        }
+
+        if (!valid)
+        {
+            problems += L"Invalid value: ";
+            problems += arg;
+            problems += L"\n";
+        }
+    }
+
+    LocalFree(argv);
+    return options;
+}
+
 int WINAPI wWinMain(HINSTANCE, HINSTANCE, PWSTR, int)
 {
+    std::wstring problems;
+    const LaunchOptions options = ParseLaunchOptions(problems);
+
+    EdgeLight::Tracer& tracer = EdgeLight::Tracer::Instance();
+    tracer.SetEnabled(options.tracing);
+    tracer.SetThreadName("UI");
+
+    // Draw in device pixels on every monitor; the frame is scaled per DPI
+    SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+
+    // Start anyway with the defaults for whatever was not understood, but
+    // say so instead of silently ignoring it
+    if (!problems.empty())
+    {
+        OutputDebugStringW(problems.c_str());
+        problems += L"\nDefaults are used for these.";
+        MessageBox(nullptr, problems.c_str(), L"Windows Edge Light - Command Line", MB_OK | MB_ICONWARNING);
+    }
+
     EdgeLightWindow app;
-    if (SUCCEEDED(app.Initialize()))
+    if (SUCCEEDED(app.Initialize(options)))
     {
         app.RunMessageLoop();
     }
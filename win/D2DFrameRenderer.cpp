@@ -0,0 +1,184 @@
+#ifndef UNICODE
+#define UNICODE
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "D2DFrameRenderer.h"
+#include "DibTarget.h"
+
+#include <windows.h>
+#include <d2d1.h>
+#include <d2d1helper.h>
+
+#pragma comment(lib, "d2d1")
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        template<class Interface>
+        inline void SafeRelease(Interface** ppInterfaceToRelease)
+        {
+            if (*ppInterfaceToRelease != nullptr)
+            {
+                (*ppInterfaceToRelease)->Release();
+                (*ppInterfaceToRelease) = nullptr;
+            }
+        }
+
+        class D2DFrameRenderer : public IFrameRenderer
+        {
+        public:
+            explicit D2DFrameRenderer(ID2D1Factory* factory) :
+                pD2DFactory(factory)
+            {
+            }
+
+            ~D2DFrameRenderer()
+            {
+                SafeRelease(&pD2DFactory);
+            }
+
+            RendererBackend Backend() const override { return RendererBackend::Direct2D; }
+
+            bool RenderMask(const FrameParams& params, const MaskBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+
+                FrameParams full = params;
+                full.opacity = 255;
+                thread_local std::vector<uint32_t> scratch;
+                scratch.resize(static_cast<size_t>(target.width) * target.height);
+                if (!Render(full, { reinterpret_cast<uint8_t*>(scratch.data()), target.width, target.height, target.width * 4 }))
+                    return false;
+
+                for (int y = 0; y < target.height; y++)
+                {
+                    const uint32_t* in = scratch.data() + static_cast<size_t>(y) * target.width;
+                    uint8_t* out = target.pixels + static_cast<size_t>(y) * target.stride;
+                    for (int x = 0; x < target.width; x++)
+                        out[x] = static_cast<uint8_t>(in[x]);
+                }
+                return true;
+            }
+
+            bool Render(const FrameParams& params, const BgraBuffer& target) override
+            {
+                if (!target.pixels || target.width <= 0 || target.height <= 0)
+                    return false;
+
+                DibTarget dib(target.width, target.height);
+                if (!dib.IsValid())
+                    return false;
+
+                ID2D1DCRenderTarget* pRenderTarget = nullptr;
+                const D2D1_RENDER_TARGET_PROPERTIES props = D2D1::RenderTargetProperties(
+                    D2D1_RENDER_TARGET_TYPE_SOFTWARE,
+                    D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_IGNORE));
+                HRESULT hr = pD2DFactory->CreateDCRenderTarget(&props, &pRenderTarget);
+
+                if (SUCCEEDED(hr))
+                {
+                    const RECT bounds = { 0, 0, target.width, target.height };
+                    hr = pRenderTarget->BindDC(dib.Dc(), &bounds);
+                }
+
+                if (SUCCEEDED(hr))
+                {
+                    pRenderTarget->BeginDraw();
+                    pRenderTarget->Clear(D2D1::ColorF(D2D1::ColorF::Black));
+                    if (params.opacity > 0)
+                        hr = FillFrame(pRenderTarget, params);
+                    const HRESULT endHr = pRenderTarget->EndDraw();
+                    if (SUCCEEDED(hr))
+                        hr = endHr;
+                }
+
+                SafeRelease(&pRenderTarget);
+                if (FAILED(hr))
+                    return false;
+
+                GdiFlush();
+                for (int y = 0; y < target.height; y++)
+                {
+                    uint32_t* out = reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+                    std::memcpy(out, dib.Bits() + static_cast<size_t>(y) * target.width * 4, static_cast<size_t>(target.width) * 4);
+                    for (int x = 0; x < target.width; x++)
+                        out[x] |= 0xFF000000u; // alpha is ignored by the target; keep it opaque like the other backends
+                }
+                return true;
+            }
+
+        private:
+            static D2D1_ROUNDED_RECT Rounded(int left, int top, int right, int bottom, int radius)
+            {
+                const float r = static_cast<float>(std::max(radius, 0));
+                return D2D1::RoundedRect(D2D1::RectF(static_cast<float>(left), static_cast<float>(top),
+                                                     static_cast<float>(right), static_cast<float>(bottom)), r, r);
+            }
+
+            // Same rings as the GDI path: the band at full intensity plus
+            // blurSize one-pixel falloff rings on each side. Painted as
+            // nested solid rounded rects, outermost first, so neighbouring
+            // rings share anti-aliased edges instead of leaving seams.
+            HRESULT FillFrame(ID2D1RenderTarget* pRenderTarget, const FrameParams& params)
+            {
+                const int W = params.width;
+                const int H = params.height;
+                const int inset = params.inset;
+                const int intensity = std::min(params.opacity, 255);
+                const int blurSize = std::clamp(params.blurSize, 0, 64);
+                const int innerEdge = inset + params.frameThickness;
+                const int innerRadius = std::max(MIN_INNER_RADIUS, params.cornerRadius - params.frameThickness);
+
+                ID2D1SolidColorBrush* pBrush = nullptr;
+                HRESULT hr = pRenderTarget->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::Black), &pBrush);
+                if (FAILED(hr))
+                    return hr;
+
+                const auto fill = [&](const D2D1_ROUNDED_RECT& rect, int value)
+                {
+                    if (rect.rect.right <= rect.rect.left || rect.rect.bottom <= rect.rect.top)
+                        return;
+                    const float level = value / 255.0f;
+                    pBrush->SetColor(D2D1::ColorF(level, level, level));
+                    pRenderTarget->FillRoundedRectangle(rect, pBrush);
+                };
+                const auto falloff = [&](int i) { return (intensity * (blurSize - i + 1)) / (blurSize + 3); };
+
+                for (int i = blurSize; i >= 1; i--)
+                    fill(Rounded(inset - i, inset - i, W - inset + i, H - inset + i, params.cornerRadius + i), falloff(i));
+                fill(Rounded(inset, inset, W - inset, H - inset, params.cornerRadius), intensity);
+
+                for (int i = blurSize; i >= 1; i--)
+                {
+                    const int radius = std::max(MIN_INNER_RADIUS, innerRadius - i);
+                    fill(Rounded(innerEdge - i, innerEdge - i, W - innerEdge + i, H - innerEdge + i, radius + i), falloff(i));
+                }
+                fill(Rounded(innerEdge, innerEdge, W - innerEdge, H - innerEdge, innerRadius), 0);
+
+                SafeRelease(&pBrush);
+                return hr;
+            }
+
+            ID2D1Factory* pD2DFactory;
+        };
+    }
+
+    std::unique_ptr<IFrameRenderer> CreateD2DFrameRenderer()
+    {
+        // Tiles are rasterized on the worker pool, so the factory must be
+        // safe to use from several threads
+        ID2D1Factory* pD2DFactory = nullptr;
+        if (FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_MULTI_THREADED, &pD2DFactory)))
+            return nullptr;
+        return std::make_unique<D2DFrameRenderer>(pD2DFactory);
+    }
+}
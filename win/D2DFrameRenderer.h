@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../core/FrameRenderer.h"
+
+#include <memory>
+
+namespace EdgeLight
+{
+    // The Direct2D backend (revived from the old Direct2D build): the frame
+    // band and its falloff rings are filled as anti-aliased geometry into a
+    // DC render target bound to a DIB section. The blurred glow pass
+    // (glowRadius) is not drawn.
+    //
+    // nullptr when Direct2D is unavailable.
+    std::unique_ptr<IFrameRenderer> CreateD2DFrameRenderer();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <windows.h>
+
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // A 32bpp top-down DIB selected into a memory DC, for the GDI and
+    // Direct2D backends to draw into before copying the pixels out.
+    class DibTarget
+    {
+    public:
+        DibTarget(int width, int height) :
+            dc(CreateCompatibleDC(nullptr)),
+            bitmap(nullptr),
+            oldBitmap(nullptr),
+            bits(nullptr)
+        {
+            BITMAPINFO bmi = {};
+            bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bmi.bmiHeader.biWidth = width;
+            bmi.bmiHeader.biHeight = -height; // top-down
+            bmi.bmiHeader.biPlanes = 1;
+            bmi.bmiHeader.biBitCount = 32;
+            bmi.bmiHeader.biCompression = BI_RGB;
+
+            if (dc)
+                bitmap = CreateDIBSection(dc, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+            if (bitmap)
+                oldBitmap = SelectObject(dc, bitmap);
+        }
+
+        ~DibTarget()
+        {
+            if (oldBitmap)
+                SelectObject(dc, oldBitmap);
+            if (bitmap)
+                DeleteObject(bitmap);
+            if (dc)
+                DeleteDC(dc);
+        }
+
+        DibTarget(const DibTarget&) = delete;
+        DibTarget& operator=(const DibTarget&) = delete;
+
+        bool IsValid() const { return bits != nullptr; }
+        HDC Dc() const { return dc; }
+        const uint8_t* Bits() const { return static_cast<const uint8_t*>(bits); }
+
+    private:
+        HDC dc;
+        HBITMAP bitmap;
+        HGDIOBJ oldBitmap;
+        void* bits;
+    };
+}
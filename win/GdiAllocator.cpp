@@ -0,0 +1,62 @@
+#ifndef UNICODE
+#define UNICODE
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "GdiAllocator.h"
+
+#include <windows.h>
+
+#include <vector>
+
+namespace EdgeLight
+{
+    GdiHandle Win32GdiAllocator::CreateBrush(uint8_t intensity)
+    {
+        return reinterpret_cast<GdiHandle>(CreateSolidBrush(RGB(intensity, intensity, intensity)));
+    }
+
+    GdiHandle Win32GdiAllocator::CreateRegion(const FrameSpans& spans)
+    {
+        std::vector<SpanRect> rects;
+        spans.ToRects(rects);
+        if (rects.empty())
+            return CreateEmptyRegion();
+
+        std::vector<BYTE> data(sizeof(RGNDATAHEADER) + rects.size() * sizeof(RECT));
+        RGNDATA* rgn = reinterpret_cast<RGNDATA*>(data.data());
+        rgn->rdh.dwSize = sizeof(RGNDATAHEADER);
+        rgn->rdh.iType = RDH_RECTANGLES;
+        rgn->rdh.nCount = static_cast<DWORD>(rects.size());
+        rgn->rdh.nRgnSize = static_cast<DWORD>(rects.size() * sizeof(RECT));
+        SetRect(&rgn->rdh.rcBound, 0, 0, spans.Width(), spans.Height());
+
+        RECT* out = reinterpret_cast<RECT*>(rgn->Buffer);
+        for (size_t i = 0; i < rects.size(); i++)
+        {
+            SetRect(&out[i], rects[i].left, rects[i].top, rects[i].right, rects[i].bottom);
+        }
+
+        return reinterpret_cast<GdiHandle>(ExtCreateRegion(nullptr, static_cast<DWORD>(data.size()), rgn));
+    }
+
+    GdiHandle Win32GdiAllocator::CreateEmptyRegion()
+    {
+        return reinterpret_cast<GdiHandle>(CreateRectRgn(0, 0, 0, 0));
+    }
+
+    void Win32GdiAllocator::Delete(GdiHandle handle)
+    {
+        DeleteObject(reinterpret_cast<HGDIOBJ>(handle));
+    }
+
+    GdiProcessCounts ProcessGdiCounts()
+    {
+        GdiProcessCounts counts;
+        counts.live = GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS);
+        counts.peak = GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS_PEAK);
+        return counts;
+    }
+}
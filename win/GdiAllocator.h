@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../core/GdiResourcePool.h"
+
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // GdiAllocator on real GDI objects: solid brushes, span regions built
+    // with ExtCreateRegion and DeleteObject.
+    class Win32GdiAllocator : public GdiAllocator
+    {
+    public:
+        GdiHandle CreateBrush(uint8_t intensity) override;
+        GdiHandle CreateRegion(const FrameSpans& spans) override;
+        GdiHandle CreateEmptyRegion() override;
+        void Delete(GdiHandle handle) override;
+    };
+
+    // GDI objects of the whole process, from GetGuiResources.
+    struct GdiProcessCounts
+    {
+        uint32_t live = 0;
+        uint32_t peak = 0;
+    };
+
+    GdiProcessCounts ProcessGdiCounts();
+}
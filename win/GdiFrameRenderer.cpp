@@ -0,0 +1,142 @@
+#ifndef UNICODE
+#define UNICODE
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "GdiFrameRenderer.h"
+#include "DibTarget.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace EdgeLight
+{
+    namespace
+    {
+        class GdiFrameRenderer : public IFrameRenderer
+        {
+        public:
+            RendererBackend Backend() const override { return RendererBackend::Gdi; }
+
+            bool RenderMask(const FrameParams& params, const MaskBuffer& target) override
+            {
+                if (!target.pixels)
+                    return false;
+
+                FrameParams full = params;
+                full.opacity = 255;
+                thread_local std::vector<uint32_t> scratch;
+                scratch.resize(static_cast<size_t>(target.width) * target.height);
+                if (!Render(full, { reinterpret_cast<uint8_t*>(scratch.data()), target.width, target.height, target.width * 4 }))
+                    return false;
+
+                for (int y = 0; y < target.height; y++)
+                {
+                    const uint32_t* in = scratch.data() + static_cast<size_t>(y) * target.width;
+                    uint8_t* out = target.pixels + static_cast<size_t>(y) * target.stride;
+                    for (int x = 0; x < target.width; x++)
+                        out[x] = static_cast<uint8_t>(in[x]);
+                }
+                return true;
+            }
+
+            bool Render(const FrameParams& params, const BgraBuffer& target) override
+            {
+                if (!target.pixels || target.width <= 0 || target.height <= 0)
+                    return false;
+
+                DibTarget dib(target.width, target.height);
+                if (!dib.IsValid())
+                    return false;
+
+                // Regions outside the DIB are clipped by GDI, which is what
+                // lets a corner tile receive just the top-left of the frame
+                const RECT bounds = { 0, 0, target.width, target.height };
+                FillRect(dib.Dc(), &bounds, static_cast<HBRUSH>(GetStockObject(BLACK_BRUSH)));
+                if (params.opacity > 0 && !FillFrame(dib.Dc(), params))
+                    return false;
+
+                GdiFlush();
+                for (int y = 0; y < target.height; y++)
+                {
+                    uint32_t* out = reinterpret_cast<uint32_t*>(target.pixels + static_cast<size_t>(y) * target.stride);
+                    std::memcpy(out, dib.Bits() + static_cast<size_t>(y) * target.width * 4, static_cast<size_t>(target.width) * 4);
+                    for (int x = 0; x < target.width; x++)
+                        out[x] |= 0xFF000000u; // GDI leaves alpha at 0; keep it opaque like the other backends
+                }
+                return true;
+            }
+
+        private:
+            static HRGN RoundRgn(int left, int top, int right, int bottom, int radius)
+            {
+                return CreateRoundRectRgn(left, top, right, bottom, radius * 2, radius * 2);
+            }
+
+            // outer minus inner, filled with one grey level
+            static bool FillRing(HDC hdc, HRGN outer, HRGN inner, int value)
+            {
+                HRGN ring = CreateRectRgn(0, 0, 0, 0);
+                HBRUSH brush = CreateSolidBrush(RGB(value, value, value));
+                const bool ok = outer && inner && ring && brush &&
+                                CombineRgn(ring, outer, inner, RGN_DIFF) != ERROR &&
+                                FillRgn(hdc, ring, brush);
+
+                if (brush) DeleteObject(brush);
+                if (ring) DeleteObject(ring);
+                if (inner) DeleteObject(inner);
+                if (outer) DeleteObject(outer);
+                return ok;
+            }
+
+            // Outer rings farthest first, the band, then inner rings nearest
+            // first; the same order and geometry as the old OnPaint.
+            static bool FillFrame(HDC hdc, const FrameParams& params)
+            {
+                const int W = params.width;
+                const int H = params.height;
+                const int inset = params.inset;
+                const int R = params.cornerRadius;
+                const int intensity = std::min(params.opacity, 255);
+                const int blurSize = std::clamp(params.blurSize, 0, 64);
+                const int innerEdge = inset + params.frameThickness;
+                const int innerRadius = std::max(MIN_INNER_RADIUS, R - params.frameThickness);
+                const auto falloff = [&](int i) { return (intensity * (blurSize - i + 1)) / (blurSize + 3); };
+
+                bool ok = true;
+                for (int i = blurSize; i >= 1; i--)
+                {
+                    ok &= FillRing(hdc,
+                                   RoundRgn(inset - i, inset - i, W - inset + i, H - inset + i, R + i),
+                                   RoundRgn(inset - i + 1, inset - i + 1, W - inset + i - 1, H - inset + i - 1, R + i - 1),
+                                   falloff(i));
+                }
+
+                ok &= FillRing(hdc,
+                               RoundRgn(inset, inset, W - inset, H - inset, R),
+                               RoundRgn(innerEdge, innerEdge, W - innerEdge, H - innerEdge, innerRadius),
+                               intensity);
+
+                for (int i = 1; i <= blurSize; i++)
+                {
+                    const int radius = std::max(MIN_INNER_RADIUS, innerRadius - i);
+                    ok &= FillRing(hdc,
+                                   RoundRgn(innerEdge - i, innerEdge - i, W - innerEdge + i, H - innerEdge + i, radius + i),
+                                   RoundRgn(innerEdge - i + 1, innerEdge - i + 1, W - innerEdge + i - 1, H - innerEdge + i - 1, radius + i - 1),
+                                   falloff(i));
+                }
+                return ok;
+            }
+        };
+    }
+
+    std::unique_ptr<IFrameRenderer> CreateGdiFrameRenderer()
+    {
+        return std::make_unique<GdiFrameRenderer>();
+    }
+}
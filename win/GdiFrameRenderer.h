@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../core/FrameRenderer.h"
+
+#include <memory>
+
+namespace EdgeLight
+{
+    // The GDI backend: the frame band and its falloff rings are built with
+    // CreateRoundRectRgn / CombineRgn(RGN_DIFF) and filled with FillRgn into
+    // a DIB section, exactly as the original overlay painted them. The
+    // blurred glow pass (glowRadius) is not drawn.
+    //
+    // The portable "reference" backend scan-converts the same rings without
+    // GDI; this one is what it approximates.
+    std::unique_ptr<IFrameRenderer> CreateGdiFrameRenderer();
+}
@@ -0,0 +1,114 @@
+#ifndef UNICODE
+#define UNICODE
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "LayeredSurface.h"
+
+#include <windows.h>
+
+namespace EdgeLight
+{
+    LayeredSurface::~LayeredSurface()
+    {
+        Release();
+    }
+
+    void LayeredSurface::Release()
+    {
+        if (dc)
+        {
+            SelectObject(static_cast<HDC>(dc), static_cast<HGDIOBJ>(oldBitmap));
+            DeleteDC(static_cast<HDC>(dc));
+        }
+        if (bitmap)
+            DeleteObject(static_cast<HBITMAP>(bitmap));
+
+        dc = nullptr;
+        bitmap = nullptr;
+        oldBitmap = nullptr;
+        bits = nullptr;
+        width = 0;
+        height = 0;
+    }
+
+    bool LayeredSurface::Resize(int newWidth, int newHeight)
+    {
+        if (bitmap && newWidth == width && newHeight == height)
+            return true;
+
+        Release();
+        if (newWidth <= 0 || newHeight <= 0)
+            return false;
+
+        BITMAPINFO bmi = {};
+        bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        bmi.bmiHeader.biWidth = newWidth;
+        bmi.bmiHeader.biHeight = -newHeight; // top-down
+        bmi.bmiHeader.biPlanes = 1;
+        bmi.bmiHeader.biBitCount = 32;
+        bmi.bmiHeader.biCompression = BI_RGB;
+
+        HDC memDC = CreateCompatibleDC(nullptr);
+        if (!memDC)
+            return false;
+
+        void* dibBits = nullptr;
+        HBITMAP dib = CreateDIBSection(memDC, &bmi, DIB_RGB_COLORS, &dibBits, nullptr, 0);
+        if (!dib)
+        {
+            DeleteDC(memDC);
+            return false;
+        }
+
+        dc = memDC;
+        bitmap = dib;
+        oldBitmap = SelectObject(memDC, dib);
+        bits = static_cast<uint8_t*>(dibBits);
+        width = newWidth;
+        height = newHeight;
+        return true;
+    }
+
+    BgraBuffer LayeredSurface::Pixels() const
+    {
+        if (!bits)
+            return {};
+
+        // GDI may still be writing to the bits from a batched call
+        GdiFlush();
+        return { bits, width, height, width * 4, true };
+    }
+
+    bool LayeredSurface::Present(void* window, uint8_t alpha) const
+    {
+        return Update(window, nullptr, alpha);
+    }
+
+    bool LayeredSurface::PresentAt(void* window, int x, int y, uint8_t alpha) const
+    {
+        POINT position = { x, y };
+        return Update(window, &position, alpha);
+    }
+
+    bool LayeredSurface::Update(void* window, void* position, uint8_t alpha) const
+    {
+        if (!dc)
+            return false;
+
+        SIZE size = { width, height };
+        POINT source = { 0, 0 };
+        BLENDFUNCTION blend = { AC_SRC_OVER, 0, alpha, AC_SRC_ALPHA };
+        return UpdateLayeredWindow(static_cast<HWND>(window), nullptr, static_cast<POINT*>(position), &size,
+                                   static_cast<HDC>(dc), &source, 0, &blend, ULW_ALPHA) != FALSE;
+    }
+
+    bool LayeredSurface::SetAlpha(void* window, uint8_t alpha)
+    {
+        BLENDFUNCTION blend = { AC_SRC_OVER, 0, alpha, AC_SRC_ALPHA };
+        return UpdateLayeredWindow(static_cast<HWND>(window), nullptr, nullptr, nullptr,
+                                   nullptr, nullptr, 0, &blend, ULW_ALPHA) != FALSE;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../core/FrameTypes.h"
+
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // The per-pixel alpha overlay's pixels: one top-down 32bpp DIB section
+    // selected into a memory DC for the window's lifetime. The frame is
+    // rasterized straight into its bits as premultiplied BGRA (Pixels())
+    // and handed to UpdateLayeredWindow from there, so nothing is copied
+    // on our side and nothing is allocated per frame.
+    //
+    // window arguments are HWNDs; kept as void* so this header does not
+    // pull in windows.h.
+    class LayeredSurface
+    {
+    public:
+        LayeredSurface() = default;
+        ~LayeredSurface();
+
+        LayeredSurface(const LayeredSurface&) = delete;
+        LayeredSurface& operator=(const LayeredSurface&) = delete;
+
+        // Keeps the current DIB when the size is unchanged, so its pixels
+        // survive for incremental updates. Returns false, leaving the
+        // surface empty, when the DIB cannot be created.
+        bool Resize(int width, int height);
+
+        // Premultiplied view of the DIB bits; empty before Resize.
+        BgraBuffer Pixels() const;
+
+        // Shows the pixels on window with a constant alpha on top. The
+        // window keeps its position and takes the surface's size.
+        bool Present(void* window, uint8_t alpha) const;
+
+        // Same, moving the window's top left to (x, y) in screen
+        // coordinates in the same call.
+        bool PresentAt(void* window, int x, int y, uint8_t alpha) const;
+
+        // Changes only the constant alpha of what was last presented; the
+        // compositor reuses the pixels it already has.
+        static bool SetAlpha(void* window, uint8_t alpha);
+
+        int Width() const { return width; }
+        int Height() const { return height; }
+
+    private:
+        void Release();
+
+        // position is a POINT*, nullptr to keep the window where it is
+        bool Update(void* window, void* position, uint8_t alpha) const;
+
+        void* dc = nullptr;         // HDC
+        void* bitmap = nullptr;     // HBITMAP
+        void* oldBitmap = nullptr;  // HGDIOBJ
+        uint8_t* bits = nullptr;
+        int width = 0;
+        int height = 0;
+    };
+}
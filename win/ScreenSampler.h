@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../core/FrameTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace EdgeLight
+{
+    // Copies small, optionally decimated rectangles of what is on screen
+    // into one reusable
+    // top-down 32bpp DIB section for the auto-brightness sampling. The DIB
+    // only grows, to the largest rectangle asked for, so steady sampling
+    // allocates nothing.
+    //
+    // window arguments are HWNDs; kept as void* so this header does not
+    // pull in windows.h.
+    class ScreenSampler
+    {
+    public:
+        ScreenSampler() = default;
+        ~ScreenSampler();
+
+        ScreenSampler(const ScreenSampler&) = delete;
+        ScreenSampler& operator=(const ScreenSampler&) = delete;
+
+        // Copies width x height pixels at (x, y) in screen coordinates,
+        // keeping every step-th pixel of every step-th row, and returns a
+        // view of them (ceil(width / step) x ceil(height / step)), valid
+        // until the next Capture or Release; empty when the capture
+        // failed. Alpha is undefined.
+        //
+        // step > 1 shrinks the copy on the way out of the screen with a
+        // COLORONCOLOR StretchBlt, so only the sampled pixels are copied
+        // and the DIB is step^2 times smaller than the rectangle.
+        BgraBuffer Capture(int x, int y, int width, int height, int step = 1);
+
+        // Keeps window out of screen captures (Windows 10 2004 and later),
+        // so the light does not sample itself. Returns false where that is
+        // not supported.
+        static bool ExcludeFromCapture(void* window, bool exclude);
+
+        size_t Bytes() const { return static_cast<size_t>(width) * height * 4; }
+        void Release();
+
+    private:
+        bool Reserve(int minWidth, int minHeight);
+
+        void* dc = nullptr;         // HDC
+        void* bitmap = nullptr;     // HBITMAP
+        void* oldBitmap = nullptr;  // HGDIOBJ
+        uint8_t* bits = nullptr;
+        int width = 0;
+        int height = 0;
+    };
+}